@@ -0,0 +1,146 @@
+#include "DrawCommandList.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+	// Shared with the pool's jobs, which may only start after Build has returned: by then
+	// every chunk is taken, so they find nothing left and never touch the rest.
+	struct BuildJob
+	{
+		DrawCommandList::Writer Write;
+		DrawCommandList::Chunk* Chunks{ nullptr };
+		size_t ChunkCount{ 0 };
+		size_t ObjectCount{ 0 };
+		std::atomic<size_t> Next{ 0 };
+		size_t Done{ 0 };
+		std::mutex Mutex;
+		std::condition_variable Finished;
+	};
+
+	void WriteChunks(BuildJob& job)
+	{
+		for (size_t chunk{ job.Next++ }; chunk < job.ChunkCount; chunk = job.Next++)
+		{
+			job.Write(job.ObjectCount * chunk / job.ChunkCount, job.ObjectCount * (chunk + 1) / job.ChunkCount, job.Chunks[chunk]);
+
+			std::lock_guard<std::mutex> lock(job.Mutex);
+			if (++job.Done == job.ChunkCount)
+				job.Finished.notify_all();
+		}
+	}
+}
+
+void DrawCommandList::Chunk::Add(const GeometryPool::Mesh& mesh, GLuint indexOffset, GLuint indexCount, const InstanceData& instance)
+{
+	commands.push_back({ indexCount, 1, mesh.FirstIndex + indexOffset, mesh.BaseVertex, (GLuint)instances.size() });
+	instances.push_back(instance);
+}
+
+bool DrawCommandList::Supported()
+{
+	return GLAD_GL_VERSION_4_3 || (GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_base_instance);
+}
+
+void DrawCommandList::Build(ThreadPool& pool, size_t objectCount, const Writer& write)
+{
+	auto start{ std::chrono::steady_clock::now() };
+
+	// No more chunks than threads to write them, and none too small to be worth a job.
+	Chunks = std::clamp<size_t>((objectCount + MinChunk - 1) / MinChunk, 1, pool.Size() + 1);
+	chunks.resize(Chunks);
+	for (Chunk& chunk : chunks)
+	{
+		chunk.commands.clear();
+		chunk.instances.clear();
+	}
+
+	std::shared_ptr<BuildJob> job{ std::make_shared<BuildJob>() };
+	job->Write = write;
+	job->Chunks = chunks.data();
+	job->ChunkCount = Chunks;
+	job->ObjectCount = objectCount;
+
+	for (size_t i{ 1 }; i < Chunks; i++)
+	{
+		pool.Submit([job]() { WriteChunks(*job); });
+	}
+	WriteChunks(*job);
+
+	{
+		std::unique_lock<std::mutex> lock(job->Mutex);
+		job->Finished.wait(lock, [&]() { return job->Done == job->ChunkCount; });
+	}
+
+	commands.clear();
+	instances.clear();
+	for (const Chunk& chunk : chunks)
+	{
+		GLuint base{ (GLuint)instances.size() };
+		for (DrawCommand command : chunk.commands)
+		{
+			command.BaseInstance += base;
+			commands.push_back(command);
+		}
+		instances.insert(instances.end(), chunk.instances.begin(), chunk.instances.end());
+	}
+
+	BuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void DrawCommandList::Upload()
+{
+	Instances.Upload(instances.data(), instances.size());
+
+	if (!Supported())
+		return;
+
+	GLStateCache& state{ GLStateCache::Get() };
+	if (indirect == 0)
+		glGenBuffers(1, &indirect);
+
+	// Grown only, and orphaned like InstanceBuffer::Upload.
+	capacity = std::max(capacity, commands.size());
+	state.BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)(capacity * sizeof(DrawCommand)), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, (GLsizeiptr)(commands.size() * sizeof(DrawCommand)), commands.data());
+}
+
+size_t DrawCommandList::Draw(VAO& vao)
+{
+	if (commands.empty())
+		return 0;
+
+	if (MultiDraw && Supported())
+	{
+		Instances.Link(vao);
+		GLStateCache::Get().BindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect);
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, NULL, (GLsizei)commands.size(), 0);
+		return 1;
+	}
+
+	// Without a base instance each draw links the instances again at its own.
+	for (const DrawCommand& command : commands)
+	{
+		Instances.Link(vao, command.BaseInstance);
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)command.Count, GL_UNSIGNED_INT, (const void*)((uintptr_t)command.FirstIndex * sizeof(GLuint)),
+			(GLsizei)command.InstanceCount, command.BaseVertex);
+	}
+	return commands.size();
+}
+
+void DrawCommandList::Delete()
+{
+	Instances.Delete();
+	if (indirect != 0)
+		GLStateCache::Get().DeleteBuffer(indirect);
+	indirect = 0;
+	capacity = 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "GeometryPool.h"
+#include "InstanceBuffer.h"
+#include "ThreadPool.h"
+#include "VAO.h"
+
+// One draw, laid out as glMultiDrawElementsIndirect reads it.
+struct DrawCommand
+{
+	GLuint Count;
+	GLuint InstanceCount;
+	GLuint FirstIndex;
+	GLint BaseVertex;
+	GLuint BaseInstance;
+};
+static_assert(sizeof(DrawCommand) == 20, "DrawCommand must match DrawElementsIndirectCommand");
+
+// The draws of one material batch out of a GeometryPool, issued with a single
+// glMultiDrawElementsIndirect. Each draw's object data is an InstanceData that its command's
+// base instance points at, so the shader reads it as INSTANCED attributes and nothing is
+// bound between draws.
+//
+// Build splits the objects into chunks written on worker threads, each into lists of its
+// own, and joins them in order. Without GL 4.3, or ARB_multi_draw_indirect and
+// ARB_base_instance, Draw loops over the same commands instead.
+class DrawCommandList
+{
+public:
+	// The draws of one range of objects. Written on a worker thread, so no GL.
+	class Chunk
+	{
+	public:
+		// indexOffset counts from the mesh's first index, as for GeometryPool::Draw.
+		void Add(const GeometryPool::Mesh& mesh, GLuint indexOffset, GLuint indexCount, const InstanceData& instance);
+
+	private:
+		friend class DrawCommandList;
+
+		std::vector<DrawCommand> commands;
+		std::vector<InstanceData> instances;
+	};
+
+	// Adds the draws of the objects from first up to end that should be drawn.
+	using Writer = std::function<void(size_t first, size_t end, Chunk& chunk)>;
+
+	static bool Supported();
+
+	InstanceBuffer Instances;
+	// Off, Draw loops even where multi-draw is supported, to compare.
+	bool MultiDraw{ true };
+
+	// Replaces the commands with those write adds for objectCount objects. The calling thread
+	// writes chunks too, and only waits on chunks a worker has started.
+	void Build(ThreadPool& pool, size_t objectCount, const Writer& write);
+	void Upload();
+	// vao has to be bound. Returns the number of draw calls.
+	size_t Draw(VAO& vao);
+
+	size_t Count() const { return commands.size(); }
+	// Of the last Build.
+	size_t Chunks{ 0 };
+	double BuildMs{ 0.0 };
+
+	void Delete();
+
+private:
+	static constexpr size_t MinChunk{ 256 };
+
+	std::vector<Chunk> chunks;
+	std::vector<DrawCommand> commands;
+	std::vector<InstanceData> instances;
+	GLuint indirect{ 0 };
+	size_t capacity{ 0 };
+};
@@ -1,30 +1,31 @@
-#include "EBO.h"
-
-EBO::EBO(GLuint* indices, GLsizeiptr size)
-{
-	glGenBuffers(1, &ID);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
-}
-
-void EBO::setup(GLuint* indices, GLsizeiptr size)
-{
-	glGenBuffers(1, &ID);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
-}
-
-void EBO::Bind()
-{
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
-}
-
-void EBO::Unbind()
-{
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
-
-void EBO::Delete()
-{
-	glDeleteBuffers(1, &ID);
+#include "EBO.h"
+#include "GLStateCache.h"
+
+EBO::EBO(const GLuint* indices, GLsizeiptr size)
+{
+	glGenBuffers(1, &ID);
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+}
+
+void EBO::setup(const GLuint* indices, GLsizeiptr size)
+{
+	glGenBuffers(1, &ID);
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+}
+
+void EBO::Bind()
+{
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+}
+
+void EBO::Unbind()
+{
+	GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void EBO::Delete()
+{
+	GLStateCache::Get().DeleteBuffer(ID);
 }
\ No newline at end of file
@@ -1,16 +1,16 @@
-#pragma once
-
-#include "glad/glad.h"
-
-class EBO
-{
-public:
-	GLuint ID;
-	EBO() : ID(0) {}
-	EBO(GLuint* indices, GLsizeiptr size);
-
-	void setup(GLuint* indices, GLsizeiptr size);
-	void Bind();
-	void Unbind();
-	void Delete();
+#pragma once
+
+#include "glad/glad.h"
+
+class EBO
+{
+public:
+	GLuint ID;
+	EBO() : ID(0) {}
+	EBO(const GLuint* indices, GLsizeiptr size);
+
+	void setup(const GLuint* indices, GLsizeiptr size);
+	void Bind();
+	void Unbind();
+	void Delete();
 };
\ No newline at end of file
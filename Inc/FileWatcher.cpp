@@ -0,0 +1,113 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::FileWatcher()
+{
+#ifdef __linux__
+	inotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+	if (inotifyFD >= 0)
+		close(inotifyFD);
+#endif
+}
+
+std::string FileWatcher::Normalize(const std::string& path)
+{
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool FileWatcher::Watching(const std::string& path) const
+{
+	return std::any_of(files.begin(), files.end(), [&](const WatchedFile& file) { return file.Path == path; });
+}
+
+void FileWatcher::Watch(const std::string& path)
+{
+	std::string normalized{ Normalize(path) };
+	if (Watching(normalized))
+		return;
+
+	std::error_code error;
+	files.push_back({ normalized, std::filesystem::last_write_time(normalized, error) });
+
+#ifdef __linux__
+	if (inotifyFD < 0)
+		return;
+
+	std::filesystem::path directory{ std::filesystem::path(normalized).parent_path() };
+	if (directory.empty())
+		directory = ".";
+
+	// Adding a directory twice returns the same descriptor.
+	int wd{ inotify_add_watch(inotifyFD, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) };
+	if (wd >= 0)
+		directories[wd] = std::filesystem::path(normalized).parent_path();
+#endif
+}
+
+std::vector<std::string> FileWatcher::Changed()
+{
+#ifdef __linux__
+	if (inotifyFD >= 0)
+	{
+		std::vector<std::string> changed;
+
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length;
+		while ((length = read(inotifyFD, buffer, sizeof(buffer))) > 0)
+		{
+			for (char* cursor{ buffer }; cursor < buffer + length;)
+			{
+				const inotify_event* event{ reinterpret_cast<const inotify_event*>(cursor) };
+				cursor += sizeof(inotify_event) + event->len;
+
+				std::unordered_map<int, std::filesystem::path>::const_iterator directory{ directories.find(event->wd) };
+				if (event->len == 0 || directory == directories.end())
+					continue;
+
+				std::string path{ Normalize((directory->second / event->name).string()) };
+				if (Watching(path) && std::find(changed.begin(), changed.end(), path) == changed.end())
+					changed.push_back(path);
+			}
+		}
+
+		return changed;
+	}
+#endif
+
+	return PollWriteTimes();
+}
+
+std::vector<std::string> FileWatcher::PollWriteTimes()
+{
+	std::vector<std::string> changed;
+
+	std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+	if (std::chrono::duration<double>(now - lastPoll).count() < PollInterval)
+		return changed;
+	lastPoll = now;
+
+	for (WatchedFile& file : files)
+	{
+		std::error_code error;
+		std::filesystem::file_time_type writeTime{ std::filesystem::last_write_time(file.Path, error) };
+		if (!error && writeTime != file.WriteTime)
+		{
+			file.WriteTime = writeTime;
+			changed.push_back(file.Path);
+		}
+	}
+
+	return changed;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Reports watched files that were written since the last call to Changed.
+//
+// On Linux this reads inotify events for the files' directories, which also catches
+// editors that save by writing a new file and renaming it over the old one. Elsewhere it
+// compares modification times, at most once per PollInterval.
+class FileWatcher
+{
+public:
+	double PollInterval{ 0.25 };
+
+	FileWatcher();
+	~FileWatcher();
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	void Watch(const std::string& path);
+	std::vector<std::string> Changed();
+
+private:
+	struct WatchedFile
+	{
+		std::string Path;
+		std::filesystem::file_time_type WriteTime;
+	};
+	std::vector<WatchedFile> files;
+	std::chrono::steady_clock::time_point lastPoll;
+
+#ifdef __linux__
+	int inotifyFD{ -1 };
+	std::unordered_map<int, std::filesystem::path> directories;
+#endif
+
+	static std::string Normalize(const std::string& path);
+	bool Watching(const std::string& path) const;
+	std::vector<std::string> PollWriteTimes();
+};
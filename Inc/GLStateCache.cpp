@@ -0,0 +1,211 @@
+#include "GLStateCache.h"
+
+namespace
+{
+	// Targets whose bindings are tracked, with the query for what is bound to each.
+	const GLenum bufferTargets[][2]{
+		{ GL_ARRAY_BUFFER, GL_ARRAY_BUFFER_BINDING },
+		{ GL_ELEMENT_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER_BINDING },
+		{ GL_UNIFORM_BUFFER, GL_UNIFORM_BUFFER_BINDING },
+		{ GL_PIXEL_UNPACK_BUFFER, GL_PIXEL_UNPACK_BUFFER_BINDING },
+	};
+	const GLenum textureTargets[][2]{
+		{ GL_TEXTURE_2D, GL_TEXTURE_BINDING_2D },
+		{ GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BINDING_2D_ARRAY },
+	};
+
+	template <size_t N>
+	int TargetIndex(const GLenum (&targets)[N][2], GLenum target)
+	{
+		for (size_t i{ 0 }; i < N; i++)
+		{
+			if (targets[i][0] == target)
+				return (int)i;
+		}
+		return -1;
+	}
+}
+
+GLStateCache& GLStateCache::Get()
+{
+	static GLStateCache cache;
+	return cache;
+}
+
+GLStateCache::GLStateCache()
+{
+	static_assert(sizeof(bufferTargets) / sizeof(bufferTargets[0]) == BufferTargets, "one binding per buffer target");
+	static_assert(sizeof(textureTargets) / sizeof(textureTargets[0]) == TextureTargets, "one binding per texture target");
+	Invalidate();
+}
+
+bool GLStateCache::Elide(Calls& calls, GLuint bound, GLuint id, GLenum query)
+{
+	bool elide{ Enabled && bound == id };
+	if (elide && Validate && Query(query) != id)
+	{
+		Counts.Stale++;
+		elide = false;
+	}
+
+	if (Count)
+		(elide ? calls.Elided : calls.Issued)++;
+	return elide;
+}
+
+GLuint GLStateCache::Query(GLenum query, GLuint unit)
+{
+	// Another unit's binding is only visible with that unit selected; put the selection back.
+	GLint selected{ 0 };
+	if (unit != Unknown)
+	{
+		glGetIntegerv(GL_ACTIVE_TEXTURE, &selected);
+		glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	GLint current{ 0 };
+	glGetIntegerv(query, &current);
+	if (query == GL_ACTIVE_TEXTURE)
+		current -= GL_TEXTURE0;
+
+	if (unit != Unknown)
+		glActiveTexture((GLenum)selected);
+	return (GLuint)current;
+}
+
+void GLStateCache::UseProgram(GLuint id)
+{
+	if (Elide(Counts.Programs, program, id, GL_CURRENT_PROGRAM))
+		return;
+
+	glUseProgram(id);
+	program = id;
+}
+
+void GLStateCache::BindVertexArray(GLuint id)
+{
+	if (Elide(Counts.VertexArrays, vertexArray, id, GL_VERTEX_ARRAY_BINDING))
+		return;
+
+	glBindVertexArray(id);
+	vertexArray = id;
+	// The element buffer binding belongs to the vertex array.
+	buffers[TargetIndex(bufferTargets, GL_ELEMENT_ARRAY_BUFFER)] = Unknown;
+}
+
+void GLStateCache::BindBuffer(GLenum target, GLuint id)
+{
+	int index{ TargetIndex(bufferTargets, target) };
+	if (index >= 0 && Elide(Counts.Buffers, buffers[index], id, bufferTargets[index][1]))
+		return;
+
+	glBindBuffer(target, id);
+	if (index >= 0)
+		buffers[index] = id;
+	else if (Count)
+		Counts.Buffers.Issued++;
+}
+
+void GLStateCache::BindBufferRange(GLenum target, GLuint index, GLuint id, GLintptr offset, GLsizeiptr size)
+{
+	glBindBufferRange(target, index, id, offset, size);
+
+	int tracked{ TargetIndex(bufferTargets, target) };
+	if (tracked >= 0)
+		buffers[tracked] = id;
+}
+
+void GLStateCache::ActiveTexture(GLuint unit)
+{
+	if (Elide(Counts.ActiveUnits, activeUnit, unit, GL_ACTIVE_TEXTURE))
+		return;
+
+	glActiveTexture(GL_TEXTURE0 + unit);
+	activeUnit = unit;
+}
+
+void GLStateCache::BindTexture(GLenum target, GLuint id)
+{
+	int index{ TargetIndex(textureTargets, target) };
+	if (activeUnit < MaxUnits && index >= 0 && Elide(Counts.Textures, textures[activeUnit][index], id, textureTargets[index][1]))
+		return;
+
+	glBindTexture(target, id);
+	if (activeUnit < MaxUnits && index >= 0)
+		textures[activeUnit][index] = id;
+	else if (Count)
+		Counts.Textures.Issued++;
+}
+
+void GLStateCache::BindTexture(GLuint unit, GLenum target, GLuint id)
+{
+	// Nothing to select the unit for if it already has the texture.
+	int index{ TargetIndex(textureTargets, target) };
+	if (Enabled && unit < MaxUnits && index >= 0 && textures[unit][index] == id)
+	{
+		if (!Validate || Query(textureTargets[index][1], unit) == id)
+		{
+			if (Count)
+				Counts.Textures.Elided++;
+			return;
+		}
+
+		// Forgotten, so the bind below is issued without being counted stale twice.
+		Counts.Stale++;
+		textures[unit][index] = Unknown;
+	}
+
+	ActiveTexture(unit);
+	BindTexture(target, id);
+}
+
+void GLStateCache::DeleteProgram(GLuint id)
+{
+	glDeleteProgram(id);
+	if (program == id)
+		program = Unknown;
+}
+
+void GLStateCache::DeleteVertexArray(GLuint id)
+{
+	glDeleteVertexArrays(1, &id);
+	if (vertexArray == id)
+		vertexArray = 0;
+}
+
+void GLStateCache::DeleteBuffer(GLuint id)
+{
+	glDeleteBuffers(1, &id);
+	for (GLuint& bound : buffers)
+	{
+		if (bound == id)
+			bound = 0;
+	}
+}
+
+void GLStateCache::DeleteTexture(GLuint id)
+{
+	glDeleteTextures(1, &id);
+	for (GLuint (&unit)[TextureTargets] : textures)
+	{
+		for (GLuint& bound : unit)
+		{
+			if (bound == id)
+				bound = 0;
+		}
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	program = Unknown;
+	vertexArray = Unknown;
+	activeUnit = Unknown;
+	for (GLuint& bound : buffers)
+		bound = Unknown;
+	for (GLuint (&unit)[TextureTargets] : textures)
+	{
+		for (GLuint& bound : unit)
+			bound = Unknown;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+
+// What GL has bound, so binding the program, vertex array, buffer or texture already there
+// never reaches the driver. Every wrapper binds and deletes through Get(); anything that
+// binds around it (ImGui, for one) leaves it out of date, so call Invalidate after.
+//
+// Buffers are tracked per target and textures per target of each unit, for the targets
+// listed in GLStateCache.cpp; binds to any other target are always issued.
+class GLStateCache
+{
+public:
+	static constexpr GLuint MaxUnits{ 16 };
+
+	static GLStateCache& Get();
+
+	GLStateCache();
+
+	struct Calls
+	{
+		size_t Issued{ 0 };
+		size_t Elided{ 0 };
+	};
+
+	// Counted since ResetStats while Count is set.
+	struct Stats
+	{
+		Calls Programs;
+		Calls VertexArrays;
+		Calls Buffers;
+		Calls ActiveUnits;
+		Calls Textures;
+		// Calls the cache would have elided but the driver had something else bound, found
+		// while Validate is set; they were issued. Anything here is a bind that went around
+		// the cache.
+		size_t Stale{ 0 };
+
+		size_t Issued() const { return Programs.Issued + VertexArrays.Issued + Buffers.Issued + ActiveUnits.Issued + Textures.Issued; }
+		size_t Elided() const { return Programs.Elided + VertexArrays.Elided + Buffers.Elided + ActiveUnits.Elided + Textures.Elided; }
+	};
+	Stats Counts;
+
+	// Counts every call in Counts. Plain counters, nothing is asked of the driver.
+	bool Count{ false };
+	// Checks each call about to be elided against the driver's binding with a glGet, which
+	// waits on the driver, so only for finding binds that go around the cache.
+	bool Validate{ false };
+	// Off, every call is issued, to compare against.
+	bool Enabled{ true };
+
+	void UseProgram(GLuint id);
+	void BindVertexArray(GLuint id);
+	void BindBuffer(GLenum target, GLuint id);
+	// Binds a range to an indexed target, which binds the buffer to target as well.
+	void BindBufferRange(GLenum target, GLuint index, GLuint id, GLintptr offset, GLsizeiptr size);
+	void ActiveTexture(GLuint unit);
+	// To the active unit, like glBindTexture.
+	void BindTexture(GLenum target, GLuint id);
+	void BindTexture(GLuint unit, GLenum target, GLuint id);
+
+	// Delete the object and forget any binding of it, since GL reuses the name.
+	void DeleteProgram(GLuint id);
+	void DeleteVertexArray(GLuint id);
+	void DeleteBuffer(GLuint id);
+	void DeleteTexture(GLuint id);
+
+	// Forgets everything, so the next bind of each kind is issued.
+	void Invalidate();
+	void ResetStats() { Counts = Stats(); }
+
+private:
+	static constexpr GLuint Unknown{ 0xFFFFFFFF };
+	static constexpr size_t BufferTargets{ 4 };
+	static constexpr size_t TextureTargets{ 2 };
+
+	GLuint program{ Unknown };
+	GLuint vertexArray{ Unknown };
+	GLuint buffers[BufferTargets];
+	GLuint activeUnit{ Unknown };
+	GLuint textures[MaxUnits][TextureTargets];
+
+	// True if the call can be dropped: bound already holds id and, with Validate, so does
+	// the driver's binding query. Counts the call either way.
+	bool Elide(Calls& calls, GLuint bound, GLuint id, GLenum query);
+	// What the driver has bound for query, on unit for texture bindings.
+	GLuint Query(GLenum query, GLuint unit = Unknown);
+};
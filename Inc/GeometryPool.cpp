@@ -0,0 +1,335 @@
+#include "GeometryPool.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	// On the copy target, so creating it changes no VAO's element buffer.
+	GLuint CreateBuffer(size_t bytes)
+	{
+		GLuint buffer;
+		glGenBuffers(1, &buffer);
+		GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)bytes, NULL, GL_STATIC_DRAW);
+		return buffer;
+	}
+
+	void Upload(GLuint buffer, size_t offset, const void* data, size_t bytes)
+	{
+		if (bytes == 0)
+			return;
+
+		GLStateCache::Get().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)offset, (GLsizeiptr)bytes, data);
+	}
+}
+
+void GeometryPool::FreeList::Reset(size_t size)
+{
+	blocks.clear();
+	if (size > 0)
+		blocks[0] = size;
+	capacity = size;
+	used = 0;
+}
+
+bool GeometryPool::FreeList::Allocate(size_t size, size_t alignment, size_t& offset)
+{
+	if (size == 0)
+	{
+		offset = 0;
+		return true;
+	}
+
+	for (std::map<size_t, size_t>::iterator block{ blocks.begin() }; block != blocks.end(); block++)
+	{
+		size_t blockStart{ block->first };
+		size_t blockEnd{ block->first + block->second };
+		size_t start{ AlignUp(blockStart, alignment) };
+		if (start + size > blockEnd)
+			continue;
+
+		// What the alignment skips stays free in front.
+		blocks.erase(block);
+		if (start > blockStart)
+			blocks[blockStart] = start - blockStart;
+		if (start + size < blockEnd)
+			blocks[start + size] = blockEnd - start - size;
+
+		used += size;
+		offset = start;
+		return true;
+	}
+
+	return false;
+}
+
+void GeometryPool::FreeList::Free(size_t offset, size_t size)
+{
+	if (size == 0)
+		return;
+
+	used -= size;
+	std::map<size_t, size_t>::iterator block{ blocks.emplace(offset, size).first };
+
+	std::map<size_t, size_t>::iterator next{ std::next(block) };
+	if (next != blocks.end() && offset + size == next->first)
+	{
+		block->second += next->second;
+		blocks.erase(next);
+	}
+
+	if (block != blocks.begin())
+	{
+		std::map<size_t, size_t>::iterator previous{ std::prev(block) };
+		if (previous->first + previous->second == offset)
+		{
+			previous->second += block->second;
+			blocks.erase(block);
+		}
+	}
+}
+
+GeometryPool::Stats GeometryPool::FreeList::Report() const
+{
+	Stats stats;
+	stats.Capacity = capacity;
+	stats.Used = used;
+	stats.FreeBlocks = blocks.size();
+	for (const std::pair<const size_t, size_t>& block : blocks)
+		stats.LargestFree = std::max(stats.LargestFree, block.second);
+	return stats;
+}
+
+GeometryPool::GeometryPool(GLsizeiptr vertexBytes, GLsizeiptr indexCount)
+{
+	vertices.ID = CreateBuffer((size_t)vertexBytes);
+	indices.ID = CreateBuffer((size_t)indexCount * sizeof(GLuint));
+	vertexHeap.Reset((size_t)vertexBytes);
+	indexHeap.Reset((size_t)indexCount);
+}
+
+GeometryPool::Handle GeometryPool::Add(const VertexFormat& format, const void* vertexData, size_t vertexCount, const GLuint* indexData, size_t indexCount)
+{
+	size_t stride{ (size_t)format.Stride() };
+	size_t vertexBytes{ vertexCount * stride };
+
+	// Alignment may skip up to a stride in front of each range, every mesh its own.
+	size_t vertexSlack{ stride };
+	for (const Mesh& mesh : meshes)
+	{
+		if (mesh.Live)
+			vertexSlack += (size_t)mesh.Format.Stride();
+	}
+
+	size_t vertexOffset, indexOffset;
+	bool packed{ false };
+	while (!Reserve(vertexBytes, stride, indexCount, vertexOffset, indexOffset))
+	{
+		// Packing is enough if the free space adds up, less what alignment may skip.
+		bool vertexFits{ vertexHeap.Used() + vertexBytes + vertexSlack <= vertexHeap.Capacity() };
+		bool indexFits{ indexHeap.Used() + indexCount <= indexHeap.Capacity() };
+		if (!packed && vertexFits && indexFits)
+		{
+			Rebuild(vertexHeap.Capacity(), indexHeap.Capacity());
+			Defragmentations++;
+			packed = true;
+			continue;
+		}
+
+		// Every Rebuild packs, so if one has run and there's still no room, grow the heap
+		// without a block big enough, or both, rather than pack again at the same size.
+		if (packed)
+		{
+			vertexFits = vertexHeap.Report().LargestFree >= vertexBytes + stride;
+			indexFits = indexHeap.Report().LargestFree >= indexCount;
+			if (vertexFits && indexFits)
+				vertexFits = indexFits = false;
+		}
+
+		Rebuild(vertexFits ? vertexHeap.Capacity() : std::max(vertexHeap.Capacity() * 2, vertexHeap.Used() + vertexBytes + vertexSlack),
+			indexFits ? indexHeap.Capacity() : std::max(indexHeap.Capacity() * 2, indexHeap.Used() + indexCount));
+		Growths++;
+		packed = true;
+	}
+
+	Upload(vertices.ID, vertexOffset, vertexData, vertexBytes);
+	Upload(indices.ID, indexOffset * sizeof(GLuint), indexData, indexCount * sizeof(GLuint));
+
+	Mesh mesh;
+	mesh.Format = format;
+	mesh.BaseVertex = (GLint)(vertexOffset / stride);
+	mesh.FirstIndex = (GLuint)indexOffset;
+	mesh.IndexCount = (GLuint)indexCount;
+	mesh.VertexCount = (GLuint)vertexCount;
+	mesh.Live = true;
+
+	// Make sure the format has its VAO.
+	VertexArray(format);
+
+	if (!freeHandles.empty())
+	{
+		Handle handle{ freeHandles.back() };
+		freeHandles.pop_back();
+		meshes[handle] = mesh;
+		return handle;
+	}
+
+	meshes.push_back(mesh);
+	return (Handle)(meshes.size() - 1);
+}
+
+void GeometryPool::Remove(Handle handle)
+{
+	Mesh& mesh{ meshes[handle] };
+	if (!mesh.Live)
+		return;
+
+	size_t stride{ (size_t)mesh.Format.Stride() };
+	vertexHeap.Free((size_t)mesh.BaseVertex * stride, (size_t)mesh.VertexCount * stride);
+	indexHeap.Free(mesh.FirstIndex, mesh.IndexCount);
+
+	mesh.Live = false;
+	freeHandles.push_back(handle);
+}
+
+VAO& GeometryPool::VertexArray(const VertexFormat& format)
+{
+	for (Layout& layout : layouts)
+	{
+		if (layout.Shared && layout.Format == format)
+			return layout.Array;
+	}
+
+	layouts.push_back(Layout{ format, VAO(), true });
+	Link(layouts.back());
+	return layouts.back().Array;
+}
+
+VAO& GeometryPool::NewVertexArray(const VertexFormat& format)
+{
+	layouts.push_back(Layout{ format, VAO(), false });
+	Link(layouts.back());
+	return layouts.back().Array;
+}
+
+void GeometryPool::Draw(Handle handle) const
+{
+	Draw(handle, 0, meshes[handle].IndexCount);
+}
+
+void GeometryPool::Draw(Handle handle, GLuint indexOffset, GLuint indexCount, GLsizei instances) const
+{
+	const Mesh& mesh{ meshes[handle] };
+	const void* first{ (const void*)((uintptr_t)(mesh.FirstIndex + indexOffset) * sizeof(GLuint)) };
+
+	if (instances == 1)
+		glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, first, mesh.BaseVertex);
+	else
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, first, instances, mesh.BaseVertex);
+}
+
+void GeometryPool::Defragment()
+{
+	Rebuild(vertexHeap.Capacity(), indexHeap.Capacity());
+	Defragmentations++;
+}
+
+GeometryPool::Stats GeometryPool::IndexStats() const
+{
+	Stats stats{ indexHeap.Report() };
+	stats.Capacity *= sizeof(GLuint);
+	stats.Used *= sizeof(GLuint);
+	stats.LargestFree *= sizeof(GLuint);
+	return stats;
+}
+
+bool GeometryPool::Reserve(size_t vertexBytes, size_t stride, size_t indexCount, size_t& vertexOffset, size_t& indexOffset)
+{
+	if (!vertexHeap.Allocate(vertexBytes, stride, vertexOffset))
+		return false;
+
+	if (!indexHeap.Allocate(indexCount, 1, indexOffset))
+	{
+		vertexHeap.Free(vertexOffset, vertexBytes);
+		return false;
+	}
+
+	return true;
+}
+
+void GeometryPool::Rebuild(size_t vertexCapacity, size_t indexCapacity)
+{
+	GLStateCache& state{ GLStateCache::Get() };
+
+	GLuint newVertices{ CreateBuffer(vertexCapacity) };
+	GLuint newIndices{ CreateBuffer(indexCapacity * sizeof(GLuint)) };
+	vertexHeap.Reset(vertexCapacity);
+	indexHeap.Reset(indexCapacity);
+
+	std::vector<Mesh*> live;
+	for (Mesh& mesh : meshes)
+	{
+		if (mesh.Live)
+			live.push_back(&mesh);
+	}
+	std::sort(live.begin(), live.end(), [](const Mesh* a, const Mesh* b)
+	{
+		return (size_t)a->BaseVertex * a->Format.Stride() < (size_t)b->BaseVertex * b->Format.Stride();
+	});
+
+	// First fit into empty buffers lays the ranges out back to back.
+	for (Mesh* entry : live)
+	{
+		Mesh& mesh{ *entry };
+		size_t stride{ (size_t)mesh.Format.Stride() };
+		size_t vertexBytes{ (size_t)mesh.VertexCount * stride };
+		size_t vertexOffset, indexOffset;
+		Reserve(vertexBytes, stride, mesh.IndexCount, vertexOffset, indexOffset);
+
+		state.BindBuffer(GL_COPY_READ_BUFFER, vertices.ID);
+		state.BindBuffer(GL_COPY_WRITE_BUFFER, newVertices);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)((size_t)mesh.BaseVertex * stride), (GLintptr)vertexOffset, (GLsizeiptr)vertexBytes);
+
+		state.BindBuffer(GL_COPY_READ_BUFFER, indices.ID);
+		state.BindBuffer(GL_COPY_WRITE_BUFFER, newIndices);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)(mesh.FirstIndex * sizeof(GLuint)), (GLintptr)(indexOffset * sizeof(GLuint)), (GLsizeiptr)(mesh.IndexCount * sizeof(GLuint)));
+
+		mesh.BaseVertex = (GLint)(vertexOffset / stride);
+		mesh.FirstIndex = (GLuint)indexOffset;
+	}
+
+	state.DeleteBuffer(vertices.ID);
+	state.DeleteBuffer(indices.ID);
+	vertices.ID = newVertices;
+	indices.ID = newIndices;
+
+	for (Layout& layout : layouts)
+		Link(layout);
+}
+
+void GeometryPool::Link(Layout& layout)
+{
+	layout.Array.Bind();
+	layout.Format.Link(layout.Array, vertices);
+	indices.Bind();
+	layout.Array.Unbind();
+}
+
+void GeometryPool::Delete()
+{
+	for (Layout& layout : layouts)
+		layout.Array.Delete();
+	layouts.clear();
+
+	vertices.Delete();
+	indices.Delete();
+	meshes.clear();
+	freeHandles.clear();
+}
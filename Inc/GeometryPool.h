@@ -0,0 +1,120 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "EBO.h"
+#include "VAO.h"
+#include "VBO.h"
+#include "VertexFormat.h"
+
+// Every static mesh in one vertex buffer and one index buffer.
+//
+// Each mesh gets a range of both from first-fit free lists. Vertex ranges start on a
+// multiple of the format's stride, so a mesh keeps its own 0-based indices and draws through
+// glDrawElementsBaseVertex from the one VAO of its format. When a mesh does not fit, the
+// live ranges are packed to the front of the buffers on the GPU (see Defragment), into
+// larger buffers if packing is not enough, and the VAOs are linked again. Ranges move, so
+// look a mesh up with Get when drawing rather than keeping its offsets.
+class GeometryPool
+{
+public:
+	using Handle = uint32_t;
+
+	struct Mesh
+	{
+		VertexFormat Format;
+		GLint BaseVertex{ 0 };
+		GLuint FirstIndex{ 0 };
+		GLuint IndexCount{ 0 };
+		GLuint VertexCount{ 0 };
+		bool Live{ false };
+	};
+
+	// Of one buffer, in bytes.
+	struct Stats
+	{
+		size_t Capacity{ 0 };
+		size_t Used{ 0 };
+		size_t FreeBlocks{ 0 };
+		size_t LargestFree{ 0 };
+
+		float Utilization() const { return Capacity ? 100.0f * float(Used) / float(Capacity) : 0.0f; }
+		// How much of the free space is outside the largest free block, so 0 when it is all in one.
+		float Fragmentation() const { return Capacity > Used ? 100.0f * (1.0f - float(LargestFree) / float(Capacity - Used)) : 0.0f; }
+	};
+
+	GeometryPool(GLsizeiptr vertexBytes, GLsizeiptr indexCount);
+
+	// vertexCount vertices in format, and indices counting from 0 within them.
+	Handle Add(const VertexFormat& format, const void* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount);
+	void Remove(Handle mesh);
+	const Mesh& Get(Handle mesh) const { return meshes[mesh]; }
+
+	// The VAO every mesh in format draws from.
+	VAO& VertexArray(const VertexFormat& format);
+	// Another VAO with the same vertex attributes, for attributes of its own like an
+	// InstanceBuffer's. Linked again along with the rest when the buffers move.
+	VAO& NewVertexArray(const VertexFormat& format);
+
+	// indexOffset counts from the mesh's first index. The mesh's VAO has to be bound.
+	void Draw(Handle mesh) const;
+	void Draw(Handle mesh, GLuint indexOffset, GLuint indexCount, GLsizei instances = 1) const;
+
+	// Packs every live range to the front of its buffer, leaving one free block in each.
+	void Defragment();
+
+	Stats VertexStats() const { return vertexHeap.Report(); }
+	Stats IndexStats() const;
+	size_t Count() const { return meshes.size() - freeHandles.size(); }
+	size_t Defragmentations{ 0 };
+	size_t Growths{ 0 };
+
+	void Delete();
+
+private:
+	// Free blocks by offset, merged with their neighbours when a range is freed.
+	class FreeList
+	{
+	public:
+		// One free block of size.
+		void Reset(size_t size);
+		bool Allocate(size_t size, size_t alignment, size_t& offset);
+		void Free(size_t offset, size_t size);
+		Stats Report() const;
+
+		size_t Capacity() const { return capacity; }
+		size_t Used() const { return used; }
+
+	private:
+		std::map<size_t, size_t> blocks;
+		size_t capacity{ 0 };
+		size_t used{ 0 };
+	};
+
+	struct Layout
+	{
+		VertexFormat Format;
+		VAO Array;
+		bool Shared;
+	};
+
+	VBO vertices;
+	EBO indices;
+	FreeList vertexHeap;
+	FreeList indexHeap;
+	std::vector<Mesh> meshes;
+	std::vector<Handle> freeHandles;
+	// A deque, so the VAO references handed out stay valid.
+	std::deque<Layout> layouts;
+
+	bool Reserve(size_t vertexBytes, size_t stride, size_t indexCount, size_t& vertexOffset, size_t& indexOffset);
+	// Copies the live ranges, packed in the order they were in, into new buffers of these
+	// sizes and links every VAO to them. No range moves up, so the old sizes always fit.
+	void Rebuild(size_t vertexCapacity, size_t indexCapacity);
+	void Link(Layout& layout);
+};
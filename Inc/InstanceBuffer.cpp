@@ -0,0 +1,52 @@
+#include "InstanceBuffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+InstanceBuffer::InstanceBuffer()
+{
+	Buffer.setup(NULL, 0);
+	Buffer.Unbind();
+}
+
+InstanceData InstanceBuffer::Make(const glm::mat4& model, const glm::mat4& normalSource, const glm::vec2& layers)
+{
+	InstanceData instance;
+	instance.Model = model;
+	instance.NormalMatrix = glm::transpose(glm::inverse(glm::mat3(normalSource)));
+	instance.Layers = layers;
+	return instance;
+}
+
+void InstanceBuffer::Upload(const InstanceData* instances, size_t instanceCount)
+{
+	count = instanceCount;
+	capacity = std::max(capacity, count);
+
+	Buffer.Bind();
+	glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(capacity * sizeof(InstanceData)), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(count * sizeof(InstanceData)), instances);
+	Buffer.Unbind();
+}
+
+void InstanceBuffer::Link(VAO& vao, size_t first)
+{
+	uintptr_t base{ first * sizeof(InstanceData) };
+	for (GLuint column{ 0 }; column < 4; column++)
+	{
+		uintptr_t offset{ base + offsetof(InstanceData, Model) + column * sizeof(glm::vec4) };
+		vao.LinkAttrib(Buffer, FirstLayout + column, 4, GL_FLOAT, sizeof(InstanceData), (void*)offset, GL_FALSE, 1);
+	}
+	for (GLuint column{ 0 }; column < 3; column++)
+	{
+		uintptr_t offset{ base + offsetof(InstanceData, NormalMatrix) + column * sizeof(glm::vec3) };
+		vao.LinkAttrib(Buffer, FirstLayout + 4 + column, 3, GL_FLOAT, sizeof(InstanceData), (void*)offset, GL_FALSE, 1);
+	}
+	vao.LinkAttrib(Buffer, FirstLayout + 7, 2, GL_FLOAT, sizeof(InstanceData), (void*)(base + offsetof(InstanceData, Layers)), GL_FALSE, 1);
+}
+
+void InstanceBuffer::Delete()
+{
+	Buffer.Delete();
+}
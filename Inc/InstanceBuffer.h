@@ -0,0 +1,49 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include <cstddef>
+
+#include "VAO.h"
+#include "VBO.h"
+
+// What one copy of an instanced mesh reads, matching INSTANCED in Shaders/lit.vert.
+struct InstanceData
+{
+	glm::mat4 Model;
+	glm::mat3 NormalMatrix;
+	// Albedo and specular layers in a TextureArray, as ObjectData's layers.
+	glm::vec2 Layers;
+};
+static_assert(sizeof(InstanceData) == 108, "InstanceData must be tightly packed");
+
+// Model and normal matrices of every copy of a mesh, so glDrawElementsInstanced draws them
+// all in one call. They are vertex attributes with a divisor of 1, at FirstLayout and up:
+// four vec4 columns of the model matrix, three vec3 columns of the normal matrix, then the
+// layers.
+class InstanceBuffer
+{
+public:
+	static constexpr GLuint FirstLayout{ 3 };
+
+	VBO Buffer;
+
+	InstanceBuffer();
+
+	// normalSource is the model matrix without any position decode, as for ObjectData.
+	static InstanceData Make(const glm::mat4& model, const glm::mat4& normalSource, const glm::vec2& layers = glm::vec2(0.0f));
+
+	// Replaces the contents, orphaning the old storage like UBO::Upload.
+	void Upload(const InstanceData* instances, size_t count);
+	size_t Count() const { return count; }
+
+	// Points the attributes of the bound vao at the instances from first on. GL 3.3 has no
+	// base instance, so drawing a later range means linking again with its first.
+	void Link(VAO& vao, size_t first = 0);
+
+	void Delete();
+
+private:
+	size_t count{ 0 };
+	size_t capacity{ 0 };
+};
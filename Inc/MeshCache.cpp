@@ -0,0 +1,503 @@
+#include "MeshCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+
+namespace
+{
+	constexpr char cacheMagic[4]{ 'O', 'M', 'C', 'H' };
+	constexpr uint32_t cacheVersion{ 5 };
+	constexpr uint32_t flagReduceOverdraw{ 1 };
+	constexpr uint32_t flagMeshlets{ 2 };
+
+	struct CacheHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		float UVScale;
+		uint32_t FloatsPerVertex;
+		uint32_t MeshCount;
+		uint32_t Flags;
+		uint32_t LodRatioCount;
+		float LodRatios[MeshCache::MaxLods - 1];
+		uint64_t VertexCount;
+		uint64_t IndexCount;
+		uint64_t VertexBlockOffset;
+		uint64_t IndexBlockOffset;
+		uint64_t MeshletCount;
+		uint64_t MeshletBlockOffset;
+		uint64_t EncodedBlockOffset;
+		uint32_t Encoding;
+		float PositionOffset[3];
+		float PositionScale[3];
+		uint32_t Padding;
+	};
+
+	uint32_t EncodingCode(const VertexFormat& format)
+	{
+		return uint32_t(format.Position) | uint32_t(format.TexCoord) << 8 | uint32_t(format.Normal) << 16;
+	}
+
+	// FNV-1a over 64-bit words, then the tail bytes.
+	uint64_t HashBytes(const char* data, size_t size, uint64_t hash)
+	{
+		constexpr uint64_t prime{ 0x100000001B3ull };
+
+		size_t i{ 0 };
+		for (; i + 8 <= size; i += 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			hash = (hash ^ word) * prime;
+		}
+		for (; i < size; i++)
+		{
+			hash = (hash ^ (unsigned char)data[i]) * prime;
+		}
+
+		return hash;
+	}
+
+	// Hash the .obj and every .mtl it references.
+	bool HashSource(const std::string& objPath, uint64_t& hash)
+	{
+		objl::MappedFile obj;
+		if (!obj.Open(objPath))
+			return false;
+
+		hash = HashBytes(obj.Data(), obj.Size(), 0xCBF29CE484222325ull);
+
+		std::string_view text(obj.Data(), obj.Size());
+		std::filesystem::path dir{ std::filesystem::path(objPath).parent_path() };
+
+		for (size_t pos{ text.find("mtllib") }; pos != std::string_view::npos; pos = text.find("mtllib", pos + 6))
+		{
+			if (pos != 0 && text[pos - 1] != '\n')
+				continue;
+
+			size_t lineEnd{ text.find('\n', pos) };
+			std::string_view line{ text.substr(pos, lineEnd == std::string_view::npos ? std::string_view::npos : lineEnd - pos) };
+			std::string mtlPath{ (dir / std::string(objl::algorithm::tailView(line))).string() };
+
+			objl::MappedFile mtl;
+			if (mtl.Open(mtlPath))
+				hash = HashBytes(mtl.Data(), mtl.Size(), hash);
+		}
+
+		return true;
+	}
+
+	void CopyName(char (&dst)[64], const std::string& src)
+	{
+		std::memset(dst, 0, sizeof(dst));
+		std::memcpy(dst, src.data(), std::min(src.size(), sizeof(dst) - 1));
+	}
+
+	bool SameLodRatios(const CacheHeader& header, const std::vector<float>& lodRatios)
+	{
+		if (header.LodRatioCount != std::min(lodRatios.size(), size_t(MeshCache::MaxLods - 1)))
+			return false;
+
+		for (uint32_t i{ 0 }; i < header.LodRatioCount; i++)
+		{
+			if (header.LodRatios[i] != lodRatios[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	// Written so that no sum can wrap around, whatever the file holds.
+	bool InRange(uint64_t offset, uint64_t count, uint64_t size)
+	{
+		return offset <= size && count <= size - offset;
+	}
+
+	bool BlockFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize)
+	{
+		return offset <= fileSize && count <= (fileSize - offset) / elementSize;
+	}
+
+	bool IndicesBelow(const GLuint* indices, uint64_t offset, uint64_t count, uint64_t vertexEnd)
+	{
+		for (uint64_t i{ offset }; i < offset + count; i++)
+		{
+			if (indices[i] >= vertexEnd)
+				return false;
+		}
+		return true;
+	}
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+}
+
+std::string MeshCache::CachePath(const std::string& objPath)
+{
+	std::filesystem::path path{ objPath };
+	return (path.parent_path() / "Cache" / path.stem()).string() + ".meshcache";
+}
+
+bool MeshCache::Load(const std::string& objPath, float uvScale)
+{
+	Release();
+
+	std::chrono::steady_clock::time_point startTime{ std::chrono::steady_clock::now() };
+
+	uint64_t sourceHash;
+	if (!HashSource(objPath, sourceHash))
+		return false;
+
+	std::string cachePath{ CachePath(objPath) };
+
+	WarmStart = LoadBaked(cachePath, sourceHash, uvScale);
+	if (!WarmStart && !Bake(objPath, cachePath, sourceHash, uvScale))
+		return false;
+
+	LoadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::cout << "- " << objPath << ": " << (WarmStart ? "warm cache load " : "cold bake ")
+		<< LoadSeconds * 1000.0 << " ms (" << VertexCount << " vertices, " << IndexCount << " indices)\n";
+
+	return true;
+}
+
+bool MeshCache::LoadBaked(const std::string& cachePath, uint64_t sourceHash, float uvScale)
+{
+	if (!mappedFile.Open(cachePath) || mappedFile.Size() < sizeof(CacheHeader))
+	{
+		mappedFile.Close();
+		return false;
+	}
+
+	CacheHeader header;
+	std::memcpy(&header, mappedFile.Data(), sizeof(header));
+
+	uint64_t entriesEnd{ sizeof(CacheHeader) + uint64_t(header.MeshCount) * sizeof(Entry) };
+
+	bool valid{ std::memcmp(header.Magic, cacheMagic, sizeof(cacheMagic)) == 0
+		&& header.Version == cacheVersion
+		&& header.SourceHash == sourceHash
+		&& header.UVScale == uvScale
+		&& header.FloatsPerVertex == FloatsPerVertex
+		&& header.Flags == Flags()
+		&& header.Encoding == EncodingCode(Encoding)
+		&& SameLodRatios(header, LodRatios)
+		&& header.VertexBlockOffset >= entriesEnd
+		&& BlockFits(header.VertexBlockOffset, header.VertexCount, FloatsPerVertex * sizeof(GLfloat), mappedFile.Size())
+		&& BlockFits(header.IndexBlockOffset, header.IndexCount, sizeof(GLuint), mappedFile.Size())
+		&& BlockFits(header.MeshletBlockOffset, header.MeshletCount, sizeof(MeshletBuilder::Meshlet), mappedFile.Size())
+		&& BlockFits(header.EncodedBlockOffset, header.VertexCount, (uint64_t)Encoding.Stride(), mappedFile.Size()) };
+
+	if (!valid)
+	{
+		mappedFile.Close();
+		return false;
+	}
+
+	Meshes.resize(header.MeshCount);
+	std::memcpy(Meshes.data(), mappedFile.Data() + sizeof(CacheHeader), Meshes.size() * sizeof(Entry));
+
+	// Every range has to lie inside its block and every index has to name a vertex of its own
+	// mesh, or a damaged file would have draws read past the buffers. Anything off and the
+	// model is baked again.
+	const GLuint* indices{ reinterpret_cast<const GLuint*>(mappedFile.Data() + header.IndexBlockOffset) };
+	const MeshletBuilder::Meshlet* meshlets{ reinterpret_cast<const MeshletBuilder::Meshlet*>(mappedFile.Data() + header.MeshletBlockOffset) };
+	for (const Entry& entry : Meshes)
+	{
+		valid = valid
+			&& InRange(entry.VertexOffset, entry.VertexCount, header.VertexCount)
+			&& InRange(entry.IndexOffset, entry.IndexCount, header.IndexCount)
+			&& entry.LodCount >= 1 && entry.LodCount <= MaxLods
+			&& entry.Lods[0].IndexOffset == entry.IndexOffset && entry.Lods[0].IndexCount == entry.IndexCount
+			&& InRange(entry.MeshletOffset, entry.MeshletCount, header.MeshletCount)
+			&& entry.Name[sizeof(entry.Name) - 1] == '\0' && entry.Material[sizeof(entry.Material) - 1] == '\0';
+
+		for (uint32_t lod{ 1 }; valid && lod < entry.LodCount; lod++)
+			valid = InRange(entry.Lods[lod].IndexOffset, entry.Lods[lod].IndexCount, header.IndexCount);
+
+		uint64_t vertexEnd{ entry.VertexOffset + entry.VertexCount };
+		for (uint32_t lod{ 0 }; valid && lod < entry.LodCount; lod++)
+			valid = IndicesBelow(indices, entry.Lods[lod].IndexOffset, entry.Lods[lod].IndexCount, vertexEnd);
+
+		// Meshlet index offsets count from the mesh's first index.
+		for (uint32_t i{ 0 }; valid && i < entry.MeshletCount; i++)
+		{
+			const MeshletBuilder::Meshlet& meshlet{ meshlets[entry.MeshletOffset + i] };
+			valid = InRange(meshlet.IndexOffset, uint64_t(meshlet.TriangleCount) * 3, entry.IndexCount);
+		}
+	}
+
+	if (!valid)
+	{
+		std::cerr << "Mesh cache " << cachePath << " has ranges or indices outside its blocks, baking it again\n";
+		Meshes.clear();
+		mappedFile.Close();
+		return false;
+	}
+
+	Vertices = reinterpret_cast<const GLfloat*>(mappedFile.Data() + header.VertexBlockOffset);
+	VertexCount = header.VertexCount;
+	Indices = indices;
+	IndexCount = header.IndexCount;
+	Meshlets = reinterpret_cast<const MeshletBuilder::Meshlet*>(mappedFile.Data() + header.MeshletBlockOffset);
+	MeshletCount = header.MeshletCount;
+
+	EncodedMesh decode;
+	decode.PositionOffset = glm::vec3(header.PositionOffset[0], header.PositionOffset[1], header.PositionOffset[2]);
+	decode.PositionScale = glm::vec3(header.PositionScale[0], header.PositionScale[1], header.PositionScale[2]);
+	EncodedVertices = reinterpret_cast<const uint8_t*>(mappedFile.Data() + header.EncodedBlockOffset);
+	EncodedDecode = decode.DecodeMatrix();
+
+	return true;
+}
+
+bool MeshCache::Bake(const std::string& objPath, const std::string& cachePath, uint64_t sourceHash, float uvScale)
+{
+	objl::Loader loader;
+	loader.WeldVertices = true;
+	loader.Storage = objl::Loader::StorageMode::PerMesh;
+	if (!loader.LoadFileMapped(objPath))
+		return false;
+
+	MeshOptimizer::CacheStats before;
+	MeshOptimizer::CacheStats after;
+
+	for (objl::Mesh& mesh : loader.LoadedMeshes)
+	{
+		std::vector<GLfloat> vertices;
+		vertices.reserve(mesh.Vertices.size() * FloatsPerVertex);
+
+		for (objl::Vertex& v : mesh.Vertices)
+		{
+			vertices.push_back(v.Position.X);
+			vertices.push_back(v.Position.Y);
+			vertices.push_back(v.Position.Z);
+
+			vertices.push_back(v.Position.X * uvScale);
+			vertices.push_back(v.Position.Z * uvScale);
+
+			vertices.push_back(v.Normal.X);
+			vertices.push_back(v.Normal.Y);
+			vertices.push_back(v.Normal.Z);
+		}
+
+		std::vector<GLuint> indices(mesh.Indices.begin(), mesh.Indices.end());
+		size_t vertexCount{ mesh.Vertices.size() };
+
+		MeshOptimizer::CacheStats meshBefore{ MeshOptimizer::SimulateVertexCache(indices.data(), indices.size(), vertexCount) };
+
+		// Every level is simplified from the full mesh so its error is measured against the original.
+		std::vector<std::vector<GLuint>> levels{ indices };
+		std::vector<float> levelErrors{ 0.0f };
+
+		for (size_t i{ 0 }; i < LodRatios.size() && levels.size() < MaxLods; i++)
+		{
+			size_t target{ size_t(double(indices.size()) * LodRatios[i]) / 3 * 3 };
+
+			std::vector<GLuint> level;
+			float error{ MeshSimplifier::Simplify(level, indices.data(), indices.size(), vertices.data(), vertexCount, FloatsPerVertex, target) };
+			if (level.empty() || level.size() >= levels.back().size())
+				break;
+
+			levels.push_back(std::move(level));
+			levelErrors.push_back(std::max(error, levelErrors.back()));
+		}
+
+		for (std::vector<GLuint>& level : levels)
+		{
+			MeshOptimizer::OptimizeVertexCache(level.data(), level.size(), vertexCount);
+			if (ReduceOverdraw)
+				MeshOptimizer::OptimizeOverdraw(level.data(), level.size(), vertices.data(), vertexCount, FloatsPerVertex);
+		}
+
+		// Meshlets are grown in the optimized order, so they mostly keep its cache and overdraw benefits.
+		std::vector<MeshletBuilder::Meshlet> meshlets;
+		if (BuildMeshlets)
+		{
+			std::chrono::steady_clock::time_point buildStart{ std::chrono::steady_clock::now() };
+			meshlets = MeshletBuilder::Build(levels[0].data(), levels[0].size(), vertices.data(), vertexCount, FloatsPerVertex);
+			double buildMs{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count() };
+
+			std::cout << "- " << mesh.MeshName << ": built " << meshlets.size() << " meshlets in " << buildMs << " ms ("
+				<< (buildMs > 0.0 ? double(levels[0].size() / 3) / buildMs / 1000.0 : 0.0) << " M tris/s)\n";
+			MeshletBuilder::PrintCullingReport(mesh.MeshName.c_str(), meshlets);
+		}
+
+		// Fetch order follows the full mesh; the coarser levels only reuse its vertices.
+		indices.clear();
+		for (const std::vector<GLuint>& level : levels)
+		{
+			indices.insert(indices.end(), level.begin(), level.end());
+		}
+		vertexCount = MeshOptimizer::OptimizeVertexFetch(vertices, indices.data(), indices.size(), FloatsPerVertex);
+
+		MeshOptimizer::CacheStats meshAfter{ MeshOptimizer::SimulateVertexCache(indices.data(), levels[0].size(), vertexCount) };
+
+		before.Misses += meshBefore.Misses;
+		before.Triangles += meshBefore.Triangles;
+		before.Vertices += meshBefore.Vertices;
+		after.Misses += meshAfter.Misses;
+		after.Triangles += meshAfter.Triangles;
+		after.Vertices += meshAfter.Vertices;
+
+		Entry entry{};
+		entry.VertexOffset = (uint32_t)(bakedVertices.size() / FloatsPerVertex);
+		entry.VertexCount = (uint32_t)vertexCount;
+		entry.IndexOffset = (uint32_t)bakedIndices.size();
+		entry.IndexCount = (uint32_t)levels[0].size();
+		entry.LodCount = (uint32_t)levels.size();
+		for (size_t i{ 0 }, offset{ bakedIndices.size() }; i < levels.size(); offset += levels[i].size(), i++)
+		{
+			entry.Lods[i] = { (uint32_t)offset, (uint32_t)levels[i].size(), levelErrors[i] };
+		}
+		entry.MeshletOffset = (uint32_t)bakedMeshlets.size();
+		entry.MeshletCount = (uint32_t)meshlets.size();
+		CopyName(entry.Name, mesh.MeshName);
+		CopyName(entry.Material, mesh.MeshMaterial.name);
+		Meshes.push_back(entry);
+
+		bakedMeshlets.insert(bakedMeshlets.end(), meshlets.begin(), meshlets.end());
+
+		if (levels.size() > 1)
+		{
+			std::cout << "- " << mesh.MeshName << " LODs:";
+			for (size_t i{ 0 }; i < levels.size(); i++)
+			{
+				std::cout << " " << levels[i].size() / 3 << " tris (error " << levelErrors[i] << ")";
+			}
+			std::cout << "\n";
+		}
+
+		bakedVertices.insert(bakedVertices.end(), vertices.begin(), vertices.end());
+
+		for (GLuint index : indices)
+		{
+			bakedIndices.push_back(entry.VertexOffset + index);
+		}
+	}
+
+	std::cout << "- " << objPath << ": ACMR " << before.ACMR() << " -> " << after.ACMR()
+		<< ", ATVR " << before.ATVR() << " -> " << after.ATVR() << "\n";
+
+	Vertices = bakedVertices.data();
+	VertexCount = bakedVertices.size() / FloatsPerVertex;
+	Indices = bakedIndices.data();
+	IndexCount = bakedIndices.size();
+	Meshlets = bakedMeshlets.data();
+	MeshletCount = bakedMeshlets.size();
+
+	// Encoded once here, so warm loads upload it as it is.
+	EncodedMesh encoded;
+	bool shareVertices{ Encoding == VertexFormat::Full() };
+	if (shareVertices)
+	{
+		EncodedVertices = reinterpret_cast<const uint8_t*>(Vertices);
+	}
+	else
+	{
+		encoded = EncodeVertices(Vertices, VertexCount, Encoding);
+		bakedEncoded = std::move(encoded.Data);
+		EncodedVertices = bakedEncoded.data();
+	}
+	EncodedDecode = encoded.DecodeMatrix();
+
+	CacheHeader header{};
+	std::memcpy(header.Magic, cacheMagic, sizeof(cacheMagic));
+	header.Version = cacheVersion;
+	header.SourceHash = sourceHash;
+	header.UVScale = uvScale;
+	header.FloatsPerVertex = FloatsPerVertex;
+	header.MeshCount = (uint32_t)Meshes.size();
+	header.Flags = Flags();
+	header.LodRatioCount = (uint32_t)std::min(LodRatios.size(), size_t(MaxLods - 1));
+	std::copy(LodRatios.begin(), LodRatios.begin() + header.LodRatioCount, header.LodRatios);
+	header.VertexCount = VertexCount;
+	header.IndexCount = IndexCount;
+	header.VertexBlockOffset = AlignUp(sizeof(CacheHeader) + Meshes.size() * sizeof(Entry), 16);
+	header.IndexBlockOffset = AlignUp(header.VertexBlockOffset + VertexBytes(), 16);
+	header.MeshletCount = MeshletCount;
+	header.MeshletBlockOffset = AlignUp(header.IndexBlockOffset + IndexBytes(), 16);
+	header.EncodedBlockOffset = shareVertices ? header.VertexBlockOffset : AlignUp(header.MeshletBlockOffset + MeshletCount * sizeof(MeshletBuilder::Meshlet), 16);
+	header.Encoding = EncodingCode(Encoding);
+	for (int axis{ 0 }; axis < 3; axis++)
+	{
+		header.PositionOffset[axis] = encoded.PositionOffset[axis];
+		header.PositionScale[axis] = encoded.PositionScale[axis];
+	}
+
+	// A failed write only costs the next launch another bake.
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), error);
+
+	std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		std::cerr << "Failed to write mesh cache " << cachePath << "\n";
+		return true;
+	}
+
+	const char padding[16]{};
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(Meshes.data()), Meshes.size() * sizeof(Entry));
+	out.write(padding, header.VertexBlockOffset - (sizeof(CacheHeader) + Meshes.size() * sizeof(Entry)));
+	out.write(reinterpret_cast<const char*>(Vertices), VertexBytes());
+	out.write(padding, header.IndexBlockOffset - (header.VertexBlockOffset + VertexBytes()));
+	out.write(reinterpret_cast<const char*>(Indices), IndexBytes());
+	out.write(padding, header.MeshletBlockOffset - (header.IndexBlockOffset + IndexBytes()));
+	out.write(reinterpret_cast<const char*>(Meshlets), MeshletCount * sizeof(MeshletBuilder::Meshlet));
+	if (!shareVertices)
+	{
+		out.write(padding, header.EncodedBlockOffset - (header.MeshletBlockOffset + MeshletCount * sizeof(MeshletBuilder::Meshlet)));
+		out.write(reinterpret_cast<const char*>(EncodedVertices), EncodedBytes());
+	}
+
+	return true;
+}
+
+uint32_t MeshCache::Flags() const
+{
+	return (ReduceOverdraw ? flagReduceOverdraw : 0) | (BuildMeshlets ? flagMeshlets : 0);
+}
+
+unsigned int MeshCache::SelectLod(const Entry& entry, float worldScale, float distance, float screenHeight, float fovDegrees, float maxPixelError)
+{
+	float pixelsPerUnit{ screenHeight / (2.0f * std::tan(fovDegrees * 0.5f * 3.14159265f / 180.0f) * std::max(distance, 0.001f)) };
+
+	unsigned int lod{ 0 };
+	while (lod + 1 < entry.LodCount && entry.Lods[lod + 1].Error * worldScale * pixelsPerUnit <= maxPixelError)
+		lod++;
+
+	return lod;
+}
+
+void MeshCache::Release()
+{
+	mappedFile.Close();
+	bakedVertices = std::vector<GLfloat>();
+	bakedIndices = std::vector<GLuint>();
+	bakedMeshlets = std::vector<MeshletBuilder::Meshlet>();
+	bakedEncoded = std::vector<uint8_t>();
+
+	Vertices = nullptr;
+	VertexCount = 0;
+	Indices = nullptr;
+	IndexCount = 0;
+	Meshlets = nullptr;
+	MeshletCount = 0;
+	EncodedVertices = nullptr;
+	EncodedDecode = glm::mat4(1.0f);
+	Meshes.clear();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OBJ_Loader.hpp"
+#include "MeshletBuilder.h"
+#include "VertexFormat.h"
+
+// Baked, GPU-ready copy of an .obj file.
+//
+// The first load of a model parses it with objl::Loader, interleaves every vertex as
+// position / planar texture coordinate / normal (8 floats), runs each mesh through
+// MeshOptimizer for post-transform cache and fetch order, appends any MeshSimplifier LODs
+// to the index block, optionally splits the full detail level into MeshletBuilder clusters
+// and writes the vertex block, the vertex block converted to Encoding,
+// the index block and the per-mesh ranges to Assets/Cache. Later loads whose source hash
+// still matches map that file and point Vertices / Indices straight into the mapping.
+class MeshCache
+{
+public:
+	static constexpr unsigned int FloatsPerVertex{ 8 };
+	static constexpr unsigned int MaxLods{ 4 };
+
+	// Index range of one detail level. Error is the simplification error in model units.
+	struct Lod
+	{
+		uint32_t IndexOffset;
+		uint32_t IndexCount;
+		float Error;
+	};
+
+	// Range of one objl::Mesh inside the baked blocks. Indices are absolute into the vertex block.
+	// Lods[0] is the full mesh, the same range as IndexOffset / IndexCount.
+	struct Entry
+	{
+		uint32_t VertexOffset;
+		uint32_t VertexCount;
+		uint32_t IndexOffset;
+		uint32_t IndexCount;
+		uint32_t LodCount;
+		Lod Lods[MaxLods];
+		// Meshlets of Lods[0]; their IndexOffset is relative to IndexOffset.
+		uint32_t MeshletOffset;
+		uint32_t MeshletCount;
+		char Name[64];
+		char Material[64];
+	};
+
+	const GLfloat* Vertices{ nullptr };
+	size_t VertexCount{ 0 };
+	const GLuint* Indices{ nullptr };
+	size_t IndexCount{ 0 };
+	std::vector<Entry> Meshes;
+	const MeshletBuilder::Meshlet* Meshlets{ nullptr };
+	size_t MeshletCount{ 0 };
+	// The VertexCount vertices in Encoding, and the matrix their positions decode with.
+	const uint8_t* EncodedVertices{ nullptr };
+	glm::mat4 EncodedDecode{ glm::mat4(1.0f) };
+
+	// Also cluster triangles so outward facing parts draw first. Changing it rebakes.
+	bool ReduceOverdraw{ false };
+	// Triangle ratios of the simplified levels after Lods[0], e.g. { 0.5f, 0.25f, 0.1f }.
+	// Levels that cannot get smaller than the previous one are dropped. Changing it rebakes.
+	std::vector<float> LodRatios;
+	// Split the full detail level into meshlets with culling bounds. Changing it rebakes.
+	bool BuildMeshlets{ false };
+	// Format EncodedVertices are baked in. Full shares the vertex block. Changing it rebakes.
+	VertexFormat Encoding{ VertexFormat::Full() };
+
+	// True if the last Load came from an up to date cache file.
+	bool WarmStart{ false };
+	double LoadSeconds{ 0.0 };
+
+	// Texture coordinates are the vertex X/Z position times uvScale.
+	bool Load(const std::string& objPath, float uvScale);
+	// Frees the mapping or the freshly baked buffers once they are uploaded.
+	void Release();
+
+	GLsizeiptr VertexBytes() const { return (GLsizeiptr)(VertexCount * FloatsPerVertex * sizeof(GLfloat)); }
+	GLsizeiptr IndexBytes() const { return (GLsizeiptr)(IndexCount * sizeof(GLuint)); }
+	GLsizeiptr EncodedBytes() const { return (GLsizeiptr)(VertexCount * Encoding.Stride()); }
+
+	static std::string CachePath(const std::string& objPath);
+
+	// Coarsest level whose error, scaled by worldScale and seen from distance, stays under
+	// maxPixelError on a screenHeight pixel tall viewport with a vertical fovDegrees.
+	static unsigned int SelectLod(const Entry& entry, float worldScale, float distance, float screenHeight, float fovDegrees, float maxPixelError = 1.0f);
+
+private:
+	objl::MappedFile mappedFile;
+	std::vector<GLfloat> bakedVertices;
+	std::vector<GLuint> bakedIndices;
+	std::vector<MeshletBuilder::Meshlet> bakedMeshlets;
+	std::vector<uint8_t> bakedEncoded;
+
+	uint32_t Flags() const;
+	bool LoadBaked(const std::string& cachePath, uint64_t sourceHash, float uvScale);
+	bool Bake(const std::string& objPath, const std::string& cachePath, uint64_t sourceHash, float uvScale);
+};
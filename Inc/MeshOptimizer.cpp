@@ -0,0 +1,412 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+	// Scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+	constexpr int cacheSize{ 32 };
+	constexpr float cacheDecayPower{ 1.5f };
+	constexpr float lastTriangleScore{ 0.75f };
+	constexpr float valenceBoostScale{ 2.0f };
+	constexpr float valenceBoostPower{ 0.5f };
+	constexpr unsigned int valenceTableSize{ 64 };
+
+	struct ScoreTables
+	{
+		float Cache[cacheSize];
+		float Valence[valenceTableSize];
+
+		ScoreTables()
+		{
+			for (int i{ 0 }; i < cacheSize; i++)
+			{
+				Cache[i] = i < 3 ? lastTriangleScore : std::pow(1.0f - float(i - 3) / float(cacheSize - 3), cacheDecayPower);
+			}
+			Valence[0] = 0.0f;
+			for (unsigned int i{ 1 }; i < valenceTableSize; i++)
+			{
+				Valence[i] = valenceBoostScale * std::pow(float(i), -valenceBoostPower);
+			}
+		}
+	};
+
+	float VertexScore(const ScoreTables& tables, int cachePosition, unsigned int remaining)
+	{
+		// No triangles left to draw, so keeping it in the cache is worthless.
+		if (remaining == 0)
+			return -1.0f;
+
+		float score{ cachePosition >= 0 ? tables.Cache[cachePosition] : 0.0f };
+		score += remaining < valenceTableSize ? tables.Valence[remaining] : valenceBoostScale * std::pow(float(remaining), -valenceBoostPower);
+
+		return score;
+	}
+
+	struct Vec3
+	{
+		float X, Y, Z;
+	};
+
+	Vec3 Position(const GLfloat* vertices, size_t floatsPerVertex, GLuint index)
+	{
+		const GLfloat* p{ vertices + index * floatsPerVertex };
+		return { p[0], p[1], p[2] };
+	}
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::SimulateVertexCache(const GLuint* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize)
+{
+	CacheStats stats;
+	stats.Triangles = indexCount / 3;
+
+	// A vertex is cached if fewer than cacheSize misses happened since it was loaded.
+	std::vector<size_t> loadedAt(vertexCount, 0);
+	std::vector<bool> referenced(vertexCount, false);
+	size_t clock{ size_t(cacheSize) + 1 };
+
+	for (size_t i{ 0 }; i < indexCount; i++)
+	{
+		GLuint v{ indices[i] };
+		if (!referenced[v])
+		{
+			referenced[v] = true;
+			stats.Vertices++;
+		}
+
+		if (clock - loadedAt[v] > cacheSize)
+		{
+			loadedAt[v] = clock++;
+			stats.Misses++;
+		}
+	}
+
+	return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(GLuint* indices, size_t indexCount, size_t vertexCount)
+{
+	static const ScoreTables tables;
+
+	size_t triangleCount{ indexCount / 3 };
+	if (triangleCount == 0)
+		return;
+
+	// Triangles using each vertex, packed back to back. The first remaining[v] entries of a
+	// vertex's range are the triangles it still has to draw.
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (size_t i{ 0 }; i < triangleCount * 3; i++)
+	{
+		remaining[indices[i]]++;
+	}
+
+	std::vector<size_t> adjacencyOffset(vertexCount + 1, 0);
+	for (size_t v{ 0 }; v < vertexCount; v++)
+	{
+		adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+	}
+
+	std::vector<unsigned int> adjacency(triangleCount * 3);
+	{
+		std::vector<size_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+		for (size_t t{ 0 }; t < triangleCount; t++)
+		{
+			for (int k{ 0 }; k < 3; k++)
+			{
+				adjacency[fill[indices[t * 3 + k]]++] = (unsigned int)t;
+			}
+		}
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v{ 0 }; v < vertexCount; v++)
+	{
+		vertexScore[v] = VertexScore(tables, -1, remaining[v]);
+	}
+
+	std::vector<float> triangleScore(triangleCount);
+	for (size_t t{ 0 }; t < triangleCount; t++)
+	{
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<GLuint> output;
+	output.reserve(triangleCount * 3);
+
+	GLuint cache[cacheSize + 3];
+	GLuint nextCache[cacheSize + 3];
+	size_t cacheCount{ 0 };
+
+	size_t deadEndCursor{ 0 };
+	long long bestTriangle{ (long long)(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin()) };
+
+	while (output.size() < triangleCount * 3)
+	{
+		// Nothing in the cache has triangles left: take the next one in input order.
+		if (bestTriangle < 0)
+		{
+			while (emitted[deadEndCursor])
+				deadEndCursor++;
+
+			bestTriangle = (long long)deadEndCursor;
+		}
+
+		const GLuint* triangle{ indices + bestTriangle * 3 };
+		emitted[bestTriangle] = true;
+
+		size_t nextCount{ 0 };
+		for (int k{ 0 }; k < 3; k++)
+		{
+			GLuint v{ triangle[k] };
+			output.push_back(v);
+			nextCache[nextCount++] = v;
+
+			unsigned int* begin{ adjacency.data() + adjacencyOffset[v] };
+			unsigned int* end{ begin + remaining[v] };
+			std::iter_swap(std::find(begin, end, (unsigned int)bestTriangle), end - 1);
+			remaining[v]--;
+		}
+
+		for (size_t i{ 0 }; i < cacheCount; i++)
+		{
+			GLuint v{ cache[i] };
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				nextCache[nextCount++] = v;
+		}
+
+		// Anything past cacheSize has just been evicted and only gets its score lowered.
+		for (size_t i{ 0 }; i < nextCount; i++)
+		{
+			GLuint v{ nextCache[i] };
+			cachePosition[v] = i < cacheSize ? (int)i : -1;
+
+			float score{ VertexScore(tables, cachePosition[v], remaining[v]) };
+			float delta{ score - vertexScore[v] };
+			vertexScore[v] = score;
+
+			for (size_t a{ adjacencyOffset[v] }; a < adjacencyOffset[v] + remaining[v]; a++)
+			{
+				triangleScore[adjacency[a]] += delta;
+			}
+		}
+
+		cacheCount = std::min(nextCount, (size_t)cacheSize);
+		std::copy(nextCache, nextCache + cacheCount, cache);
+
+		bestTriangle = -1;
+		float bestScore{ -1.0f };
+		for (size_t i{ 0 }; i < cacheCount; i++)
+		{
+			GLuint v{ cache[i] };
+			for (size_t a{ adjacencyOffset[v] }; a < adjacencyOffset[v] + remaining[v]; a++)
+			{
+				unsigned int t{ adjacency[a] };
+				if (triangleScore[t] > bestScore)
+				{
+					bestScore = triangleScore[t];
+					bestTriangle = t;
+				}
+			}
+		}
+	}
+
+	std::copy(output.begin(), output.end(), indices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex, float threshold)
+{
+	constexpr unsigned int simulatedCacheSize{ 16 };
+
+	size_t triangleCount{ indexCount / 3 };
+	if (triangleCount < 2)
+		return;
+
+	// Hard boundaries: triangles where every vertex misses, i.e. the cache optimizer
+	// started over. Reordering whole runs between them costs nothing.
+	std::vector<size_t> hardStarts;
+	std::vector<unsigned int> triangleMisses(triangleCount);
+	{
+		std::vector<size_t> loadedAt(vertexCount, 0);
+		size_t clock{ simulatedCacheSize + 1 };
+
+		for (size_t t{ 0 }; t < triangleCount; t++)
+		{
+			unsigned int misses{ 0 };
+			for (int k{ 0 }; k < 3; k++)
+			{
+				GLuint v{ indices[t * 3 + k] };
+				if (clock - loadedAt[v] > simulatedCacheSize)
+				{
+					loadedAt[v] = clock++;
+					misses++;
+				}
+			}
+
+			triangleMisses[t] = misses;
+			if (t == 0 || misses == 3)
+				hardStarts.push_back(t);
+		}
+	}
+	hardStarts.push_back(triangleCount);
+
+	// Soft boundaries: split a hard run further once the part so far, simulated from a cold
+	// cache the way it will run after reordering, is within threshold of the run's ACMR.
+	std::vector<size_t> clusterStarts;
+	std::vector<size_t> loadedAt(vertexCount, 0);
+	size_t clock{ simulatedCacheSize + 1 };
+
+	for (size_t h{ 0 }; h + 1 < hardStarts.size(); h++)
+	{
+		size_t begin{ hardStarts[h] };
+		size_t end{ hardStarts[h + 1] };
+
+		size_t runMisses{ 0 };
+		for (size_t t{ begin }; t < end; t++)
+		{
+			runMisses += triangleMisses[t];
+		}
+		float target{ threshold * float(runMisses) / float(end - begin) };
+
+		clusterStarts.push_back(begin);
+
+		size_t partMisses{ 0 };
+		size_t partStart{ begin };
+		clock += simulatedCacheSize + 1;
+
+		for (size_t t{ begin }; t + 1 < end; t++)
+		{
+			for (int k{ 0 }; k < 3; k++)
+			{
+				GLuint v{ indices[t * 3 + k] };
+				if (clock - loadedAt[v] > simulatedCacheSize)
+				{
+					loadedAt[v] = clock++;
+					partMisses++;
+				}
+			}
+
+			if (float(partMisses) / float(t + 1 - partStart) <= target)
+			{
+				clusterStarts.push_back(t + 1);
+				partStart = t + 1;
+				partMisses = 0;
+				clock += simulatedCacheSize + 1;
+			}
+		}
+	}
+	clusterStarts.push_back(triangleCount);
+
+	// Area weighted centroid of the mesh and area weighted normal / centroid per cluster.
+	size_t clusterCount{ clusterStarts.size() - 1 };
+	std::vector<Vec3> clusterCentroid(clusterCount, Vec3{ 0.0f, 0.0f, 0.0f });
+	std::vector<Vec3> clusterNormal(clusterCount, Vec3{ 0.0f, 0.0f, 0.0f });
+	Vec3 meshCentroid{ 0.0f, 0.0f, 0.0f };
+	float meshArea{ 0.0f };
+
+	for (size_t c{ 0 }; c < clusterCount; c++)
+	{
+		float clusterArea{ 0.0f };
+
+		for (size_t t{ clusterStarts[c] }; t < clusterStarts[c + 1]; t++)
+		{
+			Vec3 a{ Position(vertices, floatsPerVertex, indices[t * 3]) };
+			Vec3 b{ Position(vertices, floatsPerVertex, indices[t * 3 + 1]) };
+			Vec3 d{ Position(vertices, floatsPerVertex, indices[t * 3 + 2]) };
+
+			Vec3 e1{ b.X - a.X, b.Y - a.Y, b.Z - a.Z };
+			Vec3 e2{ d.X - a.X, d.Y - a.Y, d.Z - a.Z };
+			Vec3 n{ e1.Y * e2.Z - e1.Z * e2.Y, e1.Z * e2.X - e1.X * e2.Z, e1.X * e2.Y - e1.Y * e2.X };
+			float area{ std::sqrt(n.X * n.X + n.Y * n.Y + n.Z * n.Z) };
+
+			Vec3 center{ (a.X + b.X + d.X) / 3.0f, (a.Y + b.Y + d.Y) / 3.0f, (a.Z + b.Z + d.Z) / 3.0f };
+
+			clusterCentroid[c].X += center.X * area;
+			clusterCentroid[c].Y += center.Y * area;
+			clusterCentroid[c].Z += center.Z * area;
+			clusterNormal[c].X += n.X;
+			clusterNormal[c].Y += n.Y;
+			clusterNormal[c].Z += n.Z;
+			clusterArea += area;
+		}
+
+		meshCentroid.X += clusterCentroid[c].X;
+		meshCentroid.Y += clusterCentroid[c].Y;
+		meshCentroid.Z += clusterCentroid[c].Z;
+		meshArea += clusterArea;
+
+		if (clusterArea > 0.0f)
+		{
+			clusterCentroid[c].X /= clusterArea;
+			clusterCentroid[c].Y /= clusterArea;
+			clusterCentroid[c].Z /= clusterArea;
+		}
+	}
+
+	if (meshArea > 0.0f)
+	{
+		meshCentroid.X /= meshArea;
+		meshCentroid.Y /= meshArea;
+		meshCentroid.Z /= meshArea;
+	}
+
+	// Clusters facing away from the middle of the mesh are the likely occluders, so draw them first.
+	std::vector<float> sortKey(clusterCount);
+	for (size_t c{ 0 }; c < clusterCount; c++)
+	{
+		Vec3 n{ clusterNormal[c] };
+		float length{ std::sqrt(n.X * n.X + n.Y * n.Y + n.Z * n.Z) };
+		if (length > 0.0f)
+		{
+			n.X /= length;
+			n.Y /= length;
+			n.Z /= length;
+		}
+
+		sortKey[c] = (clusterCentroid[c].X - meshCentroid.X) * n.X
+			+ (clusterCentroid[c].Y - meshCentroid.Y) * n.Y
+			+ (clusterCentroid[c].Z - meshCentroid.Z) * n.Z;
+	}
+
+	std::vector<size_t> order(clusterCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sortKey](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+	std::vector<GLuint> output;
+	output.reserve(triangleCount * 3);
+	for (size_t c : order)
+	{
+		output.insert(output.end(), indices + clusterStarts[c] * 3, indices + clusterStarts[c + 1] * 3);
+	}
+
+	std::copy(output.begin(), output.end(), indices);
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(std::vector<GLfloat>& vertices, GLuint* indices, size_t indexCount, size_t floatsPerVertex)
+{
+	size_t vertexCount{ vertices.size() / floatsPerVertex };
+
+	constexpr GLuint unused{ ~GLuint(0) };
+	std::vector<GLuint> remap(vertexCount, unused);
+	std::vector<GLfloat> reordered;
+	reordered.reserve(vertices.size());
+
+	GLuint next{ 0 };
+	for (size_t i{ 0 }; i < indexCount; i++)
+	{
+		GLuint& mapped{ remap[indices[i]] };
+		if (mapped == unused)
+		{
+			mapped = next++;
+			reordered.insert(reordered.end(), vertices.begin() + indices[i] * floatsPerVertex, vertices.begin() + (indices[i] + 1) * floatsPerVertex);
+		}
+
+		indices[i] = mapped;
+	}
+
+	vertices.swap(reordered);
+	return next;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <vector>
+
+// Bake time reordering of indexed triangle lists.
+//
+// The usual order is OptimizeVertexCache, then optionally OptimizeOverdraw, then
+// OptimizeVertexFetch last since it renumbers the vertices the other two refer to.
+namespace MeshOptimizer
+{
+	// Result of running an index list through a simulated FIFO post-transform cache.
+	struct CacheStats
+	{
+		size_t Misses{ 0 };
+		size_t Triangles{ 0 };
+		size_t Vertices{ 0 };
+
+		// Average cache miss ratio: transformed vertices per triangle (0.5 best, 3.0 worst).
+		float ACMR() const { return Triangles ? float(Misses) / float(Triangles) : 0.0f; }
+		// Average transform to vertex ratio: transformed vertices per referenced vertex (1.0 best).
+		float ATVR() const { return Vertices ? float(Misses) / float(Vertices) : 0.0f; }
+	};
+
+	CacheStats SimulateVertexCache(const GLuint* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize = 16);
+
+	// Forsyth's linear speed vertex cache optimization, in place.
+	void OptimizeVertexCache(GLuint* indices, size_t indexCount, size_t vertexCount);
+
+	// Splits the cache optimized list into clusters and draws the outward facing ones first.
+	// threshold bounds how much ACMR may grow from the extra cluster boundaries (1.05 = 5%).
+	void OptimizeOverdraw(GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex, float threshold = 1.05f);
+
+	// Renumbers vertices in first use order and drops unreferenced ones.
+	// Returns the new vertex count; vertices is rewritten in place.
+	size_t OptimizeVertexFetch(std::vector<GLfloat>& vertices, GLuint* indices, size_t indexCount, size_t floatsPerVertex);
+}
@@ -0,0 +1,418 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <unordered_map>
+
+namespace
+{
+	struct Vec3
+	{
+		double X, Y, Z;
+
+		Vec3 operator-(const Vec3& o) const { return { X - o.X, Y - o.Y, Z - o.Z }; }
+		double Dot(const Vec3& o) const { return X * o.X + Y * o.Y + Z * o.Z; }
+		Vec3 Cross(const Vec3& o) const { return { Y * o.Z - Z * o.Y, Z * o.X - X * o.Z, X * o.Y - Y * o.X }; }
+		double Length() const { return std::sqrt(Dot(*this)); }
+	};
+
+	// Symmetric 4x4 plane quadric plus the total weight it was built from, so CombinedError is a
+	// weighted mean squared distance instead of growing with the number of planes.
+	struct Quadric
+	{
+		double A00{ 0 }, A01{ 0 }, A02{ 0 }, A11{ 0 }, A12{ 0 }, A22{ 0 };
+		double B0{ 0 }, B1{ 0 }, B2{ 0 };
+		double C{ 0 };
+		double Weight{ 0 };
+
+		void AddPlane(const Vec3& n, double d, double weight)
+		{
+			A00 += weight * n.X * n.X; A01 += weight * n.X * n.Y; A02 += weight * n.X * n.Z;
+			A11 += weight * n.Y * n.Y; A12 += weight * n.Y * n.Z; A22 += weight * n.Z * n.Z;
+			B0 += weight * n.X * d; B1 += weight * n.Y * d; B2 += weight * n.Z * d;
+			C += weight * d * d;
+			Weight += weight;
+		}
+
+		void Add(const Quadric& q)
+		{
+			A00 += q.A00; A01 += q.A01; A02 += q.A02; A11 += q.A11; A12 += q.A12; A22 += q.A22;
+			B0 += q.B0; B1 += q.B1; B2 += q.B2;
+			C += q.C;
+			Weight += q.Weight;
+		}
+
+		double Evaluate(const Vec3& v) const
+		{
+			double rx{ A00 * v.X + A01 * v.Y + A02 * v.Z };
+			double ry{ A01 * v.X + A11 * v.Y + A12 * v.Z };
+			double rz{ A02 * v.X + A12 * v.Y + A22 * v.Z };
+
+			return v.X * rx + v.Y * ry + v.Z * rz + 2.0 * (v.X * B0 + v.Y * B1 + v.Z * B2) + C;
+		}
+	};
+
+	double CombinedError(const Quadric& a, const Quadric& b, const Vec3& v)
+	{
+		double weight{ a.Weight + b.Weight };
+		if (weight <= 0.0)
+			return 0.0;
+
+		return std::max(0.0, (a.Evaluate(v) + b.Evaluate(v)) / weight);
+	}
+
+	// Border edges get a plane through the edge, perpendicular to the triangle, so open
+	// boundaries do not shrink.
+	constexpr double borderWeight{ 10.0 };
+
+	struct Collapse
+	{
+		GLuint From;
+		GLuint To;
+		double Cost;
+	};
+
+	uint64_t EdgeKey(GLuint a, GLuint b)
+	{
+		return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+	}
+}
+
+float MeshSimplifier::Simplify(std::vector<GLuint>& destination, const GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex,
+	size_t targetIndexCount, float attributeWeight)
+{
+	destination.assign(indices, indices + indexCount);
+	if (indexCount <= targetIndexCount || vertexCount == 0)
+		return 0.0f;
+
+	auto position = [&](GLuint v) -> Vec3
+	{
+		const GLfloat* p{ vertices + v * floatsPerVertex };
+		return { p[0], p[1], p[2] };
+	};
+
+	// Vertices sharing a position become one node of the collapse topology. wedgeStart /
+	// wedges lists the vertices (attribute variants) of each node.
+	std::vector<GLuint> node(vertexCount);
+	std::vector<GLuint> nodeVertex;
+	{
+		std::unordered_map<uint64_t, std::vector<GLuint>> buckets;
+		buckets.reserve(vertexCount);
+
+		for (GLuint v{ 0 }; v < vertexCount; v++)
+		{
+			const GLfloat* p{ vertices + v * floatsPerVertex };
+			uint32_t bits[3];
+			std::memcpy(bits, p, sizeof(bits));
+			uint64_t hash{ (uint64_t(bits[0]) * 73856093u) ^ (uint64_t(bits[1]) * 19349663u) ^ (uint64_t(bits[2]) * 83492791u) };
+
+			std::vector<GLuint>& bucket{ buckets[hash] };
+			GLuint found{ ~GLuint(0) };
+			for (GLuint n : bucket)
+			{
+				if (std::memcmp(vertices + nodeVertex[n] * floatsPerVertex, p, 3 * sizeof(GLfloat)) == 0)
+				{
+					found = n;
+					break;
+				}
+			}
+
+			if (found == ~GLuint(0))
+			{
+				found = (GLuint)nodeVertex.size();
+				nodeVertex.push_back(v);
+				bucket.push_back(found);
+			}
+
+			node[v] = found;
+		}
+	}
+
+	size_t nodeCount{ nodeVertex.size() };
+
+	std::vector<size_t> wedgeStart(nodeCount + 1, 0);
+	for (GLuint v{ 0 }; v < vertexCount; v++)
+	{
+		wedgeStart[node[v] + 1]++;
+	}
+	for (size_t n{ 0 }; n < nodeCount; n++)
+	{
+		wedgeStart[n + 1] += wedgeStart[n];
+	}
+	std::vector<GLuint> wedges(vertexCount);
+	{
+		std::vector<size_t> fill(wedgeStart.begin(), wedgeStart.end() - 1);
+		for (GLuint v{ 0 }; v < vertexCount; v++)
+		{
+			wedges[fill[node[v]]++] = v;
+		}
+	}
+
+	Vec3 boundsMin{ position(0) };
+	Vec3 boundsMax{ boundsMin };
+	for (GLuint v{ 1 }; v < vertexCount; v++)
+	{
+		Vec3 p{ position(v) };
+		boundsMin = { std::min(boundsMin.X, p.X), std::min(boundsMin.Y, p.Y), std::min(boundsMin.Z, p.Z) };
+		boundsMax = { std::max(boundsMax.X, p.X), std::max(boundsMax.Y, p.Y), std::max(boundsMax.Z, p.Z) };
+	}
+	double extent{ (boundsMax - boundsMin).Length() };
+	double attributeScale{ attributeWeight * extent * attributeWeight * extent * 0.5 };
+
+	// Squared normal difference plus squared texture coordinate difference, normalized so a
+	// 90 degree normal change alone is 2 * attributeScale.
+	auto attributeDistance = [&](GLuint a, GLuint b) -> double
+	{
+		const GLfloat* va{ vertices + a * floatsPerVertex };
+		const GLfloat* vb{ vertices + b * floatsPerVertex };
+
+		double distance{ 0.0 };
+		for (int i{ 3 }; i < 8; i++)
+		{
+			double d{ double(va[i]) - double(vb[i]) };
+			distance += d * d;
+		}
+
+		return distance * attributeScale;
+	};
+
+	std::vector<Quadric> quadrics(nodeCount);
+	{
+		std::unordered_map<uint64_t, int> edgeUse;
+		edgeUse.reserve(indexCount);
+
+		for (size_t i{ 0 }; i + 2 < indexCount; i += 3)
+		{
+			Vec3 a{ position(indices[i]) };
+			Vec3 b{ position(indices[i + 1]) };
+			Vec3 c{ position(indices[i + 2]) };
+
+			Vec3 n{ (b - a).Cross(c - a) };
+			double area{ n.Length() };
+			if (area <= 0.0)
+				continue;
+
+			n = { n.X / area, n.Y / area, n.Z / area };
+			double d{ -n.Dot(a) };
+
+			for (int k{ 0 }; k < 3; k++)
+			{
+				quadrics[node[indices[i + k]]].AddPlane(n, d, area);
+				edgeUse[EdgeKey(node[indices[i + k]], node[indices[i + (k + 1) % 3]])]++;
+			}
+		}
+
+		for (size_t i{ 0 }; i + 2 < indexCount; i += 3)
+		{
+			for (int k{ 0 }; k < 3; k++)
+			{
+				GLuint a{ indices[i + k] };
+				GLuint b{ indices[i + (k + 1) % 3] };
+				if (edgeUse[EdgeKey(node[a], node[b])] != 1)
+					continue;
+
+				Vec3 pa{ position(a) };
+				Vec3 pb{ position(b) };
+				Vec3 pc{ position(indices[i + (k + 2) % 3]) };
+
+				Vec3 edge{ pb - pa };
+				Vec3 n{ (pb - pa).Cross(pc - pa).Cross(edge) };
+				double length{ n.Length() };
+				if (length <= 0.0)
+					continue;
+
+				n = { n.X / length, n.Y / length, n.Z / length };
+				double weight{ borderWeight * edge.Length() * edge.Length() };
+
+				quadrics[node[a]].AddPlane(n, -n.Dot(pa), weight);
+				quadrics[node[b]].AddPlane(n, -n.Dot(pa), weight);
+			}
+		}
+	}
+
+	double maxError{ 0.0 };
+
+	std::vector<GLuint> remap(vertexCount);
+	std::vector<bool> locked(nodeCount);
+	std::vector<size_t> adjacencyStart(nodeCount + 1);
+	std::vector<size_t> adjacency;
+	std::vector<uint64_t> edges;
+	std::vector<Collapse> collapses;
+
+	while (destination.size() > targetIndexCount)
+	{
+		size_t triangleCount{ destination.size() / 3 };
+
+		// Triangles around each node for the flip test.
+		std::fill(adjacencyStart.begin(), adjacencyStart.end(), 0);
+		for (GLuint v : destination)
+		{
+			adjacencyStart[node[v] + 1]++;
+		}
+		for (size_t n{ 0 }; n < nodeCount; n++)
+		{
+			adjacencyStart[n + 1] += adjacencyStart[n];
+		}
+		adjacency.resize(destination.size());
+		{
+			std::vector<size_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+			for (size_t i{ 0 }; i < destination.size(); i++)
+			{
+				adjacency[fill[node[destination[i]]]++] = i / 3;
+			}
+		}
+
+		edges.clear();
+		for (size_t i{ 0 }; i < destination.size(); i++)
+		{
+			GLuint a{ node[destination[i]] };
+			GLuint b{ node[destination[i - i % 3 + (i + 1) % 3]] };
+			if (a != b)
+				edges.push_back(EdgeKey(a, b));
+		}
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		// Cheapest direction of every edge.
+		collapses.clear();
+		for (uint64_t edge : edges)
+		{
+			GLuint a{ GLuint(edge >> 32) };
+			GLuint b{ GLuint(edge & 0xFFFFFFFFu) };
+
+			Collapse best{ a, b, -1.0 };
+			for (int direction{ 0 }; direction < 2; direction++)
+			{
+				GLuint from{ direction ? b : a };
+				GLuint to{ direction ? a : b };
+
+				double cost{ CombinedError(quadrics[from], quadrics[to], position(nodeVertex[to])) };
+
+				// Each attribute variant of "from" moves to its closest variant of "to".
+				double attributeCost{ 0.0 };
+				for (size_t w{ wedgeStart[from] }; w < wedgeStart[from + 1]; w++)
+				{
+					double closest{ HUGE_VAL };
+					for (size_t x{ wedgeStart[to] }; x < wedgeStart[to + 1]; x++)
+					{
+						closest = std::min(closest, attributeDistance(wedges[w], wedges[x]));
+					}
+					attributeCost = std::max(attributeCost, closest);
+				}
+				cost += attributeCost;
+
+				if (best.Cost < 0.0 || cost < best.Cost)
+					best = { from, to, cost };
+			}
+
+			collapses.push_back(best);
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+		for (GLuint v{ 0 }; v < vertexCount; v++)
+		{
+			remap[v] = v;
+		}
+		std::fill(locked.begin(), locked.end(), false);
+
+		// Every collapse removes about two triangles.
+		size_t wanted{ (destination.size() - targetIndexCount) / 6 + 1 };
+		size_t done{ 0 };
+
+		for (const Collapse& collapse : collapses)
+		{
+			if (done >= wanted)
+				break;
+			if (locked[collapse.From] || locked[collapse.To])
+				continue;
+
+			// Reject the collapse if a surviving triangle around "from" would flip.
+			Vec3 target{ position(nodeVertex[collapse.To]) };
+			bool flips{ false };
+
+			for (size_t a{ adjacencyStart[collapse.From] }; a < adjacencyStart[collapse.From + 1] && !flips; a++)
+			{
+				const GLuint* triangle{ destination.data() + adjacency[a] * 3 };
+				Vec3 corners[3];
+				Vec3 moved[3];
+				bool survives{ true };
+
+				for (int k{ 0 }; k < 3; k++)
+				{
+					GLuint n{ node[triangle[k]] };
+					if (n == collapse.To)
+						survives = false;
+
+					corners[k] = position(triangle[k]);
+					moved[k] = n == collapse.From ? target : corners[k];
+				}
+
+				if (!survives)
+					continue;
+
+				Vec3 before{ (corners[1] - corners[0]).Cross(corners[2] - corners[0]) };
+				Vec3 after{ (moved[1] - moved[0]).Cross(moved[2] - moved[0]) };
+				flips = before.Dot(after) <= 0.0;
+			}
+
+			if (flips)
+				continue;
+
+			for (size_t w{ wedgeStart[collapse.From] }; w < wedgeStart[collapse.From + 1]; w++)
+			{
+				GLuint closestVertex{ wedges[wedgeStart[collapse.To]] };
+				double closest{ HUGE_VAL };
+				for (size_t x{ wedgeStart[collapse.To] }; x < wedgeStart[collapse.To + 1]; x++)
+				{
+					double distance{ attributeDistance(wedges[w], wedges[x]) };
+					if (distance < closest)
+					{
+						closest = distance;
+						closestVertex = wedges[x];
+					}
+				}
+				remap[wedges[w]] = closestVertex;
+			}
+
+			quadrics[collapse.To].Add(quadrics[collapse.From]);
+			maxError = std::max(maxError, collapse.Cost);
+
+			// The neighbourhood of "from" changed, so nothing touching it may collapse again this pass.
+			locked[collapse.From] = true;
+			locked[collapse.To] = true;
+			for (size_t a{ adjacencyStart[collapse.From] }; a < adjacencyStart[collapse.From + 1]; a++)
+			{
+				for (int k{ 0 }; k < 3; k++)
+				{
+					locked[node[destination[adjacency[a] * 3 + k]]] = true;
+				}
+			}
+
+			done++;
+		}
+
+		if (done == 0)
+			break;
+
+		size_t write{ 0 };
+		for (size_t t{ 0 }; t < triangleCount; t++)
+		{
+			GLuint a{ remap[destination[t * 3]] };
+			GLuint b{ remap[destination[t * 3 + 1]] };
+			GLuint c{ remap[destination[t * 3 + 2]] };
+
+			if (node[a] == node[b] || node[b] == node[c] || node[a] == node[c])
+				continue;
+
+			destination[write++] = a;
+			destination[write++] = b;
+			destination[write++] = c;
+		}
+		destination.resize(write);
+	}
+
+	return (float)std::sqrt(maxError);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <vector>
+
+// Quadric error simplification for building LOD chains at bake time.
+//
+// Vertices use the MeshCache layout: position(3) / texture coordinate(2) / normal(3), and
+// the simplifier only reads them. Vertices that share a position (flat shading, UV seams)
+// collapse together, and each corner moves to the closest matching vertex at the target
+// position, so the result indexes the same vertex buffer as the input.
+namespace MeshSimplifier
+{
+	// Scales normal / texture coordinate mismatch against geometric error. A 90 degree normal
+	// change costs about as much as moving attributeWeight * mesh size away from the surface.
+	constexpr float DefaultAttributeWeight{ 0.05f };
+
+	// Collapses edges, cheapest first, until the list has at most targetIndexCount indices or
+	// nothing can collapse without flipping a triangle. Returns the largest collapse error as
+	// a distance in model units.
+	float Simplify(std::vector<GLuint>& destination, const GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex,
+		size_t targetIndexCount, float attributeWeight = DefaultAttributeWeight);
+}
@@ -0,0 +1,479 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace
+{
+	constexpr size_t fallbackWindow{ 256 };
+
+	glm::vec3 Position(const GLfloat* vertices, size_t floatsPerVertex, GLuint index)
+	{
+		const GLfloat* p{ vertices + index * floatsPerVertex };
+		return glm::vec3(p[0], p[1], p[2]);
+	}
+
+	void Store(float (&dst)[3], const glm::vec3& v)
+	{
+		dst[0] = v.x;
+		dst[1] = v.y;
+		dst[2] = v.z;
+	}
+
+	glm::vec3 Load(const float (&src)[3])
+	{
+		return glm::vec3(src[0], src[1], src[2]);
+	}
+
+	// Ritter's bounding sphere: start from the widest of the axis extreme pairs, then grow.
+	void BoundingSphere(const std::vector<glm::vec3>& points, glm::vec3& center, float& radius)
+	{
+		size_t minIndex[3]{ 0, 0, 0 };
+		size_t maxIndex[3]{ 0, 0, 0 };
+		for (size_t i{ 1 }; i < points.size(); i++)
+		{
+			for (int axis{ 0 }; axis < 3; axis++)
+			{
+				if (points[i][axis] < points[minIndex[axis]][axis]) minIndex[axis] = i;
+				if (points[i][axis] > points[maxIndex[axis]][axis]) maxIndex[axis] = i;
+			}
+		}
+
+		int widest{ 0 };
+		for (int axis{ 1 }; axis < 3; axis++)
+		{
+			if (glm::distance(points[minIndex[axis]], points[maxIndex[axis]]) > glm::distance(points[minIndex[widest]], points[maxIndex[widest]]))
+				widest = axis;
+		}
+
+		center = (points[minIndex[widest]] + points[maxIndex[widest]]) * 0.5f;
+		radius = glm::distance(points[minIndex[widest]], points[maxIndex[widest]]) * 0.5f;
+
+		for (const glm::vec3& p : points)
+		{
+			float d{ glm::distance(p, center) };
+			if (d > radius)
+			{
+				float grown{ (radius + d) * 0.5f };
+				center += (p - center) * ((grown - radius) / d);
+				radius = grown;
+			}
+		}
+	}
+
+	void ComputeBounds(MeshletBuilder::Meshlet& meshlet, const GLuint* indices, const GLfloat* vertices, size_t floatsPerVertex)
+	{
+		std::vector<glm::vec3> points;
+		points.reserve(meshlet.TriangleCount * 3);
+		for (uint32_t i{ 0 }; i < meshlet.TriangleCount * 3; i++)
+		{
+			points.push_back(Position(vertices, floatsPerVertex, indices[meshlet.IndexOffset + i]));
+		}
+
+		glm::vec3 boundsMin{ points[0] };
+		glm::vec3 boundsMax{ points[0] };
+		for (const glm::vec3& p : points)
+		{
+			boundsMin = glm::min(boundsMin, p);
+			boundsMax = glm::max(boundsMax, p);
+		}
+		Store(meshlet.BoundsMin, boundsMin);
+		Store(meshlet.BoundsMax, boundsMax);
+
+		glm::vec3 center;
+		float radius;
+		BoundingSphere(points, center, radius);
+		Store(meshlet.Center, center);
+		meshlet.Radius = radius;
+
+		// Normal cone: average the unit face normals, then widen it to the furthest one.
+		std::vector<glm::vec3> normals;
+		normals.reserve(meshlet.TriangleCount);
+		glm::vec3 axis{ 0.0f };
+		for (uint32_t t{ 0 }; t < meshlet.TriangleCount; t++)
+		{
+			glm::vec3 n{ glm::cross(points[t * 3 + 1] - points[t * 3], points[t * 3 + 2] - points[t * 3]) };
+			float length{ glm::length(n) };
+			if (length <= 0.0f)
+				continue;
+
+			normals.push_back(n / length);
+			axis += n / length;
+		}
+
+		Store(meshlet.ConeApex, center);
+		Store(meshlet.ConeAxis, glm::vec3(0.0f, 0.0f, 1.0f));
+		meshlet.ConeCutoff = 1.0f;
+
+		float axisLength{ glm::length(axis) };
+		if (normals.empty() || axisLength <= 0.0f)
+			return;
+		axis /= axisLength;
+
+		float minDot{ 1.0f };
+		for (const glm::vec3& n : normals)
+		{
+			minDot = std::min(minDot, glm::dot(axis, n));
+		}
+
+		// Normals spread over (nearly) a half sphere: there is no viewpoint culling all of them.
+		if (minDot <= 0.1f)
+			return;
+
+		// Move the apex back along the axis until it is behind every triangle plane, where
+		// dot(apex - p, n) <= 0 for a point p and normal n of each.
+		float maxT{ 0.0f };
+		for (uint32_t t{ 0 }, n{ 0 }; t < meshlet.TriangleCount; t++)
+		{
+			glm::vec3 normal{ glm::cross(points[t * 3 + 1] - points[t * 3], points[t * 3 + 2] - points[t * 3]) };
+			if (glm::length(normal) <= 0.0f)
+				continue;
+
+			maxT = std::max(maxT, glm::dot(center - points[t * 3], normals[n]) / glm::dot(axis, normals[n]));
+			n++;
+		}
+
+		Store(meshlet.ConeApex, center - axis * maxT);
+		Store(meshlet.ConeAxis, axis);
+		meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+
+std::vector<MeshletBuilder::Meshlet> MeshletBuilder::Build(GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex,
+	size_t maxVertices, size_t maxTriangles)
+{
+	std::vector<Meshlet> meshlets;
+
+	size_t triangleCount{ indexCount / 3 };
+	if (triangleCount == 0)
+		return meshlets;
+
+	std::vector<size_t> adjacencyStart(vertexCount + 1, 0);
+	for (size_t i{ 0 }; i < triangleCount * 3; i++)
+	{
+		adjacencyStart[indices[i] + 1]++;
+	}
+	for (size_t v{ 0 }; v < vertexCount; v++)
+	{
+		adjacencyStart[v + 1] += adjacencyStart[v];
+	}
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<size_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+		for (size_t i{ 0 }; i < triangleCount * 3; i++)
+		{
+			adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
+		}
+	}
+
+	std::vector<bool> used(triangleCount, false);
+	// Id + 1 of the meshlet that last took each vertex, so membership is a compare.
+	std::vector<uint32_t> vertexOwner(vertexCount, 0);
+	std::vector<uint32_t> candidates;
+	std::vector<GLuint> output;
+	output.reserve(triangleCount * 3);
+
+	size_t seedCursor{ 0 };
+
+	while (output.size() < triangleCount * 3)
+	{
+		while (used[seedCursor])
+			seedCursor++;
+
+		uint32_t owner{ (uint32_t)meshlets.size() + 1 };
+		Meshlet meshlet{};
+		meshlet.IndexOffset = (uint32_t)output.size();
+
+		glm::vec3 centroidSum{ 0.0f };
+		glm::vec3 boundsMin{ Position(vertices, floatsPerVertex, indices[seedCursor * 3]) };
+		glm::vec3 boundsMax{ boundsMin };
+		candidates.clear();
+
+		uint32_t next{ (uint32_t)seedCursor };
+		for (;;)
+		{
+			used[next] = true;
+			output.insert(output.end(), indices + next * 3, indices + next * 3 + 3);
+			meshlet.TriangleCount++;
+
+			for (int k{ 0 }; k < 3; k++)
+			{
+				GLuint v{ indices[next * 3 + k] };
+				glm::vec3 p{ Position(vertices, floatsPerVertex, v) };
+				centroidSum += p;
+				boundsMin = glm::min(boundsMin, p);
+				boundsMax = glm::max(boundsMax, p);
+
+				if (vertexOwner[v] != owner)
+				{
+					vertexOwner[v] = owner;
+					meshlet.VertexCount++;
+
+					for (size_t a{ adjacencyStart[v] }; a < adjacencyStart[v + 1]; a++)
+					{
+						if (!used[adjacency[a]])
+							candidates.push_back(adjacency[a]);
+					}
+				}
+			}
+
+			if (meshlet.TriangleCount >= maxTriangles)
+				break;
+
+			// Prefer triangles that add the fewest vertices, then the ones closest to the middle.
+			glm::vec3 centroid{ centroidSum / float(meshlet.TriangleCount * 3) };
+			uint32_t best{ ~0u };
+			int bestNew{ 4 };
+			float bestDistance{ 0.0f };
+
+			size_t write{ 0 };
+			for (size_t c{ 0 }; c < candidates.size(); c++)
+			{
+				uint32_t t{ candidates[c] };
+				if (used[t])
+					continue;
+				candidates[write++] = t;
+
+				int added{ 0 };
+				for (int k{ 0 }; k < 3; k++)
+				{
+					added += vertexOwner[indices[t * 3 + k]] != owner;
+				}
+				if (meshlet.VertexCount + added > maxVertices || added > bestNew)
+					continue;
+
+				glm::vec3 center{ (Position(vertices, floatsPerVertex, indices[t * 3]) + Position(vertices, floatsPerVertex, indices[t * 3 + 1])
+					+ Position(vertices, floatsPerVertex, indices[t * 3 + 2])) / 3.0f };
+				float distance{ glm::distance(center, centroid) };
+
+				if (added < bestNew || distance < bestDistance)
+				{
+					best = t;
+					bestNew = added;
+					bestDistance = distance;
+				}
+			}
+			candidates.resize(write);
+
+			// Nothing connected fits (flat shaded faces share no vertices): look a little way
+			// ahead in input order for a nearby loose triangle instead of closing the meshlet.
+			if (best == ~0u)
+			{
+				float reach{ glm::length(boundsMax - boundsMin) };
+				size_t scanned{ 0 };
+
+				for (size_t t{ seedCursor }; t < triangleCount && scanned < fallbackWindow; t++)
+				{
+					if (used[t])
+						continue;
+					scanned++;
+
+					int added{ 0 };
+					for (int k{ 0 }; k < 3; k++)
+					{
+						added += vertexOwner[indices[t * 3 + k]] != owner;
+					}
+					if (meshlet.VertexCount + added > maxVertices)
+						continue;
+
+					glm::vec3 center{ (Position(vertices, floatsPerVertex, indices[t * 3]) + Position(vertices, floatsPerVertex, indices[t * 3 + 1])
+						+ Position(vertices, floatsPerVertex, indices[t * 3 + 2])) / 3.0f };
+					float distance{ glm::distance(center, centroid) };
+
+					if (distance <= reach && (best == ~0u || distance < bestDistance))
+					{
+						best = (uint32_t)t;
+						bestDistance = distance;
+					}
+				}
+			}
+
+			if (best == ~0u)
+				break;
+
+			next = best;
+		}
+
+		ComputeBounds(meshlet, output.data(), vertices, floatsPerVertex);
+		meshlets.push_back(meshlet);
+	}
+
+	std::copy(output.begin(), output.end(), indices);
+	return meshlets;
+}
+
+void MeshletBuilder::ExtractFrustum(const glm::mat4& clip, glm::vec4 planes[6])
+{
+	glm::vec4 rows[4];
+	for (int i{ 0 }; i < 4; i++)
+	{
+		rows[i] = glm::vec4(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+	}
+
+	planes[0] = rows[3] + rows[0];
+	planes[1] = rows[3] - rows[0];
+	planes[2] = rows[3] + rows[1];
+	planes[3] = rows[3] - rows[1];
+	planes[4] = rows[3] + rows[2];
+	planes[5] = rows[3] - rows[2];
+
+	for (int i{ 0 }; i < 6; i++)
+	{
+		planes[i] /= glm::length(glm::vec3(planes[i]));
+	}
+}
+
+bool MeshletBuilder::ConeCulled(const Meshlet& meshlet, const glm::vec3& viewer)
+{
+	if (meshlet.ConeCutoff >= 1.0f)
+		return false;
+
+	glm::vec3 toApex{ Load(meshlet.ConeApex) - viewer };
+	float length{ glm::length(toApex) };
+
+	return length > 0.0f && glm::dot(toApex, Load(meshlet.ConeAxis)) >= meshlet.ConeCutoff * length;
+}
+
+bool MeshletBuilder::FrustumCulled(const Meshlet& meshlet, const glm::vec4 planes[6])
+{
+	glm::vec3 center{ Load(meshlet.Center) };
+
+	for (int i{ 0 }; i < 6; i++)
+	{
+		if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -meshlet.Radius)
+			return true;
+	}
+
+	return false;
+}
+
+void MeshletBuilder::Cull(const std::vector<Meshlet>& meshlets, uint32_t baseIndex, const glm::vec3& viewer, const glm::vec4 planes[6],
+	std::vector<std::pair<uint32_t, uint32_t>>& ranges, CullStats& stats)
+{
+	size_t firstNewRange{ ranges.size() };
+
+	for (const Meshlet& meshlet : meshlets)
+	{
+		stats.Meshlets++;
+		stats.Triangles += meshlet.TriangleCount;
+
+		if (FrustumCulled(meshlet, planes))
+		{
+			stats.FrustumRejected += meshlet.TriangleCount;
+			continue;
+		}
+		if (ConeCulled(meshlet, viewer))
+		{
+			stats.ConeRejected += meshlet.TriangleCount;
+			continue;
+		}
+
+		uint32_t first{ baseIndex + meshlet.IndexOffset };
+		if (ranges.size() > firstNewRange && ranges.back().first + ranges.back().second == first)
+			ranges.back().second += meshlet.TriangleCount * 3;
+		else
+			ranges.emplace_back(first, meshlet.TriangleCount * 3);
+	}
+
+	stats.Draws += ranges.size() - firstNewRange;
+}
+
+void MeshletBuilder::PrintCullingReport(const char* name, const std::vector<Meshlet>& meshlets)
+{
+	if (meshlets.empty())
+		return;
+
+	glm::vec3 boundsMin{ Load(meshlets[0].BoundsMin) };
+	glm::vec3 boundsMax{ Load(meshlets[0].BoundsMax) };
+	for (const Meshlet& meshlet : meshlets)
+	{
+		boundsMin = glm::min(boundsMin, Load(meshlet.BoundsMin));
+		boundsMax = glm::max(boundsMax, Load(meshlet.BoundsMax));
+	}
+	glm::vec3 center{ (boundsMin + boundsMax) * 0.5f };
+	float radius{ std::max(glm::length(boundsMax - boundsMin) * 0.5f, 0.001f) };
+
+	glm::mat4 projection{ glm::perspective(glm::radians(45.0f), 1.0f, radius * 0.01f, radius * 100.0f) };
+	constexpr int steps{ 32 };
+
+	auto runPath = [&](const char* pathName, auto cameraAt)
+	{
+		CullStats stats;
+		std::vector<std::pair<uint32_t, uint32_t>> ranges;
+		glm::vec4 planes[6];
+
+		for (int i{ 0 }; i < steps; i++)
+		{
+			glm::vec3 eye;
+			glm::vec3 target;
+			cameraAt(float(i) / float(steps), eye, target);
+
+			ExtractFrustum(projection * glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f)), planes);
+			ranges.clear();
+			Cull(meshlets, 0, eye, planes, ranges, stats);
+		}
+
+		std::cout << "  " << std::left << std::setw(8) << pathName << std::right << std::fixed << std::setprecision(1)
+			<< " cone " << std::setw(5) << 100.0f * stats.ConeRejected / stats.Triangles << "%"
+			<< "  frustum " << std::setw(5) << 100.0f * stats.FrustumRejected / stats.Triangles << "%"
+			<< "  total " << std::setw(5) << stats.RejectedPercent() << "%"
+			<< "  draws/frame " << float(stats.Draws) / steps << "\n";
+	};
+
+	std::streamsize precision{ std::cout.precision() };
+
+	std::cout << "- " << name << ": " << meshlets.size() << " meshlets, culling over " << steps << " frames\n";
+
+	// Orbit at three times the bounding radius, looking at the middle.
+	runPath("orbit", [&](float t, glm::vec3& eye, glm::vec3& target)
+	{
+		float angle{ t * 6.2831853f };
+		eye = center + glm::vec3(std::cos(angle), 0.35f, std::sin(angle)) * radius * 3.0f;
+		target = center;
+	});
+
+	// Walk past the model close up, looking along the walk direction.
+	runPath("fly-by", [&](float t, glm::vec3& eye, glm::vec3& target)
+	{
+		eye = center + glm::vec3(-2.0f + 4.0f * t, 0.2f, 1.2f) * radius;
+		target = eye + glm::vec3(0.7f, 0.0f, -0.7f);
+	});
+
+	// A bowl faces a viewer inside it with every triangle, so none of its meshlets may be
+	// cone culled from there.
+	constexpr int bowlSide{ 6 };
+	std::vector<GLfloat> bowlVertices;
+	std::vector<GLuint> bowlIndices;
+	for (int y{ 0 }; y <= bowlSide; y++)
+	{
+		for (int x{ 0 }; x <= bowlSide; x++)
+		{
+			float u{ float(x) / bowlSide * 2.0f - 1.0f };
+			float v{ float(y) / bowlSide * 2.0f - 1.0f };
+			bowlVertices.insert(bowlVertices.end(), { u, v, u * u + v * v });
+		}
+	}
+	for (GLuint y{ 0 }; y < bowlSide; y++)
+	{
+		for (GLuint x{ 0 }; x < bowlSide; x++)
+		{
+			GLuint corner{ y * (bowlSide + 1) + x };
+			bowlIndices.insert(bowlIndices.end(), { corner, corner + 1, corner + bowlSide + 1, corner + 1, corner + bowlSide + 2, corner + bowlSide + 1 });
+		}
+	}
+
+	std::vector<Meshlet> bowl{ Build(bowlIndices.data(), bowlIndices.size(), bowlVertices.data(), bowlVertices.size() / 3, 3) };
+	size_t bowlCulled{ 0 };
+	for (const Meshlet& meshlet : bowl)
+	{
+		if (ConeCulled(meshlet, glm::vec3(0.0f, 0.0f, 0.2f)))
+			bowlCulled++;
+	}
+	std::cout << "  concave  " << (bowlCulled == 0 ? "ok" : "FAILED") << ", " << bowlCulled << "/" << bowl.size() << " meshlets of a bowl culled from inside\n";
+
+	std::cout << std::defaultfloat << std::setprecision(precision);
+}
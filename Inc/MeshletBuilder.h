@@ -0,0 +1,66 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Splits an index list into small clusters with bounds for culling below object level.
+//
+// Each meshlet is a contiguous range of the reordered index list, so a visible run of
+// meshlets is one glDrawElements call. All bounds are in the space of the vertex data.
+namespace MeshletBuilder
+{
+	constexpr size_t MaxVertices{ 64 };
+	constexpr size_t MaxTriangles{ 124 };
+
+	struct Meshlet
+	{
+		uint32_t IndexOffset;
+		uint32_t TriangleCount;
+		uint32_t VertexCount;
+
+		float Center[3];
+		float Radius;
+		float BoundsMin[3];
+		float BoundsMax[3];
+
+		// Every triangle faces away from a viewer inside the cone at ConeApex around -ConeAxis
+		// with this cosine. ConeCutoff >= 1 means the normals spread too far to cull.
+		float ConeApex[3];
+		float ConeAxis[3];
+		float ConeCutoff;
+	};
+
+	// Reorders indices[0, indexCount) into meshlets. IndexOffset is relative to indices.
+	std::vector<Meshlet> Build(GLuint* indices, size_t indexCount, const GLfloat* vertices, size_t vertexCount, size_t floatsPerVertex,
+		size_t maxVertices = MaxVertices, size_t maxTriangles = MaxTriangles);
+
+	// Frustum planes (xyz = normal pointing inside, w = distance) of a clip matrix, in the
+	// space that matrix takes its input from. Pass camMatrix * model for object space planes.
+	void ExtractFrustum(const glm::mat4& clip, glm::vec4 planes[6]);
+
+	bool ConeCulled(const Meshlet& meshlet, const glm::vec3& viewer);
+	bool FrustumCulled(const Meshlet& meshlet, const glm::vec4 planes[6]);
+
+	struct CullStats
+	{
+		size_t Meshlets{ 0 };
+		size_t Triangles{ 0 };
+		size_t ConeRejected{ 0 };
+		size_t FrustumRejected{ 0 };
+		size_t Draws{ 0 };
+
+		float RejectedPercent() const { return Triangles ? 100.0f * float(ConeRejected + FrustumRejected) / float(Triangles) : 0.0f; }
+	};
+
+	// Appends (first index, index count) ranges of the visible meshlets, merging neighbours.
+	// viewer and planes are in the space of the vertex data.
+	void Cull(const std::vector<Meshlet>& meshlets, uint32_t baseIndex, const glm::vec3& viewer, const glm::vec4 planes[6],
+		std::vector<std::pair<uint32_t, uint32_t>>& ranges, CullStats& stats);
+
+	// Culls from a ring of cameras around the bounds looking at the center and prints the
+	// average share of triangles each test rejected.
+	void PrintCullingReport(const char* name, const std::vector<Meshlet>& meshlets);
+}
@@ -0,0 +1,722 @@
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MIPGENERATOR_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles intrinsics for any ISA as is; GCC and Clang need the target per function.
+#if defined(MIPGENERATOR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define SSE2_TARGET
+#define AVX2_TARGET
+#endif
+
+namespace
+{
+	constexpr int srgbSteps{ 4096 };
+	constexpr int kaiserTaps{ 8 };
+
+	struct Tables
+	{
+		float ToLinear[256];
+		float Unorm[256];
+		// sRGB byte of linear value i / (srgbSteps - 1).
+		int32_t ToSRGB[srgbSteps];
+		// Source texel 2x + i - 3 weighs Kaiser[i] in destination texel x.
+		float Kaiser[kaiserTaps];
+
+		Tables()
+		{
+			for (int i{ 0 }; i < 256; i++)
+			{
+				float c{ i / 255.0f };
+				ToLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+				Unorm[i] = c;
+			}
+
+			for (int i{ 0 }; i < srgbSteps; i++)
+			{
+				double linear{ i / double(srgbSteps - 1) };
+				double srgb{ linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055 };
+				ToSRGB[i] = (int32_t)(srgb * 255.0 + 0.5);
+			}
+
+			// Sinc cut off at the destination Nyquist rate, windowed to 2 destination texels.
+			constexpr double pi{ 3.14159265358979323846 };
+			constexpr double beta{ 4.0 };
+			constexpr double radius{ 2.0 };
+			double sum{ 0.0 };
+			double weights[kaiserTaps];
+			for (int i{ 0 }; i < kaiserTaps; i++)
+			{
+				double distance{ (i - 3.5) / 2.0 };
+				double sinc{ std::sin(pi * distance) / (pi * distance) };
+				double t{ distance / radius };
+				weights[i] = sinc * BesselI0(beta * std::sqrt(1.0 - t * t)) / BesselI0(beta);
+				sum += weights[i];
+			}
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				Kaiser[i] = (float)(weights[i] / sum);
+		}
+
+		static double BesselI0(double x)
+		{
+			double sum{ 1.0 };
+			double term{ 1.0 };
+			for (int k{ 1 }; k < 32 && term > sum * 1e-12; k++)
+			{
+				double factor{ x / (2.0 * k) };
+				term *= factor * factor;
+				sum += term;
+			}
+			return sum;
+		}
+	};
+
+	const Tables tables;
+
+	void ToFloat(const uint8_t* rgba, size_t texelCount, bool srgb, float* out)
+	{
+		const float* colour{ srgb ? tables.ToLinear : tables.Unorm };
+		for (size_t i{ 0 }; i < texelCount; i++)
+		{
+			out[i * 4 + 0] = colour[rgba[i * 4 + 0]];
+			out[i * 4 + 1] = colour[rgba[i * 4 + 1]];
+			out[i * 4 + 2] = colour[rgba[i * 4 + 2]];
+			out[i * 4 + 3] = tables.Unorm[rgba[i * 4 + 3]];
+		}
+	}
+
+	// Every ISA quantizes as clamp, multiply, add 0.5 and truncate so they round alike.
+	uint8_t Quantize(float value, bool srgb)
+	{
+		value = std::min(std::max(value, 0.0f), 1.0f);
+		return srgb ? (uint8_t)tables.ToSRGB[(int)(value * float(srgbSteps - 1) + 0.5f)] : (uint8_t)(int)(value * 255.0f + 0.5f);
+	}
+
+	int Clamp(int value, int size)
+	{
+		return std::min(std::max(value, 0), size - 1);
+	}
+
+	// Texel i of n repeated with every other copy mirrored.
+	int Mirror(int i, int n)
+	{
+		int period{ 2 * n };
+		i = ((i % period) + period) % period;
+		return i < n ? i : period - 1 - i;
+	}
+
+	struct Tap
+	{
+		int Source;
+		float Weight;
+	};
+
+	// The source texels under each of newSize texels resized from size, and their weights.
+	std::vector<std::vector<Tap>> ResizeTaps(uint32_t size, uint32_t newSize)
+	{
+		float scale{ float(size) / float(newSize) };
+		float radius{ std::max(scale, 1.0f) };
+
+		std::vector<std::vector<Tap>> taps(newSize);
+		for (uint32_t i{ 0 }; i < newSize; i++)
+		{
+			float center{ (float(i) + 0.5f) * scale - 0.5f };
+			float sum{ 0.0f };
+			for (int source{ (int)std::floor(center - radius) }; source <= (int)std::ceil(center + radius); source++)
+			{
+				float weight{ 1.0f - std::abs(float(source) - center) / radius };
+				if (weight <= 0.0f)
+					continue;
+
+				taps[i].push_back({ Mirror(source, (int)size), weight });
+				sum += weight;
+			}
+
+			for (Tap& tap : taps[i])
+				tap.Weight /= sum;
+		}
+
+		return taps;
+	}
+
+	struct Kernels
+	{
+		void (*ToBytes)(const float* pixels, size_t texelCount, bool srgb, uint8_t* out);
+		void (*Box)(const float* source, uint32_t sourceWidth, uint32_t sourceHeight, float* destination, uint32_t width, uint32_t height);
+		void (*KaiserRows)(const float* source, uint32_t sourceWidth, uint32_t height, float* destination, uint32_t width);
+		void (*KaiserColumns)(const float* source, uint32_t width, uint32_t sourceHeight, float* destination, uint32_t height);
+	};
+
+	namespace scalar
+	{
+		void ToBytes(const float* pixels, size_t texelCount, bool srgb, uint8_t* out)
+		{
+			for (size_t i{ 0 }; i < texelCount; i++)
+			{
+				out[i * 4 + 0] = Quantize(pixels[i * 4 + 0], srgb);
+				out[i * 4 + 1] = Quantize(pixels[i * 4 + 1], srgb);
+				out[i * 4 + 2] = Quantize(pixels[i * 4 + 2], srgb);
+				out[i * 4 + 3] = Quantize(pixels[i * 4 + 3], false);
+			}
+		}
+
+		void Box(const float* source, uint32_t sourceWidth, uint32_t sourceHeight, float* destination, uint32_t width, uint32_t height)
+		{
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row0{ source + (size_t)std::min(y * 2, sourceHeight - 1) * sourceWidth * 4 };
+				const float* row1{ source + (size_t)std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth * 4 };
+				for (uint32_t x{ 0 }; x < width; x++)
+				{
+					uint32_t x0{ std::min(x * 2, sourceWidth - 1) * 4 };
+					uint32_t x1{ std::min(x * 2 + 1, sourceWidth - 1) * 4 };
+					for (int c{ 0 }; c < 4; c++)
+						destination[((size_t)y * width + x) * 4 + c] = ((row0[x0 + c] + row0[x1 + c]) + (row1[x0 + c] + row1[x1 + c])) * 0.25f;
+				}
+			}
+		}
+
+		void KaiserRows(const float* source, uint32_t sourceWidth, uint32_t height, float* destination, uint32_t width)
+		{
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row{ source + (size_t)y * sourceWidth * 4 };
+				for (uint32_t x{ 0 }; x < width; x++)
+				{
+					for (int c{ 0 }; c < 4; c++)
+					{
+						float sum{ 0.0f };
+						for (int i{ 0 }; i < kaiserTaps; i++)
+							sum = sum + tables.Kaiser[i] * row[Clamp((int)x * 2 + i - 3, (int)sourceWidth) * 4 + c];
+						destination[((size_t)y * width + x) * 4 + c] = sum;
+					}
+				}
+			}
+		}
+
+		void KaiserColumns(const float* source, uint32_t width, uint32_t sourceHeight, float* destination, uint32_t height)
+		{
+			size_t rowFloats{ (size_t)width * 4 };
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* rows[kaiserTaps];
+				for (int i{ 0 }; i < kaiserTaps; i++)
+					rows[i] = source + Clamp((int)y * 2 + i - 3, (int)sourceHeight) * rowFloats;
+
+				float* out{ destination + y * rowFloats };
+				for (size_t f{ 0 }; f < rowFloats; f++)
+				{
+					float sum{ 0.0f };
+					for (int i{ 0 }; i < kaiserTaps; i++)
+						sum = sum + tables.Kaiser[i] * rows[i][f];
+					out[f] = sum;
+				}
+			}
+		}
+
+		constexpr Kernels kernels{ ToBytes, Box, KaiserRows, KaiserColumns };
+	}
+
+#ifdef MIPGENERATOR_X86
+	// One texel per register.
+	namespace sse2
+	{
+		SSE2_TARGET void ToBytes(const float* pixels, size_t texelCount, bool srgb, uint8_t* out)
+		{
+			const float colourScale{ srgb ? float(srgbSteps - 1) : 255.0f };
+			const __m128 scale{ _mm_setr_ps(colourScale, colourScale, colourScale, 255.0f) };
+			const __m128 zero{ _mm_setzero_ps() };
+			const __m128 one{ _mm_set1_ps(1.0f) };
+			const __m128 half{ _mm_set1_ps(0.5f) };
+
+			alignas(16) int32_t lanes[4];
+			for (size_t i{ 0 }; i < texelCount; i++)
+			{
+				__m128 value{ _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pixels + i * 4), zero), one) };
+				_mm_store_si128((__m128i*)lanes, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half)));
+
+				for (int c{ 0 }; c < 3; c++)
+					out[i * 4 + c] = (uint8_t)(srgb ? tables.ToSRGB[lanes[c]] : lanes[c]);
+				out[i * 4 + 3] = (uint8_t)lanes[3];
+			}
+		}
+
+		SSE2_TARGET void Box(const float* source, uint32_t sourceWidth, uint32_t sourceHeight, float* destination, uint32_t width, uint32_t height)
+		{
+			const __m128 quarter{ _mm_set1_ps(0.25f) };
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row0{ source + (size_t)std::min(y * 2, sourceHeight - 1) * sourceWidth * 4 };
+				const float* row1{ source + (size_t)std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth * 4 };
+				for (uint32_t x{ 0 }; x < width; x++)
+				{
+					uint32_t x0{ std::min(x * 2, sourceWidth - 1) * 4 };
+					uint32_t x1{ std::min(x * 2 + 1, sourceWidth - 1) * 4 };
+					__m128 top{ _mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)) };
+					__m128 bottom{ _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)) };
+					_mm_storeu_ps(destination + ((size_t)y * width + x) * 4, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+				}
+			}
+		}
+
+		SSE2_TARGET inline void KaiserTexel(const float* row, uint32_t sourceWidth, uint32_t x, float* out)
+		{
+			__m128 sum{ _mm_setzero_ps() };
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(tables.Kaiser[i]), _mm_loadu_ps(row + Clamp((int)x * 2 + i - 3, (int)sourceWidth) * 4)));
+			_mm_storeu_ps(out, sum);
+		}
+
+		SSE2_TARGET void KaiserRows(const float* source, uint32_t sourceWidth, uint32_t height, float* destination, uint32_t width)
+		{
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row{ source + (size_t)y * sourceWidth * 4 };
+				for (uint32_t x{ 0 }; x < width; x++)
+					KaiserTexel(row, sourceWidth, x, destination + ((size_t)y * width + x) * 4);
+			}
+		}
+
+		SSE2_TARGET void KaiserColumns(const float* source, uint32_t width, uint32_t sourceHeight, float* destination, uint32_t height)
+		{
+			__m128 weights[kaiserTaps];
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				weights[i] = _mm_set1_ps(tables.Kaiser[i]);
+
+			// Rows are whole texels, so always a multiple of 4 floats.
+			size_t rowFloats{ (size_t)width * 4 };
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* rows[kaiserTaps];
+				for (int i{ 0 }; i < kaiserTaps; i++)
+					rows[i] = source + Clamp((int)y * 2 + i - 3, (int)sourceHeight) * rowFloats;
+
+				float* out{ destination + y * rowFloats };
+				for (size_t f{ 0 }; f < rowFloats; f += 4)
+				{
+					__m128 sum{ _mm_setzero_ps() };
+					for (int i{ 0 }; i < kaiserTaps; i++)
+						sum = _mm_add_ps(sum, _mm_mul_ps(weights[i], _mm_loadu_ps(rows[i] + f)));
+					_mm_storeu_ps(out + f, sum);
+				}
+			}
+		}
+
+		constexpr Kernels kernels{ ToBytes, Box, KaiserRows, KaiserColumns };
+	}
+
+	// Two texels per register where the layout allows, else the SSE2 code for the odd one.
+	namespace avx2
+	{
+		// Bytes of two texels, one per 32-bit lane.
+		AVX2_TARGET inline __m256i QuantizeTexels(const float* texels, bool srgb)
+		{
+			const float colourScale{ srgb ? float(srgbSteps - 1) : 255.0f };
+			const __m256 scale{ _mm256_setr_ps(colourScale, colourScale, colourScale, 255.0f, colourScale, colourScale, colourScale, 255.0f) };
+
+			__m256 value{ _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(texels), _mm256_setzero_ps()), _mm256_set1_ps(1.0f)) };
+			__m256i index{ _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, scale), _mm256_set1_ps(0.5f))) };
+			if (!srgb)
+				return index;
+
+			// Alpha lanes hold their byte already; keep them, look the colour lanes up.
+			return _mm256_blend_epi32(_mm256_i32gather_epi32(tables.ToSRGB, index, 4), index, 0x88);
+		}
+
+		AVX2_TARGET void ToBytes(const float* pixels, size_t texelCount, bool srgb, uint8_t* out)
+		{
+			size_t i{ 0 };
+			for (; i + 4 <= texelCount; i += 4)
+			{
+				__m256i words{ _mm256_packs_epi32(QuantizeTexels(pixels + i * 4, srgb), QuantizeTexels(pixels + i * 4 + 8, srgb)) };
+				words = _mm256_permute4x64_epi64(words, 0xD8);
+				__m128i bytes{ _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1)) };
+				_mm_storeu_si128((__m128i*)(out + i * 4), bytes);
+			}
+
+			sse2::ToBytes(pixels + i * 4, texelCount - i, srgb, out + i * 4);
+		}
+
+		AVX2_TARGET void Box(const float* source, uint32_t sourceWidth, uint32_t sourceHeight, float* destination, uint32_t width, uint32_t height)
+		{
+			const __m256 quarter{ _mm256_set1_ps(0.25f) };
+			const __m128 quarter128{ _mm_set1_ps(0.25f) };
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row0{ source + (size_t)std::min(y * 2, sourceHeight - 1) * sourceWidth * 4 };
+				const float* row1{ source + (size_t)std::min(y * 2 + 1, sourceHeight - 1) * sourceWidth * 4 };
+				float* out{ destination + (size_t)y * width * 4 };
+
+				// Texels 2x .. 2x + 3 are all inside the row for both outputs.
+				uint32_t x{ 0 };
+				for (; x + 1 < width && x * 2 + 3 < sourceWidth; x += 2)
+				{
+					__m256 a0{ _mm256_loadu_ps(row0 + x * 8) };
+					__m256 b0{ _mm256_loadu_ps(row0 + x * 8 + 8) };
+					__m256 a1{ _mm256_loadu_ps(row1 + x * 8) };
+					__m256 b1{ _mm256_loadu_ps(row1 + x * 8 + 8) };
+					__m256 top{ _mm256_add_ps(_mm256_permute2f128_ps(a0, b0, 0x20), _mm256_permute2f128_ps(a0, b0, 0x31)) };
+					__m256 bottom{ _mm256_add_ps(_mm256_permute2f128_ps(a1, b1, 0x20), _mm256_permute2f128_ps(a1, b1, 0x31)) };
+					_mm256_storeu_ps(out + x * 4, _mm256_mul_ps(_mm256_add_ps(top, bottom), quarter));
+				}
+				for (; x < width; x++)
+				{
+					uint32_t x0{ std::min(x * 2, sourceWidth - 1) * 4 };
+					uint32_t x1{ std::min(x * 2 + 1, sourceWidth - 1) * 4 };
+					__m128 top{ _mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)) };
+					__m128 bottom{ _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)) };
+					_mm_storeu_ps(out + x * 4, _mm_mul_ps(_mm_add_ps(top, bottom), quarter128));
+				}
+			}
+		}
+
+		AVX2_TARGET void KaiserRows(const float* source, uint32_t sourceWidth, uint32_t height, float* destination, uint32_t width)
+		{
+			__m256 weights[kaiserTaps];
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				weights[i] = _mm256_set1_ps(tables.Kaiser[i]);
+
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* row{ source + (size_t)y * sourceWidth * 4 };
+				float* out{ destination + (size_t)y * width * 4 };
+
+				uint32_t x{ 0 };
+				for (; x + 1 < width; x += 2)
+				{
+					__m256 sum{ _mm256_setzero_ps() };
+					for (int i{ 0 }; i < kaiserTaps; i++)
+					{
+						__m128 first{ _mm_loadu_ps(row + Clamp((int)x * 2 + i - 3, (int)sourceWidth) * 4) };
+						__m128 second{ _mm_loadu_ps(row + Clamp((int)x * 2 + i - 1, (int)sourceWidth) * 4) };
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(weights[i], _mm256_insertf128_ps(_mm256_castps128_ps256(first), second, 1)));
+					}
+					_mm256_storeu_ps(out + x * 4, sum);
+				}
+				if (x < width)
+					sse2::KaiserTexel(row, sourceWidth, x, out + x * 4);
+			}
+		}
+
+		AVX2_TARGET void KaiserColumns(const float* source, uint32_t width, uint32_t sourceHeight, float* destination, uint32_t height)
+		{
+			__m256 weights[kaiserTaps];
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				weights[i] = _mm256_set1_ps(tables.Kaiser[i]);
+			__m128 weights128[kaiserTaps];
+			for (int i{ 0 }; i < kaiserTaps; i++)
+				weights128[i] = _mm_set1_ps(tables.Kaiser[i]);
+
+			size_t rowFloats{ (size_t)width * 4 };
+			for (uint32_t y{ 0 }; y < height; y++)
+			{
+				const float* rows[kaiserTaps];
+				for (int i{ 0 }; i < kaiserTaps; i++)
+					rows[i] = source + Clamp((int)y * 2 + i - 3, (int)sourceHeight) * rowFloats;
+
+				float* out{ destination + y * rowFloats };
+				size_t f{ 0 };
+				for (; f + 8 <= rowFloats; f += 8)
+				{
+					__m256 sum{ _mm256_setzero_ps() };
+					for (int i{ 0 }; i < kaiserTaps; i++)
+						sum = _mm256_add_ps(sum, _mm256_mul_ps(weights[i], _mm256_loadu_ps(rows[i] + f)));
+					_mm256_storeu_ps(out + f, sum);
+				}
+				if (f < rowFloats)
+				{
+					__m128 sum{ _mm_setzero_ps() };
+					for (int i{ 0 }; i < kaiserTaps; i++)
+						sum = _mm_add_ps(sum, _mm_mul_ps(weights128[i], _mm_loadu_ps(rows[i] + f)));
+					_mm_storeu_ps(out + f, sum);
+				}
+			}
+		}
+
+		constexpr Kernels kernels{ ToBytes, Box, KaiserRows, KaiserColumns };
+	}
+#endif
+
+	const Kernels& KernelsFor(MipGenerator::ISA isa)
+	{
+#ifdef MIPGENERATOR_X86
+		if (isa == MipGenerator::ISA::AVX2)
+			return avx2::kernels;
+		if (isa == MipGenerator::ISA::SSE2)
+			return sse2::kernels;
+#endif
+		return scalar::kernels;
+	}
+
+	double Luminance(const double rgb[3])
+	{
+		return 0.2126 * rgb[0] + 0.7152 * rgb[1] + 0.0722 * rgb[2];
+	}
+
+	// Mean linear luminance of an RGBA image.
+	double MeanLuminance(const uint8_t* rgba, size_t texelCount, bool srgb)
+	{
+		const float* colour{ srgb ? tables.ToLinear : tables.Unorm };
+		double sum{ 0.0 };
+		for (size_t i{ 0 }; i < texelCount; i++)
+		{
+			double rgb[3]{ colour[rgba[i * 4]], colour[rgba[i * 4 + 1]], colour[rgba[i * 4 + 2]] };
+			sum += Luminance(rgb);
+		}
+		return texelCount ? sum / texelCount : 0.0;
+	}
+}
+
+MipGenerator::ISA MipGenerator::BestISA()
+{
+#ifdef MIPGENERATOR_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuidex(info, 0, 0);
+	if (info[0] >= 7)
+	{
+		__cpuidex(info, 1, 0);
+		bool osxsave{ (info[2] & (1 << 27)) != 0 };
+		bool avx{ (info[2] & (1 << 28)) != 0 };
+		__cpuidex(info, 7, 0);
+		bool avx2{ (info[1] & (1 << 5)) != 0 };
+		if (osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6)
+			return ISA::AVX2;
+	}
+	return ISA::SSE2;
+#else
+	if (__builtin_cpu_supports("avx2"))
+		return ISA::AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return ISA::SSE2;
+#endif
+#endif
+	return ISA::Scalar;
+}
+
+const char* MipGenerator::Name(Filter filter)
+{
+	return filter == Filter::Box ? "box" : "kaiser";
+}
+
+const char* MipGenerator::Name(ISA isa)
+{
+	switch (isa)
+	{
+	case ISA::SSE2: return "sse2";
+	case ISA::AVX2: return "avx2";
+	default: return "scalar";
+	}
+}
+
+std::vector<MipGenerator::Level> MipGenerator::Generate(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb, Filter filter, ISA isa)
+{
+	const Kernels& kernels{ KernelsFor(std::min(isa, BestISA())) };
+
+	std::vector<Level> levels;
+	std::vector<float> current((size_t)width * height * 4);
+	std::vector<float> next;
+	std::vector<float> rows;
+	ToFloat(rgba, (size_t)width * height, srgb, current.data());
+
+	while (width > 1 || height > 1)
+	{
+		uint32_t nextWidth{ std::max(width / 2, 1u) };
+		uint32_t nextHeight{ std::max(height / 2, 1u) };
+		next.resize((size_t)nextWidth * nextHeight * 4);
+
+		if (filter == Filter::Box)
+		{
+			kernels.Box(current.data(), width, height, next.data(), nextWidth, nextHeight);
+		}
+		else
+		{
+			// A side of 1 stays as it is instead of being filtered against copies of itself.
+			const float* filtered{ current.data() };
+			if (width > 1)
+			{
+				rows.resize((size_t)nextWidth * height * 4);
+				kernels.KaiserRows(current.data(), width, height, rows.data(), nextWidth);
+				filtered = rows.data();
+			}
+
+			if (height > 1)
+				kernels.KaiserColumns(filtered, nextWidth, height, next.data(), nextHeight);
+			else
+				std::memcpy(next.data(), filtered, next.size() * sizeof(float));
+		}
+
+		levels.emplace_back();
+		Level& level{ levels.back() };
+		level.Width = nextWidth;
+		level.Height = nextHeight;
+		level.Pixels.resize(next.size());
+		kernels.ToBytes(next.data(), (size_t)nextWidth * nextHeight, srgb, level.Pixels.data());
+
+		current.swap(next);
+		width = nextWidth;
+		height = nextHeight;
+	}
+
+	return levels;
+}
+
+std::vector<uint8_t> MipGenerator::Resize(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t newWidth, uint32_t newHeight, bool srgb)
+{
+	std::vector<float> source((size_t)width * height * 4);
+	ToFloat(rgba, (size_t)width * height, srgb, source.data());
+
+	// Rows first, then columns.
+	std::vector<std::vector<Tap>> columnTaps{ ResizeTaps(width, newWidth) };
+	std::vector<float> rows((size_t)newWidth * height * 4, 0.0f);
+	for (uint32_t y{ 0 }; y < height; y++)
+	{
+		for (uint32_t x{ 0 }; x < newWidth; x++)
+		{
+			float* out{ &rows[((size_t)y * newWidth + x) * 4] };
+			for (const Tap& tap : columnTaps[x])
+			{
+				const float* in{ &source[((size_t)y * width + (size_t)tap.Source) * 4] };
+				for (int c{ 0 }; c < 4; c++)
+					out[c] += in[c] * tap.Weight;
+			}
+		}
+	}
+
+	std::vector<std::vector<Tap>> rowTaps{ ResizeTaps(height, newHeight) };
+	std::vector<uint8_t> resized((size_t)newWidth * newHeight * 4);
+	for (uint32_t y{ 0 }; y < newHeight; y++)
+	{
+		for (uint32_t x{ 0 }; x < newWidth; x++)
+		{
+			float texel[4]{};
+			for (const Tap& tap : rowTaps[y])
+			{
+				const float* in{ &rows[((size_t)tap.Source * newWidth + x) * 4] };
+				for (int c{ 0 }; c < 4; c++)
+					texel[c] += in[c] * tap.Weight;
+			}
+
+			uint8_t* out{ &resized[((size_t)y * newWidth + x) * 4] };
+			for (int c{ 0 }; c < 3; c++)
+				out[c] = Quantize(texel[c], srgb);
+			out[3] = Quantize(texel[3], false);
+		}
+	}
+
+	return resized;
+}
+
+void MipGenerator::PrintReport(const std::string& name, const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb, const std::vector<Level>& driverLevels)
+{
+	std::printf("- Mipmaps of %s (%ux%u):\n", name.c_str(), width, height);
+
+	ISA best{ BestISA() };
+	std::vector<Level> generated[2];
+	for (Filter filter : { Filter::Box, Filter::Kaiser })
+	{
+		std::printf("  %-7s", Name(filter));
+
+		std::vector<Level> reference;
+		for (int isa{ 0 }; isa <= (int)best; isa++)
+		{
+			std::vector<Level> levels;
+			int runs{ 0 };
+			std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+			double seconds{ 0.0 };
+			do
+			{
+				levels = Generate(rgba, width, height, srgb, filter, (ISA)isa);
+				runs++;
+				seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			} while (seconds < 0.05 && runs < 100);
+
+			bool same{ true };
+			if (isa == 0)
+				reference = levels;
+			else
+				for (size_t l{ 0 }; l < levels.size(); l++)
+					same = same && levels[l].Pixels == reference[l].Pixels;
+
+			std::printf(" %s %.1f MPix/s%s", Name((ISA)isa), (double)width * height * runs / seconds / 1e6, same ? "" : " (differs from scalar!)");
+		}
+		std::printf("\n");
+
+		generated[filter == Filter::Box ? 0 : 1] = reference;
+	}
+
+	// Exact average of every 2^level sided block of the source, in linear space.
+	const float* colour{ srgb ? tables.ToLinear : tables.Unorm };
+	double sourceLuminance{ MeanLuminance(rgba, (size_t)width * height, srgb) };
+
+	const char* names[3]{ "box", "kaiser", "driver" };
+	const std::vector<Level>* chains[3]{ &generated[0], &generated[1], &driverLevels };
+	for (int chain{ 0 }; chain < 3; chain++)
+	{
+		const std::vector<Level>& levels{ *chains[chain] };
+		if (levels.empty())
+			continue;
+
+		double squaredError{ 0.0 };
+		size_t samples{ 0 };
+		double worstDrift{ 0.0 };
+		for (size_t l{ 0 }; l < levels.size(); l++)
+		{
+			const Level& level{ levels[l] };
+			const Level& expected{ generated[0][std::min(l, generated[0].size() - 1)] };
+			if (level.Width != expected.Width || level.Height != expected.Height)
+				break;
+
+			uint32_t block{ 1u << (l + 1) };
+			for (uint32_t y{ 0 }; y < level.Height; y++)
+			{
+				for (uint32_t x{ 0 }; x < level.Width; x++)
+				{
+					double sum[4]{ 0.0, 0.0, 0.0, 0.0 };
+					size_t count{ 0 };
+					for (uint32_t sy{ y * block }; sy < std::min((y + 1) * block, height); sy++)
+					{
+						for (uint32_t sx{ x * block }; sx < std::min((x + 1) * block, width); sx++)
+						{
+							const uint8_t* texel{ rgba + ((size_t)sy * width + sx) * 4 };
+							for (int c{ 0 }; c < 3; c++)
+								sum[c] += colour[texel[c]];
+							sum[3] += tables.Unorm[texel[3]];
+							count++;
+						}
+					}
+
+					const uint8_t* actual{ level.Pixels.data() + ((size_t)y * level.Width + x) * 4 };
+					for (int c{ 0 }; c < 4 && count; c++)
+					{
+						double difference{ (double)actual[c] - Quantize((float)(sum[c] / count), srgb && c < 3) };
+						squaredError += difference * difference;
+						samples++;
+					}
+				}
+			}
+
+			double drift{ std::fabs(MeanLuminance(level.Pixels.data(), (size_t)level.Width * level.Height, srgb) / sourceLuminance - 1.0) };
+			if (level.Width >= 4 && level.Height >= 4)
+				worstDrift = std::max(worstDrift, drift);
+		}
+
+		double meanSquaredError{ samples ? squaredError / samples : 0.0 };
+		double psnr{ meanSquaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : INFINITY };
+		std::printf("  %-7s %.1f dB against the area average, brightness drift up to %.2f%%\n", names[chain], psnr, worstDrift * 100.0);
+	}
+}
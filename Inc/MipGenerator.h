@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Builds mip chains of 8-bit RGBA images on the CPU.
+//
+// Filtering runs on floats, after converting sRGB colour channels to linear, so the chain
+// keeps the brightness of the source whatever the driver would have done. Alpha is always
+// linear. Each level halves the one before it (rounding down, at least 1) and is filtered
+// from it; SSE2 and AVX2 paths give the same bytes as the scalar one. Nothing here touches
+// GL, so worker threads and offline tools can use it.
+namespace MipGenerator
+{
+	enum class Filter
+	{
+		// Average of 2x2 texels.
+		Box,
+		// Kaiser windowed sinc over 8x8 texels: sharper levels with less aliasing.
+		Kaiser
+	};
+
+	enum class ISA
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	// Widest instruction set this CPU and build can run.
+	ISA BestISA();
+	const char* Name(Filter filter);
+	const char* Name(ISA isa);
+
+	struct Level
+	{
+		uint32_t Width{ 0 };
+		uint32_t Height{ 0 };
+		std::vector<uint8_t> Pixels;
+	};
+
+	// Levels 1 and up of an RGBA image, down to 1x1; the image itself is level 0.
+	std::vector<Level> Generate(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb, Filter filter, ISA isa = BestISA());
+
+	// An RGBA image resized to newWidth x newHeight with a tent filter, as wide as a new texel
+	// when shrinking. The edges wrap mirrored, as GL_MIRRORED_REPEAT samples them.
+	std::vector<uint8_t> Resize(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t newWidth, uint32_t newHeight, bool srgb);
+
+	// Times every filter on every supported ISA over the image, then compares the levels of
+	// each filter and of driverLevels (levels 1 and up, e.g. read back after glGenerateMipmap)
+	// against an exact linear area average of the source and prints both.
+	void PrintReport(const std::string& name, const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb, const std::vector<Level>& driverLevels);
+}
@@ -1,1167 +1,2288 @@
-// OBJ_Loader.h - A Single Header OBJ Model Loader
-
-#pragma once
-
-// Iostream - STD I/O Library
-#include <iostream>
-
-// Vector - STD Vector/Array Library
-#include <vector>
-
-// String - STD String Library
-#include <string>
-
-// fStream - STD File I/O Library
-#include <fstream>
-
-// Math.h - STD math Library
-#include <math.h>
-
-// Print progress to console while loading (large models)
-#define OBJL_CONSOLE_OUTPUT
-
-// Namespace: OBJL
-//
-// Description: The namespace that holds eveyrthing that
-//	is needed and used for the OBJ Model Loader
-namespace objl
-{
-	// Structure: Vector2
-	//
-	// Description: A 2D Vector that Holds Positional Data
-	struct Vector2
-	{
-		// Default Constructor
-		Vector2()
-		{
-			X = 0.0f;
-			Y = 0.0f;
-		}
-		// Variable Set Constructor
-		Vector2(float X_, float Y_)
-		{
-			X = X_;
-			Y = Y_;
-		}
-		// Bool Equals Operator Overload
-		bool operator==(const Vector2& other) const
-		{
-			return (this->X == other.X && this->Y == other.Y);
-		}
-		// Bool Not Equals Operator Overload
-		bool operator!=(const Vector2& other) const
-		{
-			return !(this->X == other.X && this->Y == other.Y);
-		}
-		// Addition Operator Overload
-		Vector2 operator+(const Vector2& right) const
-		{
-			return Vector2(this->X + right.X, this->Y + right.Y);
-		}
-		// Subtraction Operator Overload
-		Vector2 operator-(const Vector2& right) const
-		{
-			return Vector2(this->X - right.X, this->Y - right.Y);
-		}
-		// Float Multiplication Operator Overload
-		Vector2 operator*(const float& other) const
-		{
-			return Vector2(this->X * other, this->Y * other);
-		}
-
-		// Positional Variables
-		float X;
-		float Y;
-	};
-
-	// Structure: Vector3
-	//
-	// Description: A 3D Vector that Holds Positional Data
-	struct Vector3
-	{
-		// Default Constructor
-		Vector3()
-		{
-			X = 0.0f;
-			Y = 0.0f;
-			Z = 0.0f;
-		}
-		// Variable Set Constructor
-		Vector3(float X_, float Y_, float Z_)
-		{
-			X = X_;
-			Y = Y_;
-			Z = Z_;
-		}
-		// Bool Equals Operator Overload
-		bool operator==(const Vector3& other) const
-		{
-			return (this->X == other.X && this->Y == other.Y && this->Z == other.Z);
-		}
-		// Bool Not Equals Operator Overload
-		bool operator!=(const Vector3& other) const
-		{
-			return !(this->X == other.X && this->Y == other.Y && this->Z == other.Z);
-		}
-		// Addition Operator Overload
-		Vector3 operator+(const Vector3& right) const
-		{
-			return Vector3(this->X + right.X, this->Y + right.Y, this->Z + right.Z);
-		}
-		// Subtraction Operator Overload
-		Vector3 operator-(const Vector3& right) const
-		{
-			return Vector3(this->X - right.X, this->Y - right.Y, this->Z - right.Z);
-		}
-		// Float Multiplication Operator Overload
-		Vector3 operator*(const float& other) const
-		{
-			return Vector3(this->X * other, this->Y * other, this->Z * other);
-		}
-		// Float Division Operator Overload
-		Vector3 operator/(const float& other) const
-		{
-			return Vector3(this->X / other, this->Y / other, this->Z / other);
-		}
-
-		// Positional Variables
-		float X;
-		float Y;
-		float Z;
-	};
-
-	// Structure: Vertex
-	//
-	// Description: Model Vertex object that holds
-	//	a Position, Normal, and Texture Coordinate
-	struct Vertex
-	{
-		// Position Vector
-		Vector3 Position;
-
-		// Normal Vector
-		Vector3 Normal;
-
-		// Texture Coordinate Vector
-		Vector2 TextureCoordinate;
-	};
-
-	struct Material
-	{
-		Material()
-		{
-			name;
-			Ns = 0.0f;
-			Ni = 0.0f;
-			d = 0.0f;
-			illum = 0;
-		}
-
-		// Material Name
-		std::string name;
-		// Ambient Color
-		Vector3 Ka;
-		// Diffuse Color
-		Vector3 Kd;
-		// Specular Color
-		Vector3 Ks;
-		// Specular Exponent
-		float Ns;
-		// Optical Density
-		float Ni;
-		// Dissolve
-		float d;
-		// Illumination
-		int illum;
-		// Ambient Texture Map
-		std::string map_Ka;
-		// Diffuse Texture Map
-		std::string map_Kd;
-		// Specular Texture Map
-		std::string map_Ks;
-		// Specular Hightlight Map
-		std::string map_Ns;
-		// Alpha Texture Map
-		std::string map_d;
-		// Bump Map
-		std::string map_bump;
-	};
-
-	// Structure: Mesh
-	//
-	// Description: A Simple Mesh Object that holds
-	//	a name, a vertex list, and an index list
-	struct Mesh
-	{
-		// Default Constructor
-		Mesh()
-		{
-
-		}
-		// Variable Set Constructor
-		Mesh(std::vector<Vertex>& _Vertices, std::vector<unsigned int>& _Indices)
-		{
-			Vertices = _Vertices;
-			Indices = _Indices;
-		}
-		// Mesh Name
-		std::string MeshName;
-		// Vertex List
-		std::vector<Vertex> Vertices;
-		// Index List
-		std::vector<unsigned int> Indices;
-
-		// Material
-		Material MeshMaterial;
-	};
-
-	// Namespace: Math
-	//
-	// Description: The namespace that holds all of the math
-	//	functions need for OBJL
-	namespace math
-	{
-		// Vector3 Cross Product
-		Vector3 CrossV3(const Vector3 a, const Vector3 b)
-		{
-			return Vector3(a.Y * b.Z - a.Z * b.Y,
-				a.Z * b.X - a.X * b.Z,
-				a.X * b.Y - a.Y * b.X);
-		}
-
-		// Vector3 Magnitude Calculation
-		float MagnitudeV3(const Vector3 in)
-		{
-			return (sqrtf(powf(in.X, 2) + powf(in.Y, 2) + powf(in.Z, 2)));
-		}
-
-		// Vector3 DotProduct
-		float DotV3(const Vector3 a, const Vector3 b)
-		{
-			return (a.X * b.X) + (a.Y * b.Y) + (a.Z * b.Z);
-		}
-
-		// Angle between 2 Vector3 Objects
-		float AngleBetweenV3(const Vector3 a, const Vector3 b)
-		{
-			float angle = DotV3(a, b);
-			angle /= (MagnitudeV3(a) * MagnitudeV3(b));
-			return angle = acosf(angle);
-		}
-
-		// Projection Calculation of a onto b
-		Vector3 ProjV3(const Vector3 a, const Vector3 b)
-		{
-			Vector3 bn = b / MagnitudeV3(b);
-			return bn * DotV3(a, bn);
-		}
-	}
-
-	// Namespace: Algorithm
-	//
-	// Description: The namespace that holds all of the
-	// Algorithms needed for OBJL
-	namespace algorithm
-	{
-		// Vector3 Multiplication Opertor Overload
-		Vector3 operator*(const float& left, const Vector3& right)
-		{
-			return Vector3(right.X * left, right.Y * left, right.Z * left);
-		}
-
-		// A test to see if P1 is on the same side as P2 of a line segment ab
-		bool SameSide(Vector3 p1, Vector3 p2, Vector3 a, Vector3 b)
-		{
-			Vector3 cp1 = math::CrossV3(b - a, p1 - a);
-			Vector3 cp2 = math::CrossV3(b - a, p2 - a);
-
-			if (math::DotV3(cp1, cp2) >= 0)
-				return true;
-			else
-				return false;
-		}
-
-		// Generate a cross produect normal for a triangle
-		Vector3 GenTriNormal(Vector3 t1, Vector3 t2, Vector3 t3)
-		{
-			Vector3 u = t2 - t1;
-			Vector3 v = t3 - t1;
-
-			Vector3 normal = math::CrossV3(u, v);
-
-			return normal;
-		}
-
-		// Check to see if a Vector3 Point is within a 3 Vector3 Triangle
-		bool inTriangle(Vector3 point, Vector3 tri1, Vector3 tri2, Vector3 tri3)
-		{
-			// Test to see if it is within an infinite prism that the triangle outlines.
-			bool within_tri_prisim = SameSide(point, tri1, tri2, tri3) && SameSide(point, tri2, tri1, tri3)
-				&& SameSide(point, tri3, tri1, tri2);
-
-			// If it isn't it will never be on the triangle
-			if (!within_tri_prisim)
-				return false;
-
-			// Calulate Triangle's Normal
-			Vector3 n = GenTriNormal(tri1, tri2, tri3);
-
-			// Project the point onto this normal
-			Vector3 proj = math::ProjV3(point, n);
-
-			// If the distance from the triangle to the point is 0
-			//	it lies on the triangle
-			if (math::MagnitudeV3(proj) == 0)
-				return true;
-			else
-				return false;
-		}
-
-		// Split a String into a string array at a given token
-		inline void split(const std::string& in,
-			std::vector<std::string>& out,
-			std::string token)
-		{
-			out.clear();
-
-			std::string temp;
-
-			for (int i = 0; i < int(in.size()); i++)
-			{
-				std::string test = in.substr(i, token.size());
-
-				if (test == token)
-				{
-					if (!temp.empty())
-					{
-						out.push_back(temp);
-						temp.clear();
-						i += (int)token.size() - 1;
-					}
-					else
-					{
-						out.push_back("");
-					}
-				}
-				else if (i + token.size() >= in.size())
-				{
-					temp += in.substr(i, token.size());
-					out.push_back(temp);
-					break;
-				}
-				else
-				{
-					temp += in[i];
-				}
-			}
-		}
-
-		// Get tail of string after first token and possibly following spaces
-		inline std::string tail(const std::string& in)
-		{
-			size_t token_start = in.find_first_not_of(" \t");
-			size_t space_start = in.find_first_of(" \t", token_start);
-			size_t tail_start = in.find_first_not_of(" \t", space_start);
-			size_t tail_end = in.find_last_not_of(" \t");
-			if (tail_start != std::string::npos && tail_end != std::string::npos)
-			{
-				return in.substr(tail_start, tail_end - tail_start + 1);
-			}
-			else if (tail_start != std::string::npos)
-			{
-				return in.substr(tail_start);
-			}
-			return "";
-		}
-
-		// Get first token of string
-		inline std::string firstToken(const std::string& in)
-		{
-			if (!in.empty())
-			{
-				size_t token_start = in.find_first_not_of(" \t");
-				size_t token_end = in.find_first_of(" \t", token_start);
-				if (token_start != std::string::npos && token_end != std::string::npos)
-				{
-					return in.substr(token_start, token_end - token_start);
-				}
-				else if (token_start != std::string::npos)
-				{
-					return in.substr(token_start);
-				}
-			}
-			return "";
-		}
-
-		// Get element at given index position
-		template <class T>
-		inline const T& getElement(const std::vector<T>& elements, std::string& index)
-		{
-			int idx = std::stoi(index);
-			if (idx < 0)
-				idx = int(elements.size()) + idx;
-			else
-				idx--;
-			return elements[idx];
-		}
-	}
-
-	// Class: Loader
-	//
-	// Description: The OBJ Model Loader
-	class Loader
-	{
-	public:
-		// Default Constructor
-		Loader()
-		{
-
-		}
-		~Loader()
-		{
-			LoadedMeshes.clear();
-		}
-
-		// Load a file into the loader
-		//
-		// If file is loaded return true
-		//
-		// If the file is unable to be found
-		// or unable to be loaded return false
-		bool LoadFile(std::string Path)
-		{
-			// If the file is not an .obj file return false
-			if (Path.substr(Path.size() - 4, 4) != ".obj")
-				return false;
-
-
-			std::ifstream file(Path);
-
-			if (!file.is_open())
-				return false;
-
-			LoadedMeshes.clear();
-			LoadedVertices.clear();
-			LoadedIndices.clear();
-
-			std::vector<Vector3> Positions;
-			std::vector<Vector2> TCoords;
-			std::vector<Vector3> Normals;
-
-			std::vector<Vertex> Vertices;
-			std::vector<unsigned int> Indices;
-
-			std::vector<std::string> MeshMatNames;
-
-			bool listening = false;
-			std::string meshname;
-
-			Mesh tempMesh;
-
-#ifdef OBJL_CONSOLE_OUTPUT
-			const unsigned int outputEveryNth = 1000;
-			unsigned int outputIndicator = outputEveryNth;
-#endif
-
-			std::string curline;
-			while (std::getline(file, curline))
-			{
-#ifdef OBJL_CONSOLE_OUTPUT
-				if ((outputIndicator = ((outputIndicator + 1) % outputEveryNth)) == 1)
-				{
-					if (!meshname.empty())
-					{
-						std::cout
-							<< "\r- " << meshname
-							<< "\t| vertices > " << Positions.size()
-							<< "\t| texcoords > " << TCoords.size()
-							<< "\t| normals > " << Normals.size()
-							<< "\t| triangles > " << (Vertices.size() / 3)
-							<< (!MeshMatNames.empty() ? "\t| material: " + MeshMatNames.back() : "");
-					}
-				}
-#endif
-
-				// Generate a Mesh Object or Prepare for an object to be created
-				if (algorithm::firstToken(curline) == "o" || algorithm::firstToken(curline) == "g" || curline[0] == 'g')
-				{
-					if (!listening)
-					{
-						listening = true;
-
-						if (algorithm::firstToken(curline) == "o" || algorithm::firstToken(curline) == "g")
-						{
-							meshname = algorithm::tail(curline);
-						}
-						else
-						{
-							meshname = "unnamed";
-						}
-					}
-					else
-					{
-						// Generate the mesh to put into the array
-
-						if (!Indices.empty() && !Vertices.empty())
-						{
-							// Create Mesh
-							tempMesh = Mesh(Vertices, Indices);
-							tempMesh.MeshName = meshname;
-
-							// Insert Mesh
-							LoadedMeshes.push_back(tempMesh);
-
-							// Cleanup
-							Vertices.clear();
-							Indices.clear();
-							meshname.clear();
-
-							meshname = algorithm::tail(curline);
-						}
-						else
-						{
-							if (algorithm::firstToken(curline) == "o" || algorithm::firstToken(curline) == "g")
-							{
-								meshname = algorithm::tail(curline);
-							}
-							else
-							{
-								meshname = "unnamed";
-							}
-						}
-					}
-#ifdef OBJL_CONSOLE_OUTPUT
-					std::cout << std::endl;
-					outputIndicator = 0;
-#endif
-				}
-				// Generate a Vertex Position
-				if (algorithm::firstToken(curline) == "v")
-				{
-					std::vector<std::string> spos;
-					Vector3 vpos;
-					algorithm::split(algorithm::tail(curline), spos, " ");
-
-					vpos.X = std::stof(spos[0]);
-					vpos.Y = std::stof(spos[1]);
-					vpos.Z = std::stof(spos[2]);
-
-					Positions.push_back(vpos);
-				}
-				// Generate a Vertex Texture Coordinate
-				if (algorithm::firstToken(curline) == "vt")
-				{
-					std::vector<std::string> stex;
-					Vector2 vtex;
-					algorithm::split(algorithm::tail(curline), stex, " ");
-
-					vtex.X = std::stof(stex[0]);
-					vtex.Y = std::stof(stex[1]);
-
-					TCoords.push_back(vtex);
-				}
-				// Generate a Vertex Normal;
-				if (algorithm::firstToken(curline) == "vn")
-				{
-					std::vector<std::string> snor;
-					Vector3 vnor;
-					algorithm::split(algorithm::tail(curline), snor, " ");
-
-					vnor.X = std::stof(snor[0]);
-					vnor.Y = std::stof(snor[1]);
-					vnor.Z = std::stof(snor[2]);
-
-					Normals.push_back(vnor);
-				}
-				// Generate a Face (vertices & indices)
-				if (algorithm::firstToken(curline) == "f")
-				{
-					// Generate the vertices
-					std::vector<Vertex> vVerts;
-					GenVerticesFromRawOBJ(vVerts, Positions, TCoords, Normals, curline);
-
-					// Add Vertices
-					for (int i = 0; i < int(vVerts.size()); i++)
-					{
-						Vertices.push_back(vVerts[i]);
-
-						LoadedVertices.push_back(vVerts[i]);
-					}
-
-					std::vector<unsigned int> iIndices;
-
-					VertexTriangluation(iIndices, vVerts);
-
-					// Add Indices
-					for (int i = 0; i < int(iIndices.size()); i++)
-					{
-						unsigned int indnum = (unsigned int)((Vertices.size()) - vVerts.size()) + iIndices[i];
-						Indices.push_back(indnum);
-
-						indnum = (unsigned int)((LoadedVertices.size()) - vVerts.size()) + iIndices[i];
-						LoadedIndices.push_back(indnum);
-
-					}
-				}
-				// Get Mesh Material Name
-				if (algorithm::firstToken(curline) == "usemtl")
-				{
-					MeshMatNames.push_back(algorithm::tail(curline));
-
-					// Create new Mesh, if Material changes within a group
-					if (!Indices.empty() && !Vertices.empty())
-					{
-						// Create Mesh
-						tempMesh = Mesh(Vertices, Indices);
-						tempMesh.MeshName = meshname;
-						int i = 2;
-						while (1) {
-							tempMesh.MeshName = meshname + "_" + std::to_string(i);
-
-							for (auto& m : LoadedMeshes)
-								if (m.MeshName == tempMesh.MeshName)
-									continue;
-							break;
-						}
-
-						// Insert Mesh
-						LoadedMeshes.push_back(tempMesh);
-
-						// Cleanup
-						Vertices.clear();
-						Indices.clear();
-					}
-
-#ifdef OBJL_CONSOLE_OUTPUT
-					outputIndicator = 0;
-#endif
-				}
-				// Load Materials
-				if (algorithm::firstToken(curline) == "mtllib")
-				{
-					// Generate LoadedMaterial
-
-					// Generate a path to the material file
-					std::vector<std::string> temp;
-					algorithm::split(Path, temp, "/");
-
-					std::string pathtomat = "";
-
-					if (temp.size() != 1)
-					{
-						for (int i = 0; i < temp.size() - 1; i++)
-						{
-							pathtomat += temp[i] + "/";
-						}
-					}
-
-
-					pathtomat += algorithm::tail(curline);
-
-#ifdef OBJL_CONSOLE_OUTPUT
-					std::cout << std::endl << "- find materials in: " << pathtomat << std::endl;
-#endif
-
-					// Load Materials
-					LoadMaterials(pathtomat);
-				}
-			}
-
-#ifdef OBJL_CONSOLE_OUTPUT
-			std::cout << std::endl;
-#endif
-
-			// Deal with last mesh
-
-			if (!Indices.empty() && !Vertices.empty())
-			{
-				// Create Mesh
-				tempMesh = Mesh(Vertices, Indices);
-				tempMesh.MeshName = meshname;
-
-				// Insert Mesh
-				LoadedMeshes.push_back(tempMesh);
-			}
-
-			file.close();
-
-			// Set Materials for each Mesh
-			for (int i = 0; i < MeshMatNames.size(); i++)
-			{
-				std::string matname = MeshMatNames[i];
-
-				// Find corresponding material name in loaded materials
-				// when found copy material variables into mesh material
-				for (int j = 0; j < LoadedMaterials.size(); j++)
-				{
-					if (LoadedMaterials[j].name == matname)
-					{
-						LoadedMeshes[i].MeshMaterial = LoadedMaterials[j];
-						break;
-					}
-				}
-			}
-
-			if (LoadedMeshes.empty() && LoadedVertices.empty() && LoadedIndices.empty())
-			{
-				return false;
-			}
-			else
-			{
-				return true;
-			}
-		}
-
-		// Loaded Mesh Objects
-		std::vector<Mesh> LoadedMeshes;
-		// Loaded Vertex Objects
-		std::vector<Vertex> LoadedVertices;
-		// Loaded Index Positions
-		std::vector<unsigned int> LoadedIndices;
-		// Loaded Material Objects
-		std::vector<Material> LoadedMaterials;
-
-	private:
-		// Generate vertices from a list of positions, 
-		//	tcoords, normals and a face line
-		void GenVerticesFromRawOBJ(std::vector<Vertex>& oVerts,
-			const std::vector<Vector3>& iPositions,
-			const std::vector<Vector2>& iTCoords,
-			const std::vector<Vector3>& iNormals,
-			std::string icurline)
-		{
-			std::vector<std::string> sface, svert;
-			Vertex vVert;
-			algorithm::split(algorithm::tail(icurline), sface, " ");
-
-			bool noNormal = false;
-
-			// For every given vertex do this
-			for (int i = 0; i < int(sface.size()); i++)
-			{
-				// See What type the vertex is.
-				int vtype;
-
-				algorithm::split(sface[i], svert, "/");
-
-				// Check for just position - v1
-				if (svert.size() == 1)
-				{
-					// Only position
-					vtype = 1;
-				}
-
-				// Check for position & texture - v1/vt1
-				if (svert.size() == 2)
-				{
-					// Position & Texture
-					vtype = 2;
-				}
-
-				// Check for Position, Texture and Normal - v1/vt1/vn1
-				// or if Position and Normal - v1//vn1
-				if (svert.size() == 3)
-				{
-					if (svert[1] != "")
-					{
-						// Position, Texture, and Normal
-						vtype = 4;
-					}
-					else
-					{
-						// Position & Normal
-						vtype = 3;
-					}
-				}
-
-				// Calculate and store the vertex
-				switch (vtype)
-				{
-				case 1: // P
-				{
-					vVert.Position = algorithm::getElement(iPositions, svert[0]);
-					vVert.TextureCoordinate = Vector2(0, 0);
-					noNormal = true;
-					oVerts.push_back(vVert);
-					break;
-				}
-				case 2: // P/T
-				{
-					vVert.Position = algorithm::getElement(iPositions, svert[0]);
-					vVert.TextureCoordinate = algorithm::getElement(iTCoords, svert[1]);
-					noNormal = true;
-					oVerts.push_back(vVert);
-					break;
-				}
-				case 3: // P//N
-				{
-					vVert.Position = algorithm::getElement(iPositions, svert[0]);
-					vVert.TextureCoordinate = Vector2(0, 0);
-					vVert.Normal = algorithm::getElement(iNormals, svert[2]);
-					oVerts.push_back(vVert);
-					break;
-				}
-				case 4: // P/T/N
-				{
-					vVert.Position = algorithm::getElement(iPositions, svert[0]);
-					vVert.TextureCoordinate = algorithm::getElement(iTCoords, svert[1]);
-					vVert.Normal = algorithm::getElement(iNormals, svert[2]);
-					oVerts.push_back(vVert);
-					break;
-				}
-				default:
-				{
-					break;
-				}
-				}
-			}
-
-			// take care of missing normals
-			// these may not be truly acurate but it is the 
-			// best they get for not compiling a mesh with normals	
-			if (noNormal)
-			{
-				Vector3 A = oVerts[0].Position - oVerts[1].Position;
-				Vector3 B = oVerts[2].Position - oVerts[1].Position;
-
-				Vector3 normal = math::CrossV3(A, B);
-
-				for (int i = 0; i < int(oVerts.size()); i++)
-				{
-					oVerts[i].Normal = normal;
-				}
-			}
-		}
-
-		// Triangulate a list of vertices into a face by printing
-		//	inducies corresponding with triangles within it
-		void VertexTriangluation(std::vector<unsigned int>& oIndices,
-			const std::vector<Vertex>& iVerts)
-		{
-			// If there are 2 or less verts,
-			// no triangle can be created,
-			// so exit
-			if (iVerts.size() < 3)
-			{
-				return;
-			}
-			// If it is a triangle no need to calculate it
-			if (iVerts.size() == 3)
-			{
-				oIndices.push_back(0);
-				oIndices.push_back(1);
-				oIndices.push_back(2);
-				return;
-			}
-
-			// Create a list of vertices
-			std::vector<Vertex> tVerts = iVerts;
-
-			while (true)
-			{
-				// For every vertex
-				for (int i = 0; i < int(tVerts.size()); i++)
-				{
-					// pPrev = the previous vertex in the list
-					Vertex pPrev;
-					if (i == 0)
-					{
-						pPrev = tVerts[tVerts.size() - 1];
-					}
-					else
-					{
-						pPrev = tVerts[i - 1];
-					}
-
-					// pCur = the current vertex;
-					Vertex pCur = tVerts[i];
-
-					// pNext = the next vertex in the list
-					Vertex pNext;
-					if (i == tVerts.size() - 1)
-					{
-						pNext = tVerts[0];
-					}
-					else
-					{
-						pNext = tVerts[i + 1];
-					}
-
-					// Check to see if there are only 3 verts left
-					// if so this is the last triangle
-					if (tVerts.size() == 3)
-					{
-						// Create a triangle from pCur, pPrev, pNext
-						for (int j = 0; j < int(tVerts.size()); j++)
-						{
-							if (iVerts[j].Position == pCur.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == pPrev.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == pNext.Position)
-								oIndices.push_back(j);
-						}
-
-						tVerts.clear();
-						break;
-					}
-					if (tVerts.size() == 4)
-					{
-						// Create a triangle from pCur, pPrev, pNext
-						for (int j = 0; j < int(iVerts.size()); j++)
-						{
-							if (iVerts[j].Position == pCur.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == pPrev.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == pNext.Position)
-								oIndices.push_back(j);
-						}
-
-						Vector3 tempVec;
-						for (int j = 0; j < int(tVerts.size()); j++)
-						{
-							if (tVerts[j].Position != pCur.Position
-								&& tVerts[j].Position != pPrev.Position
-								&& tVerts[j].Position != pNext.Position)
-							{
-								tempVec = tVerts[j].Position;
-								break;
-							}
-						}
-
-						// Create a triangle from pCur, pPrev, pNext
-						for (int j = 0; j < int(iVerts.size()); j++)
-						{
-							if (iVerts[j].Position == pPrev.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == pNext.Position)
-								oIndices.push_back(j);
-							if (iVerts[j].Position == tempVec)
-								oIndices.push_back(j);
-						}
-
-						tVerts.clear();
-						break;
-					}
-
-					// If Vertex is not an interior vertex
-					float angle = math::AngleBetweenV3(pPrev.Position - pCur.Position, pNext.Position - pCur.Position) * (180 / 3.14159265359);
-					if (angle <= 0 && angle >= 180)
-						continue;
-
-					// If any vertices are within this triangle
-					bool inTri = false;
-					for (int j = 0; j < int(iVerts.size()); j++)
-					{
-						if (algorithm::inTriangle(iVerts[j].Position, pPrev.Position, pCur.Position, pNext.Position)
-							&& iVerts[j].Position != pPrev.Position
-							&& iVerts[j].Position != pCur.Position
-							&& iVerts[j].Position != pNext.Position)
-						{
-							inTri = true;
-							break;
-						}
-					}
-					if (inTri)
-						continue;
-
-					// Create a triangle from pCur, pPrev, pNext
-					for (int j = 0; j < int(iVerts.size()); j++)
-					{
-						if (iVerts[j].Position == pCur.Position)
-							oIndices.push_back(j);
-						if (iVerts[j].Position == pPrev.Position)
-							oIndices.push_back(j);
-						if (iVerts[j].Position == pNext.Position)
-							oIndices.push_back(j);
-					}
-
-					// Delete pCur from the list
-					for (int j = 0; j < int(tVerts.size()); j++)
-					{
-						if (tVerts[j].Position == pCur.Position)
-						{
-							tVerts.erase(tVerts.begin() + j);
-							break;
-						}
-					}
-
-					// reset i to the start
-					// -1 since loop will add 1 to it
-					i = -1;
-				}
-
-				// if no triangles were created
-				if (oIndices.size() == 0)
-					break;
-
-				// if no more vertices
-				if (tVerts.size() == 0)
-					break;
-			}
-		}
-
-		// Load Materials from .mtl file
-		bool LoadMaterials(std::string path)
-		{
-			// If the file is not a material file return false
-			if (path.substr(path.size() - 4, path.size()) != ".mtl")
-				return false;
-
-			std::ifstream file(path);
-
-			// If the file is not found return false
-			if (!file.is_open())
-				return false;
-
-			Material tempMaterial;
-
-			bool listening = false;
-
-			// Go through each line looking for material variables
-			std::string curline;
-			while (std::getline(file, curline))
-			{
-				// new material and material name
-				if (algorithm::firstToken(curline) == "newmtl")
-				{
-					if (!listening)
-					{
-						listening = true;
-
-						if (curline.size() > 7)
-						{
-							tempMaterial.name = algorithm::tail(curline);
-						}
-						else
-						{
-							tempMaterial.name = "none";
-						}
-					}
-					else
-					{
-						// Generate the material
-
-						// Push Back loaded Material
-						LoadedMaterials.push_back(tempMaterial);
-
-						// Clear Loaded Material
-						tempMaterial = Material();
-
-						if (curline.size() > 7)
-						{
-							tempMaterial.name = algorithm::tail(curline);
-						}
-						else
-						{
-							tempMaterial.name = "none";
-						}
-					}
-				}
-				// Ambient Color
-				if (algorithm::firstToken(curline) == "Ka")
-				{
-					std::vector<std::string> temp;
-					algorithm::split(algorithm::tail(curline), temp, " ");
-
-					if (temp.size() != 3)
-						continue;
-
-					tempMaterial.Ka.X = std::stof(temp[0]);
-					tempMaterial.Ka.Y = std::stof(temp[1]);
-					tempMaterial.Ka.Z = std::stof(temp[2]);
-				}
-				// Diffuse Color
-				if (algorithm::firstToken(curline) == "Kd")
-				{
-					std::vector<std::string> temp;
-					algorithm::split(algorithm::tail(curline), temp, " ");
-
-					if (temp.size() != 3)
-						continue;
-
-					tempMaterial.Kd.X = std::stof(temp[0]);
-					tempMaterial.Kd.Y = std::stof(temp[1]);
-					tempMaterial.Kd.Z = std::stof(temp[2]);
-				}
-				// Specular Color
-				if (algorithm::firstToken(curline) == "Ks")
-				{
-					std::vector<std::string> temp;
-					algorithm::split(algorithm::tail(curline), temp, " ");
-
-					if (temp.size() != 3)
-						continue;
-
-					tempMaterial.Ks.X = std::stof(temp[0]);
-					tempMaterial.Ks.Y = std::stof(temp[1]);
-					tempMaterial.Ks.Z = std::stof(temp[2]);
-				}
-				// Specular Exponent
-				if (algorithm::firstToken(curline) == "Ns")
-				{
-					tempMaterial.Ns = std::stof(algorithm::tail(curline));
-				}
-				// Optical Density
-				if (algorithm::firstToken(curline) == "Ni")
-				{
-					tempMaterial.Ni = std::stof(algorithm::tail(curline));
-				}
-				// Dissolve
-				if (algorithm::firstToken(curline) == "d")
-				{
-					tempMaterial.d = std::stof(algorithm::tail(curline));
-				}
-				// Illumination
-				if (algorithm::firstToken(curline) == "illum")
-				{
-					tempMaterial.illum = std::stoi(algorithm::tail(curline));
-				}
-				// Ambient Texture Map
-				if (algorithm::firstToken(curline) == "map_Ka")
-				{
-					tempMaterial.map_Ka = algorithm::tail(curline);
-				}
-				// Diffuse Texture Map
-				if (algorithm::firstToken(curline) == "map_Kd")
-				{
-					tempMaterial.map_Kd = algorithm::tail(curline);
-				}
-				// Specular Texture Map
-				if (algorithm::firstToken(curline) == "map_Ks")
-				{
-					tempMaterial.map_Ks = algorithm::tail(curline);
-				}
-				// Specular Hightlight Map
-				if (algorithm::firstToken(curline) == "map_Ns")
-				{
-					tempMaterial.map_Ns = algorithm::tail(curline);
-				}
-				// Alpha Texture Map
-				if (algorithm::firstToken(curline) == "map_d")
-				{
-					tempMaterial.map_d = algorithm::tail(curline);
-				}
-				// Bump Map
-				if (algorithm::firstToken(curline) == "map_Bump" || algorithm::firstToken(curline) == "map_bump" || algorithm::firstToken(curline) == "bump")
-				{
-					tempMaterial.map_bump = algorithm::tail(curline);
-				}
-			}
-
-			// Deal with last material
-
-			// Push Back loaded Material
-			LoadedMaterials.push_back(tempMaterial);
-
-			// Test to see if anything was loaded
-			// If not return false
-			if (LoadedMaterials.empty())
-				return false;
-			// If so return true
-			else
-				return true;
-		}
-	};
+// OBJ_Loader.h - A Single Header OBJ Model Loader
+
+#pragma once
+
+// Iostream - STD I/O Library
+#include <iostream>
+
+// Vector - STD Vector/Array Library
+#include <vector>
+
+// String - STD String Library
+#include <string>
+
+// fStream - STD File I/O Library
+#include <fstream>
+
+// Math.h - STD math Library
+#include <math.h>
+
+// CString - STD Memory Scanning Library
+#include <cstring>
+
+// String View - STD Non-Owning String Library
+#include <string_view>
+
+// Charconv - STD Locale-Free Number Parsing
+#include <charconv>
+
+// Chrono - STD Timing Library
+#include <chrono>
+
+// Thread - STD Threading Library
+#include <thread>
+
+// Algorithm - STD Algorithm Library
+#include <algorithm>
+
+// Unordered Map - STD Hash Map Library
+#include <unordered_map>
+
+// Platform file mapping
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Print progress to console while loading (large models)
+#define OBJL_CONSOLE_OUTPUT
+
+// Namespace: OBJL
+//
+// Description: The namespace that holds eveyrthing that
+//	is needed and used for the OBJ Model Loader
+namespace objl
+{
+	// Structure: Vector2
+	//
+	// Description: A 2D Vector that Holds Positional Data
+	struct Vector2
+	{
+		// Default Constructor
+		Vector2()
+		{
+			X = 0.0f;
+			Y = 0.0f;
+		}
+		// Variable Set Constructor
+		Vector2(float X_, float Y_)
+		{
+			X = X_;
+			Y = Y_;
+		}
+		// Bool Equals Operator Overload
+		bool operator==(const Vector2& other) const
+		{
+			return (this->X == other.X && this->Y == other.Y);
+		}
+		// Bool Not Equals Operator Overload
+		bool operator!=(const Vector2& other) const
+		{
+			return !(this->X == other.X && this->Y == other.Y);
+		}
+		// Addition Operator Overload
+		Vector2 operator+(const Vector2& right) const
+		{
+			return Vector2(this->X + right.X, this->Y + right.Y);
+		}
+		// Subtraction Operator Overload
+		Vector2 operator-(const Vector2& right) const
+		{
+			return Vector2(this->X - right.X, this->Y - right.Y);
+		}
+		// Float Multiplication Operator Overload
+		Vector2 operator*(const float& other) const
+		{
+			return Vector2(this->X * other, this->Y * other);
+		}
+
+		// Positional Variables
+		float X;
+		float Y;
+	};
+
+	// Structure: Vector3
+	//
+	// Description: A 3D Vector that Holds Positional Data
+	struct Vector3
+	{
+		// Default Constructor
+		Vector3()
+		{
+			X = 0.0f;
+			Y = 0.0f;
+			Z = 0.0f;
+		}
+		// Variable Set Constructor
+		Vector3(float X_, float Y_, float Z_)
+		{
+			X = X_;
+			Y = Y_;
+			Z = Z_;
+		}
+		// Bool Equals Operator Overload
+		bool operator==(const Vector3& other) const
+		{
+			return (this->X == other.X && this->Y == other.Y && this->Z == other.Z);
+		}
+		// Bool Not Equals Operator Overload
+		bool operator!=(const Vector3& other) const
+		{
+			return !(this->X == other.X && this->Y == other.Y && this->Z == other.Z);
+		}
+		// Addition Operator Overload
+		Vector3 operator+(const Vector3& right) const
+		{
+			return Vector3(this->X + right.X, this->Y + right.Y, this->Z + right.Z);
+		}
+		// Subtraction Operator Overload
+		Vector3 operator-(const Vector3& right) const
+		{
+			return Vector3(this->X - right.X, this->Y - right.Y, this->Z - right.Z);
+		}
+		// Float Multiplication Operator Overload
+		Vector3 operator*(const float& other) const
+		{
+			return Vector3(this->X * other, this->Y * other, this->Z * other);
+		}
+		// Float Division Operator Overload
+		Vector3 operator/(const float& other) const
+		{
+			return Vector3(this->X / other, this->Y / other, this->Z / other);
+		}
+
+		// Positional Variables
+		float X;
+		float Y;
+		float Z;
+	};
+
+	// Structure: Vertex
+	//
+	// Description: Model Vertex object that holds
+	//	a Position, Normal, and Texture Coordinate
+	struct Vertex
+	{
+		// Position Vector
+		Vector3 Position;
+
+		// Normal Vector
+		Vector3 Normal;
+
+		// Texture Coordinate Vector
+		Vector2 TextureCoordinate;
+	};
+
+	struct Material
+	{
+		Material()
+		{
+			name;
+			Ns = 0.0f;
+			Ni = 0.0f;
+			d = 0.0f;
+			illum = 0;
+		}
+
+		// Material Name
+		std::string name;
+		// Ambient Color
+		Vector3 Ka;
+		// Diffuse Color
+		Vector3 Kd;
+		// Specular Color
+		Vector3 Ks;
+		// Specular Exponent
+		float Ns;
+		// Optical Density
+		float Ni;
+		// Dissolve
+		float d;
+		// Illumination
+		int illum;
+		// Ambient Texture Map
+		std::string map_Ka;
+		// Diffuse Texture Map
+		std::string map_Kd;
+		// Specular Texture Map
+		std::string map_Ks;
+		// Specular Hightlight Map
+		std::string map_Ns;
+		// Alpha Texture Map
+		std::string map_d;
+		// Bump Map
+		std::string map_bump;
+	};
+
+	// Structure: Mesh
+	//
+	// Description: A Simple Mesh Object that holds
+	//	a name, a vertex list, and an index list
+	struct Mesh
+	{
+		// Default Constructor
+		Mesh()
+		{
+
+		}
+		// Variable Set Constructor
+		Mesh(std::vector<Vertex> _Vertices, std::vector<unsigned int> _Indices)
+			: Vertices(std::move(_Vertices)), Indices(std::move(_Indices))
+		{
+
+		}
+		// Mesh Name
+		std::string MeshName;
+		// Vertex List, empty with Loader::StorageMode::Arena
+		std::vector<Vertex> Vertices;
+		// Index List, empty with Loader::StorageMode::Arena
+		std::vector<unsigned int> Indices;
+
+		// Range of this mesh in Loader::LoadedVertices and
+		//	Loader::LoadedIndices, whose indices already
+		//	include VertexOffset
+		size_t VertexOffset = 0;
+		size_t VertexCount = 0;
+		size_t IndexOffset = 0;
+		size_t IndexCount = 0;
+
+		// Material
+		Material MeshMaterial;
+	};
+
+	// Namespace: Math
+	//
+	// Description: The namespace that holds all of the math
+	//	functions need for OBJL
+	namespace math
+	{
+		// Vector3 Cross Product
+		inline Vector3 CrossV3(const Vector3 a, const Vector3 b)
+		{
+			return Vector3(a.Y * b.Z - a.Z * b.Y,
+				a.Z * b.X - a.X * b.Z,
+				a.X * b.Y - a.Y * b.X);
+		}
+
+		// Vector3 Magnitude Calculation
+		inline float MagnitudeV3(const Vector3 in)
+		{
+			return (sqrtf(powf(in.X, 2) + powf(in.Y, 2) + powf(in.Z, 2)));
+		}
+
+		// Vector3 DotProduct
+		inline float DotV3(const Vector3 a, const Vector3 b)
+		{
+			return (a.X * b.X) + (a.Y * b.Y) + (a.Z * b.Z);
+		}
+
+		// Angle between 2 Vector3 Objects
+		inline float AngleBetweenV3(const Vector3 a, const Vector3 b)
+		{
+			float angle = DotV3(a, b);
+			angle /= (MagnitudeV3(a) * MagnitudeV3(b));
+			return angle = acosf(angle);
+		}
+
+		// Projection Calculation of a onto b
+		inline Vector3 ProjV3(const Vector3 a, const Vector3 b)
+		{
+			Vector3 bn = b / MagnitudeV3(b);
+			return bn * DotV3(a, bn);
+		}
+	}
+
+	// Namespace: Algorithm
+	//
+	// Description: The namespace that holds all of the
+	// Algorithms needed for OBJL
+	namespace algorithm
+	{
+		// Vector3 Multiplication Opertor Overload
+		inline Vector3 operator*(const float& left, const Vector3& right)
+		{
+			return Vector3(right.X * left, right.Y * left, right.Z * left);
+		}
+
+		// A test to see if P1 is on the same side as P2 of a line segment ab
+		inline bool SameSide(Vector3 p1, Vector3 p2, Vector3 a, Vector3 b)
+		{
+			Vector3 cp1 = math::CrossV3(b - a, p1 - a);
+			Vector3 cp2 = math::CrossV3(b - a, p2 - a);
+
+			if (math::DotV3(cp1, cp2) >= 0)
+				return true;
+			else
+				return false;
+		}
+
+		// Generate a cross produect normal for a triangle
+		inline Vector3 GenTriNormal(Vector3 t1, Vector3 t2, Vector3 t3)
+		{
+			Vector3 u = t2 - t1;
+			Vector3 v = t3 - t1;
+
+			Vector3 normal = math::CrossV3(u, v);
+
+			return normal;
+		}
+
+		// Check to see if a Vector3 Point is within a 3 Vector3 Triangle
+		inline bool inTriangle(Vector3 point, Vector3 tri1, Vector3 tri2, Vector3 tri3)
+		{
+			// Test to see if it is within an infinite prism that the triangle outlines.
+			bool within_tri_prisim = SameSide(point, tri1, tri2, tri3) && SameSide(point, tri2, tri1, tri3)
+				&& SameSide(point, tri3, tri1, tri2);
+
+			// If it isn't it will never be on the triangle
+			if (!within_tri_prisim)
+				return false;
+
+			// Calulate Triangle's Normal
+			Vector3 n = GenTriNormal(tri1, tri2, tri3);
+
+			// Project the point onto this normal
+			Vector3 proj = math::ProjV3(point, n);
+
+			// If the distance from the triangle to the point is 0
+			//	it lies on the triangle
+			if (math::MagnitudeV3(proj) == 0)
+				return true;
+			else
+				return false;
+		}
+
+		// Split a String into a string array at a given token
+		inline void split(const std::string& in,
+			std::vector<std::string>& out,
+			std::string token)
+		{
+			out.clear();
+
+			std::string temp;
+
+			for (int i = 0; i < int(in.size()); i++)
+			{
+				std::string test = in.substr(i, token.size());
+
+				if (test == token)
+				{
+					if (!temp.empty())
+					{
+						out.push_back(temp);
+						temp.clear();
+						i += (int)token.size() - 1;
+					}
+					else
+					{
+						out.push_back("");
+					}
+				}
+				else if (i + token.size() >= in.size())
+				{
+					temp += in.substr(i, token.size());
+					out.push_back(temp);
+					break;
+				}
+				else
+				{
+					temp += in[i];
+				}
+			}
+		}
+
+		// Get tail of string after first token and possibly following spaces
+		inline std::string tail(const std::string& in)
+		{
+			size_t token_start = in.find_first_not_of(" \t");
+			size_t space_start = in.find_first_of(" \t", token_start);
+			size_t tail_start = in.find_first_not_of(" \t", space_start);
+			size_t tail_end = in.find_last_not_of(" \t");
+			if (tail_start != std::string::npos && tail_end != std::string::npos)
+			{
+				return in.substr(tail_start, tail_end - tail_start + 1);
+			}
+			else if (tail_start != std::string::npos)
+			{
+				return in.substr(tail_start);
+			}
+			return "";
+		}
+
+		// Get first token of string
+		inline std::string firstToken(const std::string& in)
+		{
+			if (!in.empty())
+			{
+				size_t token_start = in.find_first_not_of(" \t");
+				size_t token_end = in.find_first_of(" \t", token_start);
+				if (token_start != std::string::npos && token_end != std::string::npos)
+				{
+					return in.substr(token_start, token_end - token_start);
+				}
+				else if (token_start != std::string::npos)
+				{
+					return in.substr(token_start);
+				}
+			}
+			return "";
+		}
+
+		// Get element at given index position
+		template <class T>
+		inline const T& getElement(const std::vector<T>& elements, std::string& index)
+		{
+			int idx = std::stoi(index);
+			if (idx < 0)
+				idx = int(elements.size()) + idx;
+			else
+				idx--;
+			return elements[idx];
+		}
+
+		// Whitespace test used by the mapped parser
+		inline bool isSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		// Advance a cursor past spaces and tabs
+		inline const char* skipSpace(const char* p, const char* end)
+		{
+			while (p < end && isSpace(*p))
+				p++;
+			return p;
+		}
+
+		// Get tail of a line after the first token without copying
+		inline std::string_view tailView(std::string_view in)
+		{
+			const char* p = in.data();
+			const char* end = p + in.size();
+
+			p = skipSpace(p, end);
+			while (p < end && !isSpace(*p))
+				p++;
+			p = skipSpace(p, end);
+
+			while (end > p && isSpace(end[-1]))
+				end--;
+
+			return std::string_view(p, end - p);
+		}
+
+		// Get first token of a line without copying
+		inline std::string_view firstTokenView(std::string_view in)
+		{
+			const char* p = in.data();
+			const char* end = p + in.size();
+
+			p = skipSpace(p, end);
+			const char* tokenEnd = p;
+			while (tokenEnd < end && !isSpace(*tokenEnd))
+				tokenEnd++;
+
+			return std::string_view(p, tokenEnd - p);
+		}
+
+		// Parse a float at the cursor and advance past it
+		inline bool parseFloat(const char*& p, const char* end, float& out)
+		{
+			p = skipSpace(p, end);
+			if (p < end && *p == '+')
+				p++;
+
+			std::from_chars_result res = std::from_chars(p, end, out);
+			if (res.ec != std::errc())
+				return false;
+
+			p = res.ptr;
+			return true;
+		}
+
+		// Parse an integer at the cursor and advance past it
+		inline bool parseInt(const char*& p, const char* end, int& out)
+		{
+			if (p < end && *p == '+')
+				p++;
+
+			std::from_chars_result res = std::from_chars(p, end, out);
+			if (res.ec != std::errc())
+				return false;
+
+			p = res.ptr;
+			return true;
+		}
+
+		// Structure: FaceCorner
+		//
+		// Description: The raw v/vt/vn indices of one face vertex
+		struct FaceCorner
+		{
+			int Position = 0;
+			int TexCoord = 0;
+			int Normal = 0;
+
+			bool HasTexCoord = false;
+			bool HasNormal = false;
+		};
+
+		// Structure: VertexKey
+		//
+		// Description: The resolved position, texture coordinate
+		//	and normal indices a vertex was built from, used to
+		//	weld identical face corners into one vertex
+		struct VertexKey
+		{
+			int Position = -1;
+			int TexCoord = -1;
+			int Normal = -1;
+
+			bool operator==(const VertexKey& other) const
+			{
+				return Position == other.Position && TexCoord == other.TexCoord && Normal == other.Normal;
+			}
+		};
+
+		// Hash for VertexKey
+		struct VertexKeyHash
+		{
+			size_t operator()(const VertexKey& key) const
+			{
+				size_t h = size_t(unsigned(key.Position)) * 0x9E3779B97F4A7C15ull;
+				h ^= size_t(unsigned(key.TexCoord)) + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+				h ^= size_t(unsigned(key.Normal)) + 0x94D049BB133111EBull + (h << 6) + (h >> 2);
+				return h;
+			}
+		};
+
+		// Parse the v, v/vt, v//vn or v/vt/vn corners of a face line tail
+		//
+		// Malformed corners are skipped
+		inline void parseFaceCorners(std::string_view iface, std::vector<FaceCorner>& out)
+		{
+			const char* p = iface.data();
+			const char* end = p + iface.size();
+
+			while ((p = skipSpace(p, end)) < end)
+			{
+				FaceCorner corner;
+
+				bool valid = parseInt(p, end, corner.Position);
+
+				if (valid && p < end && *p == '/')
+				{
+					p++;
+					if (p < end && *p != '/')
+						corner.HasTexCoord = valid = parseInt(p, end, corner.TexCoord);
+
+					if (valid && p < end && *p == '/')
+					{
+						p++;
+						corner.HasNormal = valid = parseInt(p, end, corner.Normal);
+					}
+				}
+
+				// Skip to the next corner on a malformed one
+				while (p < end && !isSpace(*p))
+				{
+					p++;
+					valid = false;
+				}
+
+				if (valid)
+					out.push_back(corner);
+			}
+		}
+
+		// Resolve a 1-based or negative OBJ index against an element count
+		//
+		// Returns -1 if the index is out of range
+		inline int resolveIndex(int idx, size_t count)
+		{
+			if (idx < 0)
+				idx = int(count) + idx;
+			else
+				idx--;
+
+			if (idx < 0 || idx >= int(count))
+				return -1;
+			return idx;
+		}
+	}
+
+	// Namespace: Triangulation
+	//
+	// Description: Index-only polygon triangulation used for
+	//	faces with more than 3 vertices
+	namespace triangulation
+	{
+		// Polygon normal by Newell's method, robust for
+		//	non-planar and partly collinear polygons
+		inline Vector3 PolygonNormal(const Vertex* iVerts, size_t count)
+		{
+			Vector3 normal;
+			for (size_t i = 0, j = count - 1; i < count; j = i++)
+			{
+				const Vector3& a = iVerts[j].Position;
+				const Vector3& b = iVerts[i].Position;
+
+				normal.X += (a.Y - b.Y) * (a.Z + b.Z);
+				normal.Y += (a.Z - b.Z) * (a.X + b.X);
+				normal.Z += (a.X - b.X) * (a.Y + b.Y);
+			}
+			return normal;
+		}
+
+		// Check if every corner turns the same way around the normal
+		inline bool IsConvex(const Vertex* iVerts, size_t count, const Vector3& normal)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const Vector3& prev = iVerts[i == 0 ? count - 1 : i - 1].Position;
+				const Vector3& cur = iVerts[i].Position;
+				const Vector3& next = iVerts[i + 1 == count ? 0 : i + 1].Position;
+
+				if (math::DotV3(math::CrossV3(cur - prev, next - cur), normal) < 0.0f)
+					return false;
+			}
+			return true;
+		}
+
+		// Fan from the first vertex, O(n)
+		inline void Fan(std::vector<unsigned int>& oIndices, size_t count)
+		{
+			for (unsigned int i = 1; i + 1 < count; i++)
+			{
+				oIndices.push_back(0);
+				oIndices.push_back(i);
+				oIndices.push_back(i + 1);
+			}
+		}
+
+		// Twice the signed area of the 2D triangle abc
+		inline float Area2(const Vector2& a, const Vector2& b, const Vector2& c)
+		{
+			return (b.X - a.X) * (c.Y - a.Y) - (c.X - a.X) * (b.Y - a.Y);
+		}
+
+		// Check if p lies inside or on the counter-clockwise triangle abc
+		inline bool InTriangle2(const Vector2& p, const Vector2& a, const Vector2& b, const Vector2& c)
+		{
+			return Area2(a, b, p) >= 0.0f && Area2(b, c, p) >= 0.0f && Area2(c, a, p) >= 0.0f;
+		}
+
+		// Ear clipping over index links, testing ears only
+		//	against the reflex vertices still in the polygon
+		inline void EarClip(std::vector<unsigned int>& oIndices, const Vertex* iVerts, size_t count, const Vector3& normal)
+		{
+			thread_local std::vector<Vector2> points;
+			thread_local std::vector<unsigned int> prev, next;
+			thread_local std::vector<unsigned int> reflex;
+			thread_local std::vector<char> isReflex;
+
+			points.resize(count);
+			prev.resize(count);
+			next.resize(count);
+			isReflex.assign(count, 0);
+			reflex.clear();
+
+			// Project onto the plane of the dominant normal axis,
+			//	keeping the polygon counter-clockwise
+			float ax = fabsf(normal.X), ay = fabsf(normal.Y), az = fabsf(normal.Z);
+			for (size_t i = 0; i < count; i++)
+			{
+				const Vector3& p = iVerts[i].Position;
+				if (az >= ax && az >= ay)
+					points[i] = normal.Z >= 0.0f ? Vector2(p.X, p.Y) : Vector2(p.Y, p.X);
+				else if (ax >= ay)
+					points[i] = normal.X >= 0.0f ? Vector2(p.Y, p.Z) : Vector2(p.Z, p.Y);
+				else
+					points[i] = normal.Y >= 0.0f ? Vector2(p.Z, p.X) : Vector2(p.X, p.Z);
+
+				prev[i] = unsigned(i == 0 ? count - 1 : i - 1);
+				next[i] = unsigned(i + 1 == count ? 0 : i + 1);
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				if (Area2(points[prev[i]], points[i], points[next[i]]) <= 0.0f)
+				{
+					isReflex[i] = 1;
+					reflex.push_back(i);
+				}
+			}
+
+			size_t remaining = count;
+			unsigned int cur = 0;
+			size_t sinceLastEar = 0;
+
+			while (remaining > 3)
+			{
+				unsigned int p = prev[cur], n = next[cur];
+
+				bool ear = !isReflex[cur];
+				for (size_t r = 0; ear && r < reflex.size(); r++)
+				{
+					unsigned int v = reflex[r];
+					if (v != p && v != cur && v != n && InTriangle2(points[v], points[p], points[cur], points[n]))
+						ear = false;
+				}
+
+				// Degenerate or self-intersecting polygons may have
+				//	no ear left; clip anyway so the loop terminates
+				if (!ear && sinceLastEar < remaining)
+				{
+					cur = n;
+					sinceLastEar++;
+					continue;
+				}
+
+				oIndices.push_back(p);
+				oIndices.push_back(cur);
+				oIndices.push_back(n);
+
+				next[p] = n;
+				prev[n] = p;
+				remaining--;
+				sinceLastEar = 0;
+
+				if (isReflex[cur])
+				{
+					isReflex[cur] = 0;
+					reflex.erase(std::find(reflex.begin(), reflex.end(), cur));
+				}
+
+				// Clipping can only turn a neighbouring reflex vertex convex
+				for (unsigned int v : { p, n })
+				{
+					if (isReflex[v] && Area2(points[prev[v]], points[v], points[next[v]]) > 0.0f)
+					{
+						isReflex[v] = 0;
+						reflex.erase(std::find(reflex.begin(), reflex.end(), v));
+					}
+				}
+
+				cur = n;
+			}
+
+			oIndices.push_back(prev[cur]);
+			oIndices.push_back(cur);
+			oIndices.push_back(next[cur]);
+		}
+
+		// Triangulate a polygon into indices relative to its first vertex
+		inline void Triangulate(std::vector<unsigned int>& oIndices, const Vertex* iVerts, size_t count)
+		{
+			if (count < 3)
+				return;
+
+			if (count == 3)
+			{
+				oIndices.push_back(0);
+				oIndices.push_back(1);
+				oIndices.push_back(2);
+				return;
+			}
+
+			Vector3 normal = PolygonNormal(iVerts, count);
+
+			if (IsConvex(iVerts, count, normal) || math::MagnitudeV3(normal) == 0.0f)
+				Fan(oIndices, count);
+			else
+				EarClip(oIndices, iVerts, count, normal);
+		}
+	}
+
+	// Class: MappedFile
+	//
+	// Description: A read-only view of a whole file
+	//	mapped into memory
+	class MappedFile
+	{
+	public:
+		MappedFile()
+		{
+
+		}
+		~MappedFile()
+		{
+			Close();
+		}
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// Map a file into memory
+		//
+		// An empty file maps successfully with a null Data()
+		bool Open(const std::string& Path)
+		{
+			Close();
+
+#ifdef _WIN32
+			hFile = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+			if (hFile == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(hFile, &fileSize))
+			{
+				Close();
+				return false;
+			}
+			size = size_t(fileSize.QuadPart);
+
+			if (size == 0)
+				return true;
+
+			hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (hMapping == NULL)
+			{
+				Close();
+				return false;
+			}
+
+			data = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+			fd = open(Path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return false;
+
+			struct stat st;
+			if (fstat(fd, &st) != 0)
+			{
+				Close();
+				return false;
+			}
+			size = size_t(st.st_size);
+
+			if (size == 0)
+				return true;
+
+			void* view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view == MAP_FAILED)
+			{
+				Close();
+				return false;
+			}
+			madvise(view, size, MADV_SEQUENTIAL);
+			data = static_cast<const char*>(view);
+#endif
+
+			if (data == nullptr)
+			{
+				Close();
+				return false;
+			}
+			return true;
+		}
+
+		// Unmap the file and release its handles
+		void Close()
+		{
+#ifdef _WIN32
+			if (data)
+				UnmapViewOfFile(data);
+			if (hMapping != NULL)
+				CloseHandle(hMapping);
+			if (hFile != INVALID_HANDLE_VALUE)
+				CloseHandle(hFile);
+			hMapping = NULL;
+			hFile = INVALID_HANDLE_VALUE;
+#else
+			if (data)
+				munmap(const_cast<char*>(data), size);
+			if (fd >= 0)
+				close(fd);
+			fd = -1;
+#endif
+			data = nullptr;
+			size = 0;
+		}
+
+		const char* Data() const
+		{
+			return data;
+		}
+
+		size_t Size() const
+		{
+			return size;
+		}
+
+	private:
+		const char* data = nullptr;
+		size_t size = 0;
+
+#ifdef _WIN32
+		HANDLE hFile = INVALID_HANDLE_VALUE;
+		HANDLE hMapping = NULL;
+#else
+		int fd = -1;
+#endif
+	};
+
+	// Structure: LoadStats
+	//
+	// Description: Timing of the last Loader call, used to
+	//	compare the throughput of the parse modes
+	struct LoadStats
+	{
+		// Size of the parsed .obj file
+		size_t Bytes = 0;
+		// Wall time spent parsing and building meshes
+		double Seconds = 0.0;
+		// Face corners read, one vertex each without welding
+		size_t CornerCount = 0;
+		// Vertices emitted into LoadedVertices
+		size_t VertexCount = 0;
+
+		// Vertex memory saved by welding
+		size_t WeldedBytesSaved() const
+		{
+			return (CornerCount - VertexCount) * sizeof(Vertex);
+		}
+
+		// Parse throughput in megabytes per second
+		double ThroughputMBs() const
+		{
+			return Seconds > 0.0 ? (double(Bytes) / (1024.0 * 1024.0)) / Seconds : 0.0;
+		}
+	};
+
+	// Class: Loader
+	//
+	// Description: The OBJ Model Loader
+	class Loader
+	{
+	public:
+		// Default Constructor
+		Loader()
+		{
+
+		}
+		~Loader()
+		{
+			LoadedMeshes.clear();
+		}
+
+		// Load a file into the loader
+		//
+		// If file is loaded return true
+		//
+		// If the file is unable to be found
+		// or unable to be loaded return false
+		bool LoadFile(std::string Path)
+		{
+			// If the file is not an .obj file return false
+			if (Path.size() < 4 || Path.substr(Path.size() - 4, 4) != ".obj")
+				return false;
+
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			std::ifstream file(Path);
+
+			if (!file.is_open())
+				return false;
+
+			LoadedMeshes.clear();
+			LoadedVertices.clear();
+			LoadedIndices.clear();
+
+			std::vector<Vector3> Positions;
+			std::vector<Vector2> TCoords;
+			std::vector<Vector3> Normals;
+
+			BuildState state;
+			size_t bytesRead = 0;
+
+#ifdef OBJL_CONSOLE_OUTPUT
+			const unsigned int outputEveryNth = 1000;
+			unsigned int outputIndicator = outputEveryNth;
+#endif
+
+			std::string curline;
+			while (std::getline(file, curline))
+			{
+				bytesRead += curline.size() + 1;
+
+#ifdef OBJL_CONSOLE_OUTPUT
+				if ((outputIndicator = ((outputIndicator + 1) % outputEveryNth)) == 1)
+				{
+					if (!state.meshname.empty())
+					{
+						std::cout
+							<< "\r- " << state.meshname
+							<< "\t| vertices > " << Positions.size()
+							<< "\t| texcoords > " << TCoords.size()
+							<< "\t| normals > " << Normals.size()
+							<< "\t| triangles > " << (state.VertexCount / 3)
+							<< (!state.MeshMatNames.empty() ? "\t| material: " + state.MeshMatNames.back() : "");
+					}
+				}
+#endif
+
+				// Generate a Mesh Object or Prepare for an object to be created
+				if (algorithm::firstToken(curline) == "o" || algorithm::firstToken(curline) == "g" || curline[0] == 'g')
+				{
+					bool named = algorithm::firstToken(curline) == "o" || algorithm::firstToken(curline) == "g";
+					BeginGroup(state, named, algorithm::tail(curline));
+#ifdef OBJL_CONSOLE_OUTPUT
+					std::cout << std::endl;
+					outputIndicator = 0;
+#endif
+				}
+				// Generate a Vertex Position
+				if (algorithm::firstToken(curline) == "v")
+				{
+					std::vector<std::string> spos;
+					Vector3 vpos;
+					algorithm::split(algorithm::tail(curline), spos, " ");
+
+					vpos.X = std::stof(spos[0]);
+					vpos.Y = std::stof(spos[1]);
+					vpos.Z = std::stof(spos[2]);
+
+					Positions.push_back(vpos);
+				}
+				// Generate a Vertex Texture Coordinate
+				if (algorithm::firstToken(curline) == "vt")
+				{
+					std::vector<std::string> stex;
+					Vector2 vtex;
+					algorithm::split(algorithm::tail(curline), stex, " ");
+
+					vtex.X = std::stof(stex[0]);
+					vtex.Y = std::stof(stex[1]);
+
+					TCoords.push_back(vtex);
+				}
+				// Generate a Vertex Normal;
+				if (algorithm::firstToken(curline) == "vn")
+				{
+					std::vector<std::string> snor;
+					Vector3 vnor;
+					algorithm::split(algorithm::tail(curline), snor, " ");
+
+					vnor.X = std::stof(snor[0]);
+					vnor.Y = std::stof(snor[1]);
+					vnor.Z = std::stof(snor[2]);
+
+					Normals.push_back(vnor);
+				}
+				// Generate a Face (vertices & indices)
+				if (algorithm::firstToken(curline) == "f")
+				{
+					// Generate the vertices
+					std::vector<Vertex> vVerts;
+					GenVerticesFromRawOBJ(vVerts, Positions, TCoords, Normals, curline);
+
+					std::vector<unsigned int> iIndices;
+					AddFace(state, vVerts, iIndices);
+				}
+				// Get Mesh Material Name
+				if (algorithm::firstToken(curline) == "usemtl")
+				{
+					UseMaterial(state, algorithm::tail(curline));
+
+#ifdef OBJL_CONSOLE_OUTPUT
+					outputIndicator = 0;
+#endif
+				}
+				// Load Materials
+				if (algorithm::firstToken(curline) == "mtllib")
+				{
+					LoadMaterialLibrary(Path, algorithm::tail(curline));
+				}
+			}
+
+#ifdef OBJL_CONSOLE_OUTPUT
+			std::cout << std::endl;
+#endif
+
+			file.close();
+
+			return FinishLoad(state, bytesRead, startTime);
+		}
+
+		// Load a file into the loader through a memory mapping
+		//
+		// Produces the same meshes and materials as LoadFile,
+		//	but tokenizes the mapped bytes in place and parses
+		//	numbers without building intermediate strings
+		//
+		// If the file is unable to be found
+		// or unable to be loaded return false
+		bool LoadFileMapped(std::string Path)
+		{
+			// If the file is not an .obj file return false
+			if (Path.size() < 4 || Path.substr(Path.size() - 4, 4) != ".obj")
+				return false;
+
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			MappedFile file;
+
+			if (!file.Open(Path))
+				return false;
+
+			LoadedMeshes.clear();
+			LoadedVertices.clear();
+			LoadedIndices.clear();
+
+			std::vector<Vector3> Positions;
+			std::vector<Vector2> TCoords;
+			std::vector<Vector3> Normals;
+
+			BuildState state;
+
+			// Reused for every face to avoid per-line allocations
+			std::vector<algorithm::FaceCorner> corners;
+			std::vector<algorithm::VertexKey> keys;
+			std::vector<Vertex> vVerts;
+			std::vector<unsigned int> iIndices;
+
+			const char* cur = file.Data();
+			const char* end = cur + file.Size();
+
+			while (cur < end)
+			{
+				const char* lineEnd = static_cast<const char*>(memchr(cur, '\n', end - cur));
+				if (lineEnd == nullptr)
+					lineEnd = end;
+
+				std::string_view rawline(cur, lineEnd - cur);
+				cur = lineEnd + (lineEnd < end ? 1 : 0);
+
+				const char* p = algorithm::skipSpace(rawline.data(), lineEnd);
+				if (p == lineEnd)
+					continue;
+
+				// Dispatch once on the first byte of the line
+				std::string_view token = algorithm::firstTokenView(rawline);
+				switch (*p)
+				{
+				case 'v':
+				{
+					const char* q = p + token.size();
+					if (token.size() == 1)
+					{
+						// Generate a Vertex Position
+						Vector3 vpos;
+						algorithm::parseFloat(q, lineEnd, vpos.X);
+						algorithm::parseFloat(q, lineEnd, vpos.Y);
+						algorithm::parseFloat(q, lineEnd, vpos.Z);
+
+						Positions.push_back(vpos);
+					}
+					else if (token == "vt")
+					{
+						// Generate a Vertex Texture Coordinate
+						Vector2 vtex;
+						algorithm::parseFloat(q, lineEnd, vtex.X);
+						algorithm::parseFloat(q, lineEnd, vtex.Y);
+
+						TCoords.push_back(vtex);
+					}
+					else if (token == "vn")
+					{
+						// Generate a Vertex Normal
+						Vector3 vnor;
+						algorithm::parseFloat(q, lineEnd, vnor.X);
+						algorithm::parseFloat(q, lineEnd, vnor.Y);
+						algorithm::parseFloat(q, lineEnd, vnor.Z);
+
+						Normals.push_back(vnor);
+					}
+					break;
+				}
+				case 'f':
+				{
+					// Generate a Face (vertices & indices)
+					if (token.size() == 1)
+					{
+						corners.clear();
+						keys.clear();
+						vVerts.clear();
+						iIndices.clear();
+						algorithm::parseFaceCorners(algorithm::tailView(rawline), corners);
+						GenVerticesFromCorners(vVerts, corners.data(), corners.size(), Positions, TCoords, Normals,
+							Positions.size(), TCoords.size(), Normals.size(), WeldVertices ? &keys : nullptr);
+						AddFace(state, vVerts, iIndices, WeldVertices ? keys.data() : nullptr);
+					}
+					break;
+				}
+				case 'u':
+				{
+					// Get Mesh Material Name
+					if (token == "usemtl")
+						UseMaterial(state, std::string(algorithm::tailView(rawline)));
+					break;
+				}
+				case 'm':
+				{
+					// Load Materials
+					if (token == "mtllib")
+						LoadMaterialLibrary(Path, std::string(algorithm::tailView(rawline)));
+					break;
+				}
+				default:
+					break;
+				}
+
+				// Generate a Mesh Object or Prepare for an object to be created
+				if (token == "o" || token == "g" || rawline[0] == 'g')
+				{
+					BeginGroup(state, token == "o" || token == "g", std::string(algorithm::tailView(rawline)));
+				}
+			}
+
+			size_t bytesRead = file.Size();
+			file.Close();
+
+			return FinishLoad(state, bytesRead, startTime);
+		}
+
+		// Load a file into the loader on several threads
+		//
+		// The mapped file is split at line boundaries into one
+		//	chunk per thread. Every chunk parses and triangulates
+		//	its own v/vt/vn/f records, then a serial merge replays
+		//	the chunks in file order, resolving negative indices
+		//	and o/g/usemtl boundaries, so the result is identical
+		//	to LoadFile and LoadFileMapped
+		//
+		// ThreadCount of 0 uses every hardware thread
+		//
+		// If the file is unable to be found
+		// or unable to be loaded return false
+		bool LoadFileParallel(std::string Path, unsigned int ThreadCount = 0)
+		{
+			// If the file is not an .obj file return false
+			if (Path.size() < 4 || Path.substr(Path.size() - 4, 4) != ".obj")
+				return false;
+
+			std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+			MappedFile file;
+
+			if (!file.Open(Path))
+				return false;
+
+			LoadedMeshes.clear();
+			LoadedVertices.clear();
+			LoadedIndices.clear();
+
+			if (ThreadCount == 0)
+				ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+			// Split the file into chunks that end on a newline
+			std::vector<ParseChunk> chunks(ThreadCount);
+
+			const char* data = file.Data();
+			const char* dataEnd = data + file.Size();
+			const char* chunkStart = data;
+
+			for (unsigned int i = 0; i < ThreadCount; i++)
+			{
+				const char* chunkEnd = data + file.Size() * (i + 1) / ThreadCount;
+
+				if (chunkEnd <= chunkStart)
+				{
+					chunkEnd = chunkStart;
+				}
+				else if (chunkEnd < dataEnd && chunkEnd[-1] != '\n')
+				{
+					const char* lineEnd = static_cast<const char*>(memchr(chunkEnd, '\n', dataEnd - chunkEnd));
+					chunkEnd = lineEnd ? lineEnd + 1 : dataEnd;
+				}
+
+				chunks[i].Begin = chunkStart;
+				chunks[i].End = chunkEnd;
+				chunkStart = chunkEnd;
+			}
+
+			// Parse every chunk independently
+			RunParallel(ThreadCount, [&](unsigned int i)
+				{
+					ParseChunkLines(chunks[i]);
+				});
+
+			// Lay the chunks' attributes out back to back
+			std::vector<Vector3> Positions;
+			std::vector<Vector2> TCoords;
+			std::vector<Vector3> Normals;
+
+			size_t totalPositions = 0, totalTCoords = 0, totalNormals = 0;
+			for (ParseChunk& chunk : chunks)
+			{
+				chunk.PosBase = totalPositions;
+				chunk.TexBase = totalTCoords;
+				chunk.NorBase = totalNormals;
+
+				totalPositions += chunk.Positions.size();
+				totalTCoords += chunk.TCoords.size();
+				totalNormals += chunk.Normals.size();
+			}
+
+			Positions.resize(totalPositions);
+			TCoords.resize(totalTCoords);
+			Normals.resize(totalNormals);
+
+			RunParallel(ThreadCount, [&](unsigned int i)
+				{
+					ParseChunk& chunk = chunks[i];
+
+					std::copy(chunk.Positions.begin(), chunk.Positions.end(), Positions.begin() + chunk.PosBase);
+					std::copy(chunk.TCoords.begin(), chunk.TCoords.end(), TCoords.begin() + chunk.TexBase);
+					std::copy(chunk.Normals.begin(), chunk.Normals.end(), Normals.begin() + chunk.NorBase);
+
+					chunk.Positions = std::vector<Vector3>();
+					chunk.TCoords = std::vector<Vector2>();
+					chunk.Normals = std::vector<Vector3>();
+				});
+
+			// Resolve and triangulate every chunk's faces against the global attributes
+			RunParallel(ThreadCount, [&](unsigned int i)
+				{
+					BuildChunkFaces(chunks[i], Positions, TCoords, Normals);
+				});
+
+			// Deterministic merge in file order
+			size_t totalVertices = 0, totalIndices = 0;
+			for (ParseChunk& chunk : chunks)
+			{
+				totalVertices += chunk.Vertices.size();
+				totalIndices += chunk.Indices.size();
+			}
+			if (Storage != StorageMode::PerMesh)
+			{
+				LoadedVertices.reserve(totalVertices);
+				LoadedIndices.reserve(totalIndices);
+			}
+
+			BuildState state;
+
+			for (ParseChunk& chunk : chunks)
+			{
+				size_t e = 0;
+				for (size_t f = 0; f <= chunk.Faces.size(); f++)
+				{
+					// Replay the o/g, usemtl and mtllib lines that preceded this face
+					for (; e < chunk.Events.size() && chunk.Events[e].FaceIndex == f; e++)
+					{
+						const ChunkEvent& ev = chunk.Events[e];
+
+						if (ev.Type == ChunkEvent::EventGroup)
+							BeginGroup(state, ev.Named, ev.Name);
+						else if (ev.Type == ChunkEvent::EventUseMaterial)
+							UseMaterial(state, ev.Name);
+						else
+							LoadMaterialLibrary(Path, ev.Name);
+					}
+
+					if (f == chunk.Faces.size())
+						break;
+
+					const ChunkFace& face = chunk.Faces[f];
+					AppendFace(state, chunk.Vertices.data() + face.VertStart, face.VertCount,
+						chunk.Indices.data() + face.IndStart, face.IndCount,
+						WeldVertices ? chunk.Keys.data() + face.VertStart : nullptr);
+				}
+
+				chunk = ParseChunk();
+			}
+
+			size_t bytesRead = file.Size();
+			file.Close();
+
+			return FinishLoad(state, bytesRead, startTime);
+		}
+
+		// Loaded Mesh Objects
+		std::vector<Mesh> LoadedMeshes;
+		// Loaded Vertex Objects
+		std::vector<Vertex> LoadedVertices;
+		// Loaded Index Positions
+		std::vector<unsigned int> LoadedIndices;
+		// Loaded Material Objects
+		std::vector<Material> LoadedMaterials;
+		// Timing of the last load
+		LoadStats LastLoadStats;
+
+		// Where the loaded vertex and index data is kept
+		enum class StorageMode
+		{
+			// Every Mesh owns its data and the whole model is
+			//	also in LoadedVertices / LoadedIndices
+			Full,
+			// Only LoadedVertices / LoadedIndices hold data,
+			//	meshes are views given by their offsets and counts
+			Arena,
+			// Only the meshes hold data, LoadedVertices and
+			//	LoadedIndices stay empty
+			PerMesh
+		};
+		StorageMode Storage = StorageMode::Full;
+
+		// Weld face corners that share the same v/vt/vn indices
+		//	into one vertex, so Mesh::Indices actually reuse
+		//	vertices. Applies to LoadFileMapped and LoadFileParallel
+		//
+		// Corners of faces without normals get a generated face
+		//	normal and are never welded
+		bool WeldVertices = false;
+
+	private:
+		// Mesh assembly state shared by every parse mode
+		struct BuildState
+		{
+			// Current mesh data, unused in Arena storage
+			std::vector<Vertex> Vertices;
+			std::vector<unsigned int> Indices;
+
+			// Size of the current mesh in every storage mode
+			size_t VertexCount = 0;
+			size_t IndexCount = 0;
+
+			// Vertices and indices emitted before the current mesh
+			size_t VertexBase = 0;
+			size_t IndexBase = 0;
+
+			std::vector<std::string> MeshMatNames;
+
+			bool listening = false;
+			std::string meshname;
+
+			// Welded vertex of each key in the current mesh
+			std::unordered_map<algorithm::VertexKey, unsigned int, algorithm::VertexKeyHash> WeldMap;
+			std::vector<unsigned int> Remap;
+
+			// Face corners appended over the whole load
+			size_t CornerCount = 0;
+		};
+
+		// Start a new mesh on an o/g line, emitting the current one
+		void BeginGroup(BuildState& state, bool named, const std::string& name)
+		{
+			if (!state.listening)
+			{
+				state.listening = true;
+
+				if (named)
+				{
+					state.meshname = name;
+				}
+				else
+				{
+					state.meshname = "unnamed";
+				}
+			}
+			else
+			{
+				// Generate the mesh to put into the array
+
+				if (state.IndexCount != 0 && state.VertexCount != 0)
+				{
+					// Create and Insert Mesh
+					EmitMesh(state, state.meshname);
+
+					// Cleanup
+					state.meshname.clear();
+
+					state.meshname = name;
+				}
+				else
+				{
+					if (named)
+					{
+						state.meshname = name;
+					}
+					else
+					{
+						state.meshname = "unnamed";
+					}
+				}
+			}
+		}
+
+		// Record a usemtl line, splitting the mesh if it already has faces
+		void UseMaterial(BuildState& state, const std::string& name)
+		{
+			state.MeshMatNames.push_back(name);
+
+			// Create new Mesh, if Material changes within a group
+			if (state.IndexCount != 0 && state.VertexCount != 0)
+			{
+				// Create Mesh
+				std::string meshName = state.meshname;
+				int i = 2;
+				while (1) {
+					meshName = state.meshname + "_" + std::to_string(i);
+
+					for (auto& m : LoadedMeshes)
+						if (m.MeshName == meshName)
+							continue;
+					break;
+				}
+
+				// Insert Mesh
+				EmitMesh(state, meshName);
+			}
+		}
+
+		// Copy the current mesh into LoadedMeshes and start an empty one
+		void EmitMesh(BuildState& state, const std::string& name)
+		{
+			// Keep exact-size copies and leave the scratch capacity
+			//	for the next mesh, so it doesn't regrow from empty
+			Mesh tempMesh(std::vector<Vertex>(state.Vertices.begin(), state.Vertices.end()),
+				std::vector<unsigned int>(state.Indices.begin(), state.Indices.end()));
+			tempMesh.MeshName = name;
+			tempMesh.VertexOffset = state.VertexBase;
+			tempMesh.VertexCount = state.VertexCount;
+			tempMesh.IndexOffset = state.IndexBase;
+			tempMesh.IndexCount = state.IndexCount;
+
+			LoadedMeshes.push_back(std::move(tempMesh));
+
+			state.Vertices.clear();
+			state.Indices.clear();
+			state.WeldMap.clear();
+
+			state.VertexBase += state.VertexCount;
+			state.IndexBase += state.IndexCount;
+			state.VertexCount = 0;
+			state.IndexCount = 0;
+		}
+
+		// Triangulate a face and append it to the current mesh
+		void AddFace(BuildState& state, const std::vector<Vertex>& vVerts, std::vector<unsigned int>& iIndices,
+			const algorithm::VertexKey* iKeys = nullptr)
+		{
+			VertexTriangluation(iIndices, vVerts);
+
+			AppendFace(state, vVerts.data(), vVerts.size(), iIndices.data(), iIndices.size(), iKeys);
+		}
+
+		// Append an already triangulated face to the current mesh
+		//
+		// iIndices are relative to the first of the face's vertices.
+		//	With WeldVertices set and keys given, corners whose key
+		//	is already in the mesh reuse that vertex
+		void AppendFace(BuildState& state, const Vertex* vVerts, size_t vertCount, const unsigned int* iIndices, size_t indCount,
+			const algorithm::VertexKey* iKeys = nullptr)
+		{
+			bool toMesh = Storage != StorageMode::Arena;
+			bool toLoaded = Storage != StorageMode::PerMesh;
+			bool weld = iKeys && WeldVertices;
+
+			state.CornerCount += vertCount;
+
+			if (!weld)
+			{
+				// Add Vertices
+				if (toMesh)
+					state.Vertices.insert(state.Vertices.end(), vVerts, vVerts + vertCount);
+				if (toLoaded)
+					LoadedVertices.insert(LoadedVertices.end(), vVerts, vVerts + vertCount);
+
+				// Add Indices
+				unsigned int meshBase = (unsigned int)state.VertexCount;
+				unsigned int loadedBase = (unsigned int)(state.VertexBase + state.VertexCount);
+				for (size_t i = 0; i < indCount; i++)
+				{
+					if (toMesh)
+						state.Indices.push_back(meshBase + iIndices[i]);
+					if (toLoaded)
+						LoadedIndices.push_back(loadedBase + iIndices[i]);
+				}
+				state.VertexCount += vertCount;
+				state.IndexCount += indCount;
+				return;
+			}
+
+			// Map every corner onto a new or existing vertex
+			state.Remap.resize(vertCount);
+			for (size_t i = 0; i < vertCount; i++)
+			{
+				unsigned int index = (unsigned int)state.VertexCount;
+
+				if (iKeys[i].Position >= 0)
+				{
+					auto found = state.WeldMap.try_emplace(iKeys[i], index);
+					if (!found.second)
+					{
+						state.Remap[i] = found.first->second;
+						continue;
+					}
+				}
+
+				// Add Vertices
+				if (toMesh)
+					state.Vertices.push_back(vVerts[i]);
+				if (toLoaded)
+					LoadedVertices.push_back(vVerts[i]);
+
+				state.Remap[i] = index;
+				state.VertexCount++;
+			}
+
+			// Add Indices
+			unsigned int loadedBase = (unsigned int)state.VertexBase;
+			for (size_t i = 0; i < indCount; i++)
+			{
+				unsigned int index = state.Remap[iIndices[i]];
+
+				if (toMesh)
+					state.Indices.push_back(index);
+				if (toLoaded)
+					LoadedIndices.push_back(loadedBase + index);
+			}
+			state.IndexCount += indCount;
+		}
+
+		// A face read by a parse worker, with the element counts
+		//	its chunk had seen when the face line was read
+		struct ChunkFace
+		{
+			size_t CornerStart = 0;
+			size_t CornerCount = 0;
+
+			size_t PosCount = 0;
+			size_t TexCount = 0;
+			size_t NorCount = 0;
+
+			size_t VertStart = 0;
+			size_t VertCount = 0;
+			size_t IndStart = 0;
+			size_t IndCount = 0;
+		};
+
+		// An o/g, usemtl or mtllib line, replayed before face FaceIndex
+		struct ChunkEvent
+		{
+			enum EventType
+			{
+				EventGroup,
+				EventUseMaterial,
+				EventMaterialLibrary
+			};
+
+			EventType Type = EventGroup;
+			bool Named = false;
+			std::string Name;
+			size_t FaceIndex = 0;
+		};
+
+		// The slice of the file handled by one parse worker
+		struct ParseChunk
+		{
+			const char* Begin = nullptr;
+			const char* End = nullptr;
+
+			std::vector<Vector3> Positions;
+			std::vector<Vector2> TCoords;
+			std::vector<Vector3> Normals;
+
+			std::vector<algorithm::FaceCorner> Corners;
+			std::vector<ChunkFace> Faces;
+			std::vector<ChunkEvent> Events;
+
+			// Triangulated faces, indices relative to each face
+			std::vector<Vertex> Vertices;
+			std::vector<unsigned int> Indices;
+			// Weld keys of Vertices when WeldVertices is set
+			std::vector<algorithm::VertexKey> Keys;
+
+			// Offsets of this chunk's attributes in the merged arrays
+			size_t PosBase = 0;
+			size_t TexBase = 0;
+			size_t NorBase = 0;
+		};
+
+		// Run Job(0..Count-1) with one thread per index, Job(0) on the caller
+		template <class Job>
+		static void RunParallel(unsigned int Count, Job&& job)
+		{
+			std::vector<std::thread> workers;
+			workers.reserve(Count > 0 ? Count - 1 : 0);
+
+			for (unsigned int i = 1; i < Count; i++)
+				workers.emplace_back(job, i);
+
+			if (Count > 0)
+				job(0);
+
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+
+		// Tokenize one chunk, recording its attributes, faces and events
+		void ParseChunkLines(ParseChunk& chunk)
+		{
+			const char* cur = chunk.Begin;
+			const char* end = chunk.End;
+
+			while (cur < end)
+			{
+				const char* lineEnd = static_cast<const char*>(memchr(cur, '\n', end - cur));
+				if (lineEnd == nullptr)
+					lineEnd = end;
+
+				std::string_view rawline(cur, lineEnd - cur);
+				cur = lineEnd + (lineEnd < end ? 1 : 0);
+
+				const char* p = algorithm::skipSpace(rawline.data(), lineEnd);
+				if (p == lineEnd)
+					continue;
+
+				std::string_view token = algorithm::firstTokenView(rawline);
+				const char* q = p + token.size();
+
+				if (token == "v")
+				{
+					Vector3 vpos;
+					algorithm::parseFloat(q, lineEnd, vpos.X);
+					algorithm::parseFloat(q, lineEnd, vpos.Y);
+					algorithm::parseFloat(q, lineEnd, vpos.Z);
+
+					chunk.Positions.push_back(vpos);
+				}
+				else if (token == "vt")
+				{
+					Vector2 vtex;
+					algorithm::parseFloat(q, lineEnd, vtex.X);
+					algorithm::parseFloat(q, lineEnd, vtex.Y);
+
+					chunk.TCoords.push_back(vtex);
+				}
+				else if (token == "vn")
+				{
+					Vector3 vnor;
+					algorithm::parseFloat(q, lineEnd, vnor.X);
+					algorithm::parseFloat(q, lineEnd, vnor.Y);
+					algorithm::parseFloat(q, lineEnd, vnor.Z);
+
+					chunk.Normals.push_back(vnor);
+				}
+				else if (token == "f")
+				{
+					ChunkFace face;
+					face.CornerStart = chunk.Corners.size();
+					algorithm::parseFaceCorners(algorithm::tailView(rawline), chunk.Corners);
+					face.CornerCount = chunk.Corners.size() - face.CornerStart;
+
+					face.PosCount = chunk.Positions.size();
+					face.TexCount = chunk.TCoords.size();
+					face.NorCount = chunk.Normals.size();
+
+					chunk.Faces.push_back(face);
+				}
+				else if (token == "usemtl" || token == "mtllib")
+				{
+					ChunkEvent ev;
+					ev.Type = token == "usemtl" ? ChunkEvent::EventUseMaterial : ChunkEvent::EventMaterialLibrary;
+					ev.Name = std::string(algorithm::tailView(rawline));
+					ev.FaceIndex = chunk.Faces.size();
+
+					chunk.Events.push_back(ev);
+				}
+
+				if (token == "o" || token == "g" || rawline[0] == 'g')
+				{
+					ChunkEvent ev;
+					ev.Type = ChunkEvent::EventGroup;
+					ev.Named = token == "o" || token == "g";
+					ev.Name = std::string(algorithm::tailView(rawline));
+					ev.FaceIndex = chunk.Faces.size();
+
+					chunk.Events.push_back(ev);
+				}
+			}
+		}
+
+		// Generate and triangulate one chunk's faces once every
+		//	chunk's attributes have been merged
+		void BuildChunkFaces(ParseChunk& chunk,
+			const std::vector<Vector3>& iPositions,
+			const std::vector<Vector2>& iTCoords,
+			const std::vector<Vector3>& iNormals)
+		{
+			std::vector<Vertex> vVerts;
+			std::vector<unsigned int> iIndices;
+			std::vector<algorithm::VertexKey> keys;
+
+			for (ChunkFace& face : chunk.Faces)
+			{
+				vVerts.clear();
+				iIndices.clear();
+				keys.clear();
+
+				GenVerticesFromCorners(vVerts, chunk.Corners.data() + face.CornerStart, face.CornerCount,
+					iPositions, iTCoords, iNormals,
+					chunk.PosBase + face.PosCount, chunk.TexBase + face.TexCount, chunk.NorBase + face.NorCount,
+					WeldVertices ? &keys : nullptr);
+
+				VertexTriangluation(iIndices, vVerts);
+
+				face.VertStart = chunk.Vertices.size();
+				face.VertCount = vVerts.size();
+				face.IndStart = chunk.Indices.size();
+				face.IndCount = iIndices.size();
+
+				chunk.Vertices.insert(chunk.Vertices.end(), vVerts.begin(), vVerts.end());
+				chunk.Indices.insert(chunk.Indices.end(), iIndices.begin(), iIndices.end());
+				chunk.Keys.insert(chunk.Keys.end(), keys.begin(), keys.end());
+			}
+
+			chunk.Corners = std::vector<algorithm::FaceCorner>();
+		}
+
+		// Load the .mtl file named on an mtllib line, relative to the .obj
+		void LoadMaterialLibrary(const std::string& Path, const std::string& libName)
+		{
+			// Generate LoadedMaterial
+
+			// Generate a path to the material file
+			std::vector<std::string> temp;
+			algorithm::split(Path, temp, "/");
+
+			std::string pathtomat = "";
+
+			if (temp.size() != 1)
+			{
+				for (int i = 0; i < temp.size() - 1; i++)
+				{
+					pathtomat += temp[i] + "/";
+				}
+			}
+
+
+			pathtomat += libName;
+
+#ifdef OBJL_CONSOLE_OUTPUT
+			std::cout << std::endl << "- find materials in: " << pathtomat << std::endl;
+#endif
+
+			// Load Materials
+			LoadMaterials(pathtomat);
+		}
+
+		// Emit the last mesh, assign materials and record timing
+		bool FinishLoad(BuildState& state, size_t bytesRead, std::chrono::steady_clock::time_point startTime)
+		{
+			// Deal with last mesh
+
+			if (state.IndexCount != 0 && state.VertexCount != 0)
+			{
+				// Create and Insert Mesh
+				EmitMesh(state, state.meshname);
+			}
+
+			// Set Materials for each Mesh
+			for (int i = 0; i < state.MeshMatNames.size() && i < LoadedMeshes.size(); i++)
+			{
+				std::string matname = state.MeshMatNames[i];
+
+				// Find corresponding material name in loaded materials
+				// when found copy material variables into mesh material
+				for (int j = 0; j < LoadedMaterials.size(); j++)
+				{
+					if (LoadedMaterials[j].name == matname)
+					{
+						LoadedMeshes[i].MeshMaterial = LoadedMaterials[j];
+						break;
+					}
+				}
+			}
+
+			LastLoadStats.Bytes = bytesRead;
+			LastLoadStats.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+			LastLoadStats.CornerCount = state.CornerCount;
+			LastLoadStats.VertexCount = state.VertexBase;
+
+#ifdef OBJL_CONSOLE_OUTPUT
+			std::cout << "- parsed " << LastLoadStats.Bytes << " bytes in " << LastLoadStats.Seconds * 1000.0
+				<< " ms (" << LastLoadStats.ThroughputMBs() << " MB/s)" << std::endl;
+
+			if (LastLoadStats.VertexCount < LastLoadStats.CornerCount)
+			{
+				std::cout << "- welded " << LastLoadStats.CornerCount << " corners into " << LastLoadStats.VertexCount
+					<< " vertices (" << LastLoadStats.WeldedBytesSaved() << " bytes saved)" << std::endl;
+			}
+#endif
+
+			if (LoadedMeshes.empty() && LoadedVertices.empty() && LoadedIndices.empty())
+			{
+				return false;
+			}
+			else
+			{
+				return true;
+			}
+		}
+		// Generate vertices from a list of positions, 
+		//	tcoords, normals and a face line
+		void GenVerticesFromRawOBJ(std::vector<Vertex>& oVerts,
+			const std::vector<Vector3>& iPositions,
+			const std::vector<Vector2>& iTCoords,
+			const std::vector<Vector3>& iNormals,
+			std::string icurline)
+		{
+			std::vector<std::string> sface, svert;
+			Vertex vVert;
+			algorithm::split(algorithm::tail(icurline), sface, " ");
+
+			bool noNormal = false;
+
+			// For every given vertex do this
+			for (int i = 0; i < int(sface.size()); i++)
+			{
+				// See What type the vertex is.
+				int vtype;
+
+				algorithm::split(sface[i], svert, "/");
+
+				// Check for just position - v1
+				if (svert.size() == 1)
+				{
+					// Only position
+					vtype = 1;
+				}
+
+				// Check for position & texture - v1/vt1
+				if (svert.size() == 2)
+				{
+					// Position & Texture
+					vtype = 2;
+				}
+
+				// Check for Position, Texture and Normal - v1/vt1/vn1
+				// or if Position and Normal - v1//vn1
+				if (svert.size() == 3)
+				{
+					if (svert[1] != "")
+					{
+						// Position, Texture, and Normal
+						vtype = 4;
+					}
+					else
+					{
+						// Position & Normal
+						vtype = 3;
+					}
+				}
+
+				// Calculate and store the vertex
+				switch (vtype)
+				{
+				case 1: // P
+				{
+					vVert.Position = algorithm::getElement(iPositions, svert[0]);
+					vVert.TextureCoordinate = Vector2(0, 0);
+					noNormal = true;
+					oVerts.push_back(vVert);
+					break;
+				}
+				case 2: // P/T
+				{
+					vVert.Position = algorithm::getElement(iPositions, svert[0]);
+					vVert.TextureCoordinate = algorithm::getElement(iTCoords, svert[1]);
+					noNormal = true;
+					oVerts.push_back(vVert);
+					break;
+				}
+				case 3: // P//N
+				{
+					vVert.Position = algorithm::getElement(iPositions, svert[0]);
+					vVert.TextureCoordinate = Vector2(0, 0);
+					vVert.Normal = algorithm::getElement(iNormals, svert[2]);
+					oVerts.push_back(vVert);
+					break;
+				}
+				case 4: // P/T/N
+				{
+					vVert.Position = algorithm::getElement(iPositions, svert[0]);
+					vVert.TextureCoordinate = algorithm::getElement(iTCoords, svert[1]);
+					vVert.Normal = algorithm::getElement(iNormals, svert[2]);
+					oVerts.push_back(vVert);
+					break;
+				}
+				default:
+				{
+					break;
+				}
+				}
+			}
+
+			// take care of missing normals
+			// these may not be truly acurate but it is the 
+			// best they get for not compiling a mesh with normals	
+			if (noNormal)
+			{
+				Vector3 A = oVerts[0].Position - oVerts[1].Position;
+				Vector3 B = oVerts[2].Position - oVerts[1].Position;
+
+				Vector3 normal = math::CrossV3(A, B);
+
+				for (int i = 0; i < int(oVerts.size()); i++)
+				{
+					oVerts[i].Normal = normal;
+				}
+			}
+		}
+
+		// Generate vertices from a list of positions,
+		//	tcoords, normals and parsed face corners
+		//
+		// The counts are the number of elements declared before
+		//	the face line, which negative indices are relative to
+		void GenVerticesFromCorners(std::vector<Vertex>& oVerts,
+			const algorithm::FaceCorner* iCorners, size_t iCornerCount,
+			const std::vector<Vector3>& iPositions,
+			const std::vector<Vector2>& iTCoords,
+			const std::vector<Vector3>& iNormals,
+			size_t iPosCount, size_t iTexCount, size_t iNorCount,
+			std::vector<algorithm::VertexKey>* oKeys = nullptr)
+		{
+			bool noNormal = false;
+
+			// For every given vertex do this
+			for (size_t i = 0; i < iCornerCount; i++)
+			{
+				const algorithm::FaceCorner& corner = iCorners[i];
+
+				int pos = algorithm::resolveIndex(corner.Position, iPosCount);
+				int tex = corner.HasTexCoord ? algorithm::resolveIndex(corner.TexCoord, iTexCount) : 0;
+				int nor = corner.HasNormal ? algorithm::resolveIndex(corner.Normal, iNorCount) : 0;
+				if (pos < 0 || tex < 0 || nor < 0)
+					continue;
+
+				// Calculate and store the vertex
+				Vertex vVert;
+				vVert.Position = iPositions[pos];
+				vVert.TextureCoordinate = corner.HasTexCoord ? iTCoords[tex] : Vector2(0, 0);
+				if (corner.HasNormal)
+					vVert.Normal = iNormals[nor];
+				else
+					noNormal = true;
+
+				oVerts.push_back(vVert);
+
+				if (oKeys)
+				{
+					algorithm::VertexKey key;
+					key.Position = pos;
+					key.TexCoord = corner.HasTexCoord ? tex : -1;
+					key.Normal = corner.HasNormal ? nor : -1;
+					oKeys->push_back(key);
+				}
+			}
+
+			// A generated face normal makes these vertices unique to the face
+			if (oKeys && noNormal)
+			{
+				for (algorithm::VertexKey& key : *oKeys)
+				{
+					key.Position = -1;
+				}
+			}
+
+			// take care of missing normals
+			if (noNormal && oVerts.size() >= 3)
+			{
+				Vector3 A = oVerts[0].Position - oVerts[1].Position;
+				Vector3 B = oVerts[2].Position - oVerts[1].Position;
+
+				Vector3 normal = math::CrossV3(A, B);
+
+				for (int i = 0; i < int(oVerts.size()); i++)
+				{
+					oVerts[i].Normal = normal;
+				}
+			}
+		}
+
+		// Triangulate a list of vertices into a face by printing
+		//	inducies corresponding with triangles within it
+		void VertexTriangluation(std::vector<unsigned int>& oIndices,
+			const std::vector<Vertex>& iVerts)
+		{
+			triangulation::Triangulate(oIndices, iVerts.data(), iVerts.size());
+		}
+
+		// Load Materials from .mtl file
+		bool LoadMaterials(std::string path)
+		{
+			// If the file is not a material file return false
+			if (path.substr(path.size() - 4, path.size()) != ".mtl")
+				return false;
+
+			std::ifstream file(path);
+
+			// If the file is not found return false
+			if (!file.is_open())
+				return false;
+
+			Material tempMaterial;
+
+			bool listening = false;
+
+			// Go through each line looking for material variables
+			std::string curline;
+			while (std::getline(file, curline))
+			{
+				// new material and material name
+				if (algorithm::firstToken(curline) == "newmtl")
+				{
+					if (!listening)
+					{
+						listening = true;
+
+						if (curline.size() > 7)
+						{
+							tempMaterial.name = algorithm::tail(curline);
+						}
+						else
+						{
+							tempMaterial.name = "none";
+						}
+					}
+					else
+					{
+						// Generate the material
+
+						// Push Back loaded Material
+						LoadedMaterials.push_back(tempMaterial);
+
+						// Clear Loaded Material
+						tempMaterial = Material();
+
+						if (curline.size() > 7)
+						{
+							tempMaterial.name = algorithm::tail(curline);
+						}
+						else
+						{
+							tempMaterial.name = "none";
+						}
+					}
+				}
+				// Ambient Color
+				if (algorithm::firstToken(curline) == "Ka")
+				{
+					std::vector<std::string> temp;
+					algorithm::split(algorithm::tail(curline), temp, " ");
+
+					if (temp.size() != 3)
+						continue;
+
+					tempMaterial.Ka.X = std::stof(temp[0]);
+					tempMaterial.Ka.Y = std::stof(temp[1]);
+					tempMaterial.Ka.Z = std::stof(temp[2]);
+				}
+				// Diffuse Color
+				if (algorithm::firstToken(curline) == "Kd")
+				{
+					std::vector<std::string> temp;
+					algorithm::split(algorithm::tail(curline), temp, " ");
+
+					if (temp.size() != 3)
+						continue;
+
+					tempMaterial.Kd.X = std::stof(temp[0]);
+					tempMaterial.Kd.Y = std::stof(temp[1]);
+					tempMaterial.Kd.Z = std::stof(temp[2]);
+				}
+				// Specular Color
+				if (algorithm::firstToken(curline) == "Ks")
+				{
+					std::vector<std::string> temp;
+					algorithm::split(algorithm::tail(curline), temp, " ");
+
+					if (temp.size() != 3)
+						continue;
+
+					tempMaterial.Ks.X = std::stof(temp[0]);
+					tempMaterial.Ks.Y = std::stof(temp[1]);
+					tempMaterial.Ks.Z = std::stof(temp[2]);
+				}
+				// Specular Exponent
+				if (algorithm::firstToken(curline) == "Ns")
+				{
+					tempMaterial.Ns = std::stof(algorithm::tail(curline));
+				}
+				// Optical Density
+				if (algorithm::firstToken(curline) == "Ni")
+				{
+					tempMaterial.Ni = std::stof(algorithm::tail(curline));
+				}
+				// Dissolve
+				if (algorithm::firstToken(curline) == "d")
+				{
+					tempMaterial.d = std::stof(algorithm::tail(curline));
+				}
+				// Illumination
+				if (algorithm::firstToken(curline) == "illum")
+				{
+					tempMaterial.illum = std::stoi(algorithm::tail(curline));
+				}
+				// Ambient Texture Map
+				if (algorithm::firstToken(curline) == "map_Ka")
+				{
+					tempMaterial.map_Ka = algorithm::tail(curline);
+				}
+				// Diffuse Texture Map
+				if (algorithm::firstToken(curline) == "map_Kd")
+				{
+					tempMaterial.map_Kd = algorithm::tail(curline);
+				}
+				// Specular Texture Map
+				if (algorithm::firstToken(curline) == "map_Ks")
+				{
+					tempMaterial.map_Ks = algorithm::tail(curline);
+				}
+				// Specular Hightlight Map
+				if (algorithm::firstToken(curline) == "map_Ns")
+				{
+					tempMaterial.map_Ns = algorithm::tail(curline);
+				}
+				// Alpha Texture Map
+				if (algorithm::firstToken(curline) == "map_d")
+				{
+					tempMaterial.map_d = algorithm::tail(curline);
+				}
+				// Bump Map
+				if (algorithm::firstToken(curline) == "map_Bump" || algorithm::firstToken(curline) == "map_bump" || algorithm::firstToken(curline) == "bump")
+				{
+					tempMaterial.map_bump = algorithm::tail(curline);
+				}
+			}
+
+			// Deal with last material
+
+			// Push Back loaded Material
+			LoadedMaterials.push_back(tempMaterial);
+
+			// Test to see if anything was loaded
+			// If not return false
+			if (LoadedMaterials.empty())
+				return false;
+			// If so return true
+			else
+				return true;
+		}
+	};
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <chrono>
+
+uint64_t RenderQueue::MakeKey(Pass pass, const Packet& packet, float depth)
+{
+	// GL names are small integers; two that collide in their low bits only sort together.
+	uint64_t material{ (uint64_t)(packet.Textures[0] * 31u + packet.Textures[1]) & 0xFFFF };
+	uint64_t quantized{ (uint64_t)(std::clamp(depth, 0.0f, 1.0f) * float(0x3FFFFF)) };
+
+	return (uint64_t)pass << 62 |
+		((uint64_t)packet.Program & 0xFFF) << 50 |
+		material << 34 |
+		((uint64_t)packet.VertexArray & 0xFFF) << 22 |
+		quantized;
+}
+
+void RenderQueue::Submit(Pass pass, float depth, Packet packet)
+{
+	items.push_back({ MakeKey(pass, packet, depth), (uint32_t)packets.size() });
+	packets.push_back(std::move(packet));
+}
+
+void RenderQueue::Sort()
+{
+	scratch.resize(items.size());
+	for (int shift{ 0 }; shift < 64; shift += 8)
+	{
+		size_t counts[256]{};
+		for (const Item& item : items)
+			counts[(item.Key >> shift) & 0xFF]++;
+		if (counts[(items[0].Key >> shift) & 0xFF] == items.size())
+			continue;
+
+		size_t offset{ 0 };
+		for (size_t& count : counts)
+		{
+			size_t next{ offset + count };
+			count = offset;
+			offset = next;
+		}
+		for (const Item& item : items)
+			scratch[counts[(item.Key >> shift) & 0xFF]++] = item;
+		items.swap(scratch);
+	}
+}
+
+void RenderQueue::Execute(GLStateCache& state)
+{
+	Packets = packets.size();
+	if (packets.empty())
+		return;
+
+	auto start{ std::chrono::steady_clock::now() };
+	Sort();
+	SortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	for (const Item& item : items)
+	{
+		const Packet& packet{ packets[item.Packet] };
+		state.UseProgram(packet.Program);
+		for (GLuint unit{ 0 }; unit < 2; unit++)
+		{
+			if (packet.Textures[unit])
+				state.BindTexture(unit, packet.TextureType, packet.Textures[unit]);
+		}
+		state.BindVertexArray(packet.VertexArray);
+		if (packet.DrawObject)
+			(*packet.DrawObject)(packet.Object);
+		else
+			packet.Draw();
+	}
+
+	packets.clear();
+	items.clear();
+}
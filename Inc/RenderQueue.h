@@ -0,0 +1,62 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "GLStateCache.h"
+
+// Draws collected over a frame in any order and issued sorted by a 64-bit key, so draws
+// sharing a program, then a material, then a vertex array run back to back and the state
+// cache drops the binds between them.
+//
+// Key bits, high to low: pass (2), program (12), material (16), vertex array (12), depth (22).
+// Within one set of state, draws go front to back.
+class RenderQueue
+{
+public:
+	enum class Pass : uint8_t { Opaque, Overlay };
+
+	struct Packet
+	{
+		GLuint Program{ 0 };
+		GLuint VertexArray{ 0 };
+		// Bound to units 0 and 1; 0 leaves the unit as it is.
+		GLenum TextureType{ GL_TEXTURE_2D };
+		GLuint Textures[2]{ 0, 0 };
+		// Binds anything else the draw reads, like its ObjectData range, and draws.
+		std::function<void()> Draw;
+		// Or, for many packets drawn the same way, one shared callable that tells them apart by
+		// Object. Each packet then holds only a pointer and an index, so submitting one
+		// allocates nothing. Used in place of Draw when set, and has to outlive Execute.
+		const std::function<void(uint32_t object)>* DrawObject{ nullptr };
+		uint32_t Object{ 0 };
+	};
+
+	// depth: distance from the camera over the far plane, clamped to [0, 1].
+	static uint64_t MakeKey(Pass pass, const Packet& packet, float depth);
+
+	void Submit(Pass pass, float depth, Packet packet);
+	// Sorts and issues everything submitted this frame, then empties the queue.
+	void Execute(GLStateCache& state);
+
+	// Of the last Execute.
+	size_t Packets{ 0 };
+	double SortMs{ 0.0 };
+
+private:
+	struct Item
+	{
+		uint64_t Key;
+		uint32_t Packet;
+	};
+
+	std::vector<Packet> packets;
+	std::vector<Item> items;
+	std::vector<Item> scratch;
+
+	// Least significant digit first, a byte per pass, skipping bytes every key shares.
+	void Sort();
+};
@@ -1,49 +1,526 @@
-#include "Shader.h"
-
-std::string get_file_contents(const char* fileName)
-{
-	std::ifstream in(fileName, std::ios::binary);
-	if (in) {
-		std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-
-		return(contents);
-	}
-
-	throw(errno);
-}
-
-Shader::Shader(const char* vertexSource, const char* fragmentSource)
-{
-	GLuint vertexShader{ glCreateShader(GL_VERTEX_SHADER) };
-	glShaderSource(vertexShader, 1, &vertexSource, NULL);
-	glCompileShader(vertexShader);
-
-	GLuint fragmentShader{ glCreateShader(GL_FRAGMENT_SHADER) };
-	glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
-	glCompileShader(fragmentShader);
-
-	// Link the shaders into a shader program.
-	ID = glCreateProgram();
-	glAttachShader(ID, vertexShader);
-	glAttachShader(ID, fragmentShader);
-
-	glLinkProgram(ID);
-
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-}
-
-void Shader::Activate()
-{
-	glUseProgram(ID);
-}
-
-int Shader::GetUniformLoc(const char* name)
-{
-	return glGetUniformLocation(ID, name);
-}
-
-void Shader::Delete()
-{
-	glDeleteProgram(ID);
-}
\ No newline at end of file
+#include "Shader.h"
+#include "GLStateCache.h"
+#include "UBO.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+std::string get_file_contents(const char* fileName)
+{
+	std::ifstream in(fileName, std::ios::binary);
+	if (in) {
+		std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+		return(contents);
+	}
+
+	throw(errno);
+}
+
+namespace
+{
+	// Appends fileName to output with its #include lines expanded. GLSL numbers source
+	// strings in #line, so each file gets its index in files for the compiler's messages.
+	void ExpandIncludes(const std::filesystem::path& fileName, std::string& output, std::vector<std::string>& files, std::vector<std::string>& stack)
+	{
+		std::string source{ get_file_contents(fileName.string().c_str()) };
+		int fileIndex{ (int)files.size() };
+		files.push_back(fileName.string());
+		stack.push_back(fileName.string());
+
+		std::istringstream lines(source);
+		std::string line;
+		for (int lineNumber = 1; std::getline(lines, line); lineNumber++)
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			size_t directive{ line.find_first_not_of(" \t") };
+			if (directive == std::string::npos || line.compare(directive, 8, "#include") != 0)
+			{
+				output += line;
+				output += '\n';
+				continue;
+			}
+
+			size_t open{ line.find('"', directive) };
+			size_t close{ line.find('"', open + 1) };
+			if (open == std::string::npos || close == std::string::npos)
+				throw std::runtime_error(fileName.string() + ":" + std::to_string(lineNumber) + ": malformed #include");
+
+			std::filesystem::path included{ fileName.parent_path() / line.substr(open + 1, close - open - 1) };
+			if (std::find(stack.begin(), stack.end(), included.string()) != stack.end())
+				throw std::runtime_error(fileName.string() + ": recursive #include of " + included.string());
+
+			output += "#line 1 " + std::to_string(files.size()) + "\n";
+			ExpandIncludes(included, output, files, stack);
+			output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+		}
+
+		stack.pop_back();
+	}
+}
+
+std::string preprocess_shader(const char* fileName, const std::vector<std::string>& defines, std::vector<std::string>* includedFiles)
+{
+	std::string expanded;
+	std::vector<std::string> files;
+	std::vector<std::string> stack;
+	ExpandIncludes(fileName, expanded, files, stack);
+
+	if (includedFiles)
+		includedFiles->insert(includedFiles->end(), files.begin(), files.end());
+
+	// Defines have to follow #version, which must be the first line.
+	size_t body{ 0 };
+	if (expanded.compare(0, 8, "#version") == 0)
+		body = expanded.find('\n') + 1;
+
+	std::string header;
+	for (const std::string& define : defines)
+	{
+		header += "#define " + define + "\n";
+	}
+
+	return expanded.substr(0, body) + header + "#line 2 0\n" + expanded.substr(body);
+}
+
+Shader::UniformStats Shader::Stats;
+std::string Shader::BinaryCacheDir{ "Assets/Cache/Shaders" };
+
+namespace
+{
+	constexpr char binaryMagic[4]{ 'O', 'G', 'P', 'B' };
+	constexpr uint32_t binaryVersion{ 1 };
+
+	struct BinaryHeader
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint64_t SourceHash;
+		uint64_t DriverHash;
+		uint32_t Format;
+		uint32_t Size;
+	};
+
+	// FNV-1a, continuing from hash.
+	uint64_t HashString(const char* text, uint64_t hash = 0xCBF29CE484222325ull)
+	{
+		for (; *text; text++)
+		{
+			hash = (hash ^ (unsigned char)*text) * 0x100000001B3ull;
+		}
+
+		// Separate consecutive strings so "ab" + "c" and "a" + "bc" differ.
+		return (hash ^ 0xFF) * 0x100000001B3ull;
+	}
+
+	// A binary is only valid for the driver that produced it.
+	uint64_t DriverHash()
+	{
+		uint64_t hash{ 0xCBF29CE484222325ull };
+		for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+		{
+			const GLubyte* value{ glGetString(name) };
+			hash = HashString(value ? (const char*)value : "", hash);
+		}
+
+		return hash;
+	}
+
+	std::string BinaryCachePath(uint64_t sourceHash)
+	{
+		char fileName[32];
+		std::snprintf(fileName, sizeof(fileName), "%016llx.glprogram", (unsigned long long)sourceHash);
+		return (std::filesystem::path(Shader::BinaryCacheDir) / fileName).string();
+	}
+
+	bool BinariesSupported()
+	{
+		if (!GLAD_GL_VERSION_4_1 && !GLAD_GL_ARB_get_program_binary)
+			return false;
+
+		GLint formats{ 0 };
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		return formats > 0;
+	}
+}
+
+bool Shader::ParallelCompile()
+{
+	return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+}
+
+Shader::Shader(const char* vertexSource, const char* fragmentSource)
+{
+	std::chrono::steady_clock::time_point startTime{ std::chrono::steady_clock::now() };
+
+	ID = glCreateProgram();
+
+	bool useCache{ !BinaryCacheDir.empty() && BinariesSupported() };
+	uint64_t sourceHash{ HashString(fragmentSource, HashString(vertexSource)) };
+	uint64_t driverHash{ useCache ? DriverHash() : 0 };
+	std::string cachePath{ BinaryCachePath(sourceHash) };
+
+	FromBinaryCache = useCache && LoadBinary(cachePath, sourceHash, driverHash);
+	if (!FromBinaryCache)
+	{
+		// Link the shaders into a shader program.
+		if (CompileAndLink(vertexSource, fragmentSource) && useCache)
+			SaveBinary(cachePath, sourceHash, driverHash);
+	}
+
+	ReflectUniforms();
+
+	LoadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool Shader::CompileAndLink(const char* vertexSource, const char* fragmentSource)
+{
+	GLuint shaders[2];
+	StartLink(ID, vertexSource, fragmentSource, shaders);
+	return FinishLink(ID, shaders);
+}
+
+void Shader::StartLink(GLuint program, const char* vertexSource, const char* fragmentSource, GLuint shaders[2])
+{
+	shaders[0] = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(shaders[0], 1, &vertexSource, NULL);
+	glCompileShader(shaders[0]);
+
+	shaders[1] = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(shaders[1], 1, &fragmentSource, NULL);
+	glCompileShader(shaders[1]);
+
+	glAttachShader(program, shaders[0]);
+	glAttachShader(program, shaders[1]);
+
+	if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary)
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+	glLinkProgram(program);
+}
+
+bool Shader::FinishLink(GLuint program, GLuint shaders[2])
+{
+	bool compiled{ CheckCompile(shaders[0], "vertex") };
+	compiled = CheckCompile(shaders[1], "fragment") && compiled;
+
+	glDetachShader(program, shaders[0]);
+	glDetachShader(program, shaders[1]);
+	glDeleteShader(shaders[0]);
+	glDeleteShader(shaders[1]);
+
+	GLint linked{ GL_FALSE };
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	std::string linkLog{ AppendLog(program, "link", true) };
+
+	if (linked != GL_TRUE)
+		std::cerr << "Shader program " << program << " failed to link:\n" << linkLog;
+
+	return compiled && linked == GL_TRUE;
+}
+
+void Shader::BeginReload(const char* vertexSource, const char* fragmentSource)
+{
+	CancelReload();
+
+	pendingID = glCreateProgram();
+	pendingHash = HashString(fragmentSource, HashString(vertexSource));
+	StartLink(pendingID, vertexSource, fragmentSource, pendingShaders);
+}
+
+Shader::ReloadState Shader::PollReload()
+{
+	if (pendingID == 0)
+		return ReloadState::Idle;
+
+	// With parallel compile the driver builds in the background; asking for the link
+	// status before it's done would wait for it.
+	if (ParallelCompile())
+	{
+		GLint done{ GL_FALSE };
+		glGetProgramiv(pendingID, GL_COMPLETION_STATUS_KHR, &done);
+		if (done != GL_TRUE)
+			return ReloadState::Compiling;
+	}
+
+	InfoLog.clear();
+
+	GLuint program{ pendingID };
+	pendingID = 0;
+	if (!FinishLink(program, pendingShaders))
+	{
+		GLStateCache::Get().DeleteProgram(program);
+		return ReloadState::Failed;
+	}
+
+	// Take over the new program and give it the values the old one had.
+	std::unordered_map<std::string, Uniform> previous{ std::move(uniforms) };
+	GLuint oldID{ ID };
+	ID = program;
+	ReflectUniforms();
+
+	GLint current{ 0 };
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	GLStateCache::Get().UseProgram(ID);
+	for (std::pair<const std::string, Uniform>& entry : uniforms)
+	{
+		std::unordered_map<std::string, Uniform>::const_iterator old{ previous.find(entry.first) };
+		if (old == previous.end() || old->second.Bytes == 0 || old->second.Type != entry.second.Type)
+			continue;
+
+		entry.second.Bytes = old->second.Bytes;
+		std::memcpy(entry.second.Value, old->second.Value, old->second.Bytes);
+		Upload(entry.second);
+	}
+	GLStateCache::Get().UseProgram((GLuint)current == oldID ? ID : (GLuint)current);
+	GLStateCache::Get().DeleteProgram(oldID);
+
+	reloadedHash = pendingHash;
+	FromBinaryCache = false;
+	return ReloadState::Swapped;
+}
+
+void Shader::SaveReloadedBinary()
+{
+	if (reloadedHash == 0 || BinaryCacheDir.empty() || !BinariesSupported())
+		return;
+
+	SaveBinary(BinaryCachePath(reloadedHash), reloadedHash, DriverHash());
+	reloadedHash = 0;
+}
+
+void Shader::CancelReload()
+{
+	if (pendingID == 0)
+		return;
+
+	glDeleteShader(pendingShaders[0]);
+	glDeleteShader(pendingShaders[1]);
+	GLStateCache::Get().DeleteProgram(pendingID);
+	pendingID = 0;
+}
+
+bool Shader::CheckCompile(GLuint shader, const char* stage)
+{
+	GLint compiled{ GL_FALSE };
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	std::string compileLog{ AppendLog(shader, stage, false) };
+
+	if (compiled != GL_TRUE)
+		std::cerr << "Shader " << stage << " stage failed to compile:\n" << compileLog;
+
+	return compiled == GL_TRUE;
+}
+
+std::string Shader::AppendLog(GLuint object, const char* stage, bool program)
+{
+	GLint length{ 0 };
+	program ? glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length) : glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+	if (length <= 1)
+		return "";
+
+	std::string log(length, '\0');
+	program ? glGetProgramInfoLog(object, length, NULL, &log[0]) : glGetShaderInfoLog(object, length, NULL, &log[0]);
+	log.resize(std::strlen(log.c_str()));
+	if (!log.empty() && log.back() != '\n')
+		log += '\n';
+
+	log = std::string("[") + stage + "] " + log;
+	InfoLog += log;
+	return log;
+}
+
+bool Shader::LoadBinary(const std::string& cachePath, uint64_t sourceHash, uint64_t driverHash)
+{
+	std::ifstream in(cachePath, std::ios::binary);
+	BinaryHeader header;
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return false;
+
+	if (std::memcmp(header.Magic, binaryMagic, sizeof(binaryMagic)) != 0
+		|| header.Version != binaryVersion
+		|| header.SourceHash != sourceHash
+		|| header.DriverHash != driverHash)
+		return false;
+
+	std::vector<char> binary(header.Size);
+	if (!in.read(binary.data(), binary.size()))
+		return false;
+
+	glProgramBinary(ID, header.Format, binary.data(), (GLsizei)binary.size());
+
+	// Drivers may reject a binary for reasons the header can't see; compile from source then.
+	GLint linked{ GL_FALSE };
+	glGetProgramiv(ID, GL_LINK_STATUS, &linked);
+	return linked == GL_TRUE;
+}
+
+void Shader::SaveBinary(const std::string& cachePath, uint64_t sourceHash, uint64_t driverHash)
+{
+	GLint length{ 0 };
+	glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format{ 0 };
+	glGetProgramBinary(ID, length, &length, &format, binary.data());
+
+	BinaryHeader header{};
+	std::memcpy(header.Magic, binaryMagic, sizeof(binaryMagic));
+	header.Version = binaryVersion;
+	header.SourceHash = sourceHash;
+	header.DriverHash = driverHash;
+	header.Format = format;
+	header.Size = (uint32_t)length;
+
+	// A failed write only costs the next launch another compile.
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), error);
+
+	std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		std::cerr << "Failed to write shader cache " << cachePath << "\n";
+		return;
+	}
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(binary.data(), length);
+}
+
+void Shader::ReflectUniforms()
+{
+	uniforms.clear();
+
+	GLint count{ 0 };
+	GLint maxLength{ 0 };
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	std::string name(maxLength > 0 ? maxLength : 1, '\0');
+	for (GLint i = 0; i < count; i++)
+	{
+		GLsizei length{ 0 };
+		GLint size{ 0 };
+		GLenum type{ 0 };
+		glGetActiveUniform(ID, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, &name[0]);
+
+		std::string uniformName{ name.substr(0, length) };
+		GLint location{ glGetUniformLocation(ID, uniformName.c_str()) };
+		// Uniforms in a block have no location and are set through the block's buffer.
+		if (location < 0) continue;
+
+		Uniform uniform;
+		uniform.Location = location;
+		uniform.Type = type;
+		uniforms[uniformName] = uniform;
+
+		// Arrays are reported as "name[0]"; make the plain name work too.
+		if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+		{
+			uniforms[uniformName.substr(0, uniformName.size() - 3)] = uniform;
+		}
+	}
+
+	// Point each uniform block at the binding its name has in the UBO registry.
+	GLint blockCount{ 0 };
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+	for (GLint i = 0; i < blockCount; i++)
+	{
+		GLint length{ 0 };
+		glGetActiveUniformBlockiv(ID, (GLuint)i, GL_UNIFORM_BLOCK_NAME_LENGTH, &length);
+
+		std::string blockName(length > 0 ? length : 1, '\0');
+		glGetActiveUniformBlockName(ID, (GLuint)i, (GLsizei)blockName.size(), &length, &blockName[0]);
+		blockName.resize(length);
+
+		glUniformBlockBinding(ID, (GLuint)i, UBO::BindingPoint(blockName));
+	}
+}
+
+void Shader::Activate()
+{
+	GLStateCache::Get().UseProgram(ID);
+}
+
+int Shader::GetUniformLoc(const char* name)
+{
+	std::unordered_map<std::string, Uniform>::const_iterator it{ uniforms.find(name) };
+	return it != uniforms.end() ? it->second.Location : -1;
+}
+
+Shader::Uniform* Shader::Changed(const char* name, const void* value, GLsizei bytes)
+{
+	Stats.Requested++;
+
+	std::unordered_map<std::string, Uniform>::iterator it{ uniforms.find(name) };
+	if (it == uniforms.end()) return nullptr;
+
+	Uniform& uniform{ it->second };
+	if (uniform.Bytes == bytes && std::memcmp(uniform.Value, value, bytes) == 0) return nullptr;
+
+	uniform.Bytes = bytes;
+	std::memcpy(uniform.Value, value, bytes);
+	Stats.Issued++;
+	return &uniform;
+}
+
+void Shader::SetInt(const char* name, GLint value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniform1i(uniform->Location, value);
+}
+
+void Shader::SetFloat(const char* name, GLfloat value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniform1f(uniform->Location, value);
+}
+
+void Shader::SetVec3(const char* name, const glm::vec3& value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniform3f(uniform->Location, value.x, value.y, value.z);
+}
+
+void Shader::SetVec4(const char* name, const glm::vec4& value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniform4f(uniform->Location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::SetMat3(const char* name, const glm::mat3& value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniformMatrix3fv(uniform->Location, 1, GL_FALSE, &value[0][0]);
+}
+
+void Shader::SetMat4(const char* name, const glm::mat4& value)
+{
+	if (Uniform* uniform{ Changed(name, &value, sizeof(value)) }) glUniformMatrix4fv(uniform->Location, 1, GL_FALSE, &value[0][0]);
+}
+
+void Shader::Upload(const Uniform& uniform)
+{
+	const GLfloat* floats{ reinterpret_cast<const GLfloat*>(uniform.Value) };
+	switch (uniform.Type)
+	{
+	case GL_FLOAT: glUniform1fv(uniform.Location, 1, floats); break;
+	case GL_FLOAT_VEC3: glUniform3fv(uniform.Location, 1, floats); break;
+	case GL_FLOAT_VEC4: glUniform4fv(uniform.Location, 1, floats); break;
+	case GL_FLOAT_MAT3: glUniformMatrix3fv(uniform.Location, 1, GL_FALSE, floats); break;
+	case GL_FLOAT_MAT4: glUniformMatrix4fv(uniform.Location, 1, GL_FALSE, floats); break;
+	// Ints, bools and samplers, the only other types the setters write.
+	default: glUniform1iv(uniform.Location, 1, reinterpret_cast<const GLint*>(uniform.Value)); break;
+	}
+}
+
+void Shader::Delete()
+{
+	CancelReload();
+	GLStateCache::Get().DeleteProgram(ID);
+}
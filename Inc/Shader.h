@@ -1,21 +1,96 @@
-#pragma once
-
-#include "glad/glad.h"
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-#include <cerrno>
-
-std::string get_file_contents(const char* filename);
-
-class Shader
-{
-public:
-	GLuint ID;
-	Shader(const char* vertexSource, const char* fragmentSource);
-
-	void Activate();
-	int GetUniformLoc(const char* name);
-	void Delete();
-};
\ No newline at end of file
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cerrno>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+std::string get_file_contents(const char* filename);
+// Reads a shader with its #include "file" lines expanded (relative to the including file)
+// and a #define line for each entry of defines ("NAME" or "NAME value") after #version.
+// The paths of the file and everything it included are appended to includedFiles.
+std::string preprocess_shader(const char* fileName, const std::vector<std::string>& defines = {}, std::vector<std::string>* includedFiles = nullptr);
+
+class Shader
+{
+public:
+	// Uniform setter calls made vs glUniform* calls that reached the driver.
+	struct UniformStats
+	{
+		size_t Requested{ 0 };
+		size_t Issued{ 0 };
+	};
+	static UniformStats Stats;
+
+	// Linked programs are saved here as driver binaries keyed by source and driver, and
+	// loaded instead of compiling when both match. Empty turns the cache off.
+	static std::string BinaryCacheDir;
+
+	GLuint ID;
+	bool FromBinaryCache{ false };
+	double LoadSeconds{ 0.0 };
+	// Compile and link messages, warnings included.
+	std::string InfoLog;
+
+	Shader(const char* vertexSource, const char* fragmentSource);
+
+	void Activate();
+	int GetUniformLoc(const char* name);
+	void Delete();
+
+	// Hot reload. BeginReload starts building a replacement program. PollReload swaps ID over
+	// once it links, carrying the uniform values across; if it fails the current program stays
+	// in use. Only with ParallelCompile does either return without waiting for the driver:
+	// otherwise the compile may block in BeginReload and PollReload always finishes the link.
+	enum class ReloadState { Idle, Compiling, Swapped, Failed };
+	static bool ParallelCompile();
+	void BeginReload(const char* vertexSource, const char* fragmentSource);
+	ReloadState PollReload();
+	bool Reloading() const { return pendingID != 0; }
+	// Saves a reloaded program to the binary cache, which PollReload leaves out of the frame.
+	void SaveReloadedBinary();
+
+	// The setters upload to the active program, so call Activate first. A value equal to
+	// the last one set on this program, or a uniform the linker removed, is skipped.
+	void SetInt(const char* name, GLint value);
+	void SetFloat(const char* name, GLfloat value);
+	void SetVec3(const char* name, const glm::vec3& value);
+	void SetVec4(const char* name, const glm::vec4& value);
+	void SetMat3(const char* name, const glm::mat3& value);
+	void SetMat4(const char* name, const glm::mat4& value);
+
+private:
+	struct Uniform
+	{
+		GLint Location{ -1 };
+		GLenum Type{ 0 };
+		GLsizei Bytes{ 0 };
+		unsigned char Value[sizeof(glm::mat4)];
+	};
+	std::unordered_map<std::string, Uniform> uniforms;
+
+	GLuint pendingID{ 0 };
+	GLuint pendingShaders[2]{ 0, 0 };
+	uint64_t pendingHash{ 0 };
+	uint64_t reloadedHash{ 0 };
+
+	bool CompileAndLink(const char* vertexSource, const char* fragmentSource);
+	void StartLink(GLuint program, const char* vertexSource, const char* fragmentSource, GLuint shaders[2]);
+	bool FinishLink(GLuint program, GLuint shaders[2]);
+	void CancelReload();
+	bool CheckCompile(GLuint shader, const char* stage);
+	std::string AppendLog(GLuint object, const char* stage, bool program);
+	bool LoadBinary(const std::string& cachePath, uint64_t sourceHash, uint64_t driverHash);
+	void SaveBinary(const std::string& cachePath, uint64_t sourceHash, uint64_t driverHash);
+
+	void ReflectUniforms();
+	void Upload(const Uniform& uniform);
+	// Returns the uniform if value differs from its last upload, and remembers value.
+	Uniform* Changed(const char* name, const void* value, GLsizei bytes);
+};
@@ -0,0 +1,158 @@
+#include "ShaderPermutations.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+Shader& ShaderPermutations::Get(const char* vertexFile, const char* fragmentFile, std::vector<std::string> defines)
+{
+	// The order defines are listed in doesn't change the permutation.
+	std::sort(defines.begin(), defines.end());
+	defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+
+	std::string key{ std::string(vertexFile) + "|" + fragmentFile };
+	for (const std::string& define : defines)
+	{
+		key += "|" + define;
+	}
+
+	std::unordered_map<std::string, Permutation>::iterator it{ programs.find(key) };
+	if (it != programs.end())
+		return *it->second.Program;
+
+	Permutation permutation;
+	permutation.VertexFile = vertexFile;
+	permutation.FragmentFile = fragmentFile;
+	permutation.Defines = std::move(defines);
+
+	std::string vertexSource;
+	std::string fragmentSource;
+	ReadSources(permutation, vertexSource, fragmentSource);
+	permutation.Program = std::make_unique<Shader>(vertexSource.c_str(), fragmentSource.c_str());
+
+	return *programs.emplace(key, std::move(permutation)).first->second.Program;
+}
+
+void ShaderPermutations::ReadSources(Permutation& permutation, std::string& vertexSource, std::string& fragmentSource)
+{
+	std::vector<std::string> files;
+	vertexSource = preprocess_shader(permutation.VertexFile.c_str(), permutation.Defines, &files);
+	fragmentSource = preprocess_shader(permutation.FragmentFile.c_str(), permutation.Defines, &files);
+
+	permutation.Files.clear();
+	for (const std::string& file : files)
+	{
+		watcher.Watch(file);
+		permutation.Files.push_back(std::filesystem::path(file).lexically_normal().generic_string());
+	}
+}
+
+void ShaderPermutations::HotReload(double budgetSeconds)
+{
+	std::chrono::steady_clock::time_point startTime{ std::chrono::steady_clock::now() };
+
+	for (const std::string& file : watcher.Changed())
+	{
+		for (std::pair<const std::string, Permutation>& entry : programs)
+		{
+			if (std::find(entry.second.Files.begin(), entry.second.Files.end(), file) != entry.second.Files.end())
+				entry.second.Stale = true;
+		}
+	}
+
+	// Without parallel compile, starting or finishing a build waits for the driver, so only
+	// one of those runs per call.
+	bool parallel{ Shader::ParallelCompile() };
+	bool blocked{ false };
+	auto withinBudget = [&]()
+	{
+		return !blocked && std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() < budgetSeconds;
+	};
+
+	// Finish the builds started on earlier frames first; with parallel compile these only
+	// query the driver until the build is done.
+	for (std::pair<const std::string, Permutation>& entry : programs)
+	{
+		if (!entry.second.Program->Reloading())
+			continue;
+		if (!withinBudget())
+			break;
+
+		Shader::ReloadState state{ entry.second.Program->PollReload() };
+		if (!parallel)
+			blocked = true;
+
+		if (state == Shader::ReloadState::Swapped)
+		{
+			Reloads++;
+			std::cout << "- Reloaded " << entry.first << "\n";
+		}
+		else if (state == Shader::ReloadState::Failed)
+		{
+			ReloadFailures++;
+			std::cerr << "- Kept the previous " << entry.first << " after a failed reload\n";
+		}
+	}
+
+	for (std::pair<const std::string, Permutation>& entry : programs)
+	{
+		Permutation& permutation{ entry.second };
+		if (!permutation.Stale || permutation.Program->Reloading())
+			continue;
+		if (!withinBudget())
+			break;
+
+		permutation.Stale = false;
+
+		std::string vertexSource;
+		std::string fragmentSource;
+		try
+		{
+			ReadSources(permutation, vertexSource, fragmentSource);
+		}
+		catch (...)
+		{
+			// A missing include or a file caught mid-save; the next write tries again.
+			ReloadFailures++;
+			std::cerr << "- Could not read the sources of " << entry.first << "\n";
+			continue;
+		}
+
+		permutation.Program->BeginReload(vertexSource.c_str(), fragmentSource.c_str());
+		if (!parallel)
+			blocked = true;
+	}
+}
+
+size_t ShaderPermutations::CacheHits() const
+{
+	size_t hits{ 0 };
+	for (const std::pair<const std::string, Permutation>& entry : programs)
+	{
+		hits += entry.second.Program->FromBinaryCache;
+	}
+
+	return hits;
+}
+
+double ShaderPermutations::LoadSeconds() const
+{
+	double seconds{ 0.0 };
+	for (const std::pair<const std::string, Permutation>& entry : programs)
+	{
+		seconds += entry.second.Program->LoadSeconds;
+	}
+
+	return seconds;
+}
+
+void ShaderPermutations::Delete()
+{
+	for (std::pair<const std::string, Permutation>& entry : programs)
+	{
+		entry.second.Program->SaveReloadedBinary();
+		entry.second.Program->Delete();
+	}
+
+	programs.clear();
+}
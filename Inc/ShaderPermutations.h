@@ -0,0 +1,50 @@
+#pragma once
+
+#include "FileWatcher.h"
+#include "Shader.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Builds programs from preprocessed shader files, one per distinct set of defines.
+//
+// Draws that ask for the same files and features get the same Shader, so objects that
+// only differ in their ObjectData share a program and can be drawn without switching.
+class ShaderPermutations
+{
+public:
+	Shader& Get(const char* vertexFile, const char* fragmentFile, std::vector<std::string> defines = {});
+
+	size_t Count() const { return programs.size(); }
+	size_t CacheHits() const;
+	double LoadSeconds() const;
+
+	// Rebuilds programs whose files (includes too) changed on disk; the Shader objects stay
+	// the same, only their IDs change. Builds are polled and started only while less than
+	// budgetSeconds has been spent in this call. Without parallel compile a build blocks in
+	// the driver, so at most one build is started or finished per call, and that one step
+	// can still take longer than the budget. Reloaded programs go to the binary cache in
+	// Delete, not during a frame.
+	void HotReload(double budgetSeconds);
+	size_t Reloads{ 0 };
+	size_t ReloadFailures{ 0 };
+
+	void Delete();
+
+private:
+	struct Permutation
+	{
+		std::unique_ptr<Shader> Program;
+		std::string VertexFile;
+		std::string FragmentFile;
+		std::vector<std::string> Defines;
+		std::vector<std::string> Files;
+		bool Stale{ false };
+	};
+	std::unordered_map<std::string, Permutation> programs;
+	FileWatcher watcher;
+
+	// Preprocesses both stages and watches every file they read.
+	void ReadSources(Permutation& permutation, std::string& vertexSource, std::string& fragmentSource);
+};
@@ -1,91 +1,197 @@
-#include "Texture.h"
-
-Texture::Texture(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType)
-{
-	type = texType;
-	int widthImg, heightImg, numColCh;
-	stbi_set_flip_vertically_on_load(true);
-	unsigned char* bytes{ stbi_load(image, &widthImg, &heightImg, &numColCh, 0) };
-
-	glGenTextures(1, &ID);
-	glActiveTexture(GL_TEXTURE0 + slot);
-	unit = slot;
-	glBindTexture(texType, ID);
-
-	glTexParameteri(texType, GL_TEXTURE_MIN_FILTER, interpolationType);
-	glTexParameteri(texType, GL_TEXTURE_MAG_FILTER, interpolationType);
-
-	glTexParameteri(texType, GL_TEXTURE_WRAP_S, texMappingType);
-	glTexParameteri(texType, GL_TEXTURE_WRAP_T, texMappingType);
-
-	//glTexImage2D(texType, 0, GL_RGBA, widthImg, heightImg, 0, format, pixelType, bytes);
-	if (numColCh == 4)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_SRGB_ALPHA,
-			widthImg,
-			heightImg,
-			0,
-			GL_RGBA,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
-	else if (numColCh == 3)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_SRGB,
-			widthImg,
-			heightImg,
-			0,
-			GL_RGB,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
-	else if (numColCh == 1)
-		glTexImage2D
-		(
-			GL_TEXTURE_2D,
-			0,
-			GL_SRGB,
-			widthImg,
-			heightImg,
-			0,
-			GL_RED,
-			GL_UNSIGNED_BYTE,
-			bytes
-		);
-	else
-		throw std::invalid_argument("Automatic Texture type recognition failed");
-
-	glGenerateMipmap(texType);
-
-	stbi_image_free(bytes);
-	glBindTexture(texType, 0);
-}
-
-void Texture::texUnit(Shader& shader, const char* uniform, GLuint unit)
-{
-	GLint texUni{ glGetUniformLocation(shader.ID, uniform) };
-	shader.Activate();
-	glUniform1i(texUni, unit);
-}
-
-void Texture::Bind()
-{
-	glActiveTexture(GL_TEXTURE0 + unit);
-	glBindTexture(type, ID);
-}
-
-void Texture::Unbind()
-{
-	glBindTexture(type, 0);
-}
-
-void Texture::Delete()
-{
-	glDeleteTextures(1, &ID);
+#include "Texture.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <iostream>
+
+MipGenerator::Filter Texture::MipFilter{ MipGenerator::Filter::Kaiser };
+
+Texture::Texture(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType)
+{
+	int widthImg, heightImg, numColCh;
+	stbi_set_flip_vertically_on_load(true);
+	// Always RGBA, the layout MipGenerator works on.
+	unsigned char* bytes{ stbi_load(image, &widthImg, &heightImg, &numColCh, 4) };
+
+	Create(texType, slot, interpolationType, texMappingType);
+
+	//glTexImage2D(texType, 0, GL_RGBA, widthImg, heightImg, 0, format, pixelType, bytes);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, widthImg, heightImg, 0, GL_RGBA, GL_UNSIGNED_BYTE, bytes);
+
+	if (bytes)
+	{
+		std::vector<MipGenerator::Level> levels{ MipGenerator::Generate(bytes, (uint32_t)widthImg, (uint32_t)heightImg, true, MipFilter) };
+		for (size_t level{ 0 }; level < levels.size(); level++)
+			glTexImage2D(GL_TEXTURE_2D, (GLint)level + 1, GL_SRGB_ALPHA, (GLsizei)levels[level].Width, (GLsizei)levels[level].Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[level].Pixels.data());
+		glTexParameteri(texType, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size());
+	}
+
+	stbi_image_free(bytes);
+	GLStateCache::Get().BindTexture(texType, 0);
+}
+
+Texture::Texture(const GLubyte placeholder[4], GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType)
+{
+	Create(texType, slot, interpolationType, texMappingType);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+
+	GLStateCache::Get().BindTexture(texType, 0);
+}
+
+Texture::Texture(const TextureCompressor::Image& image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType)
+{
+	GLenum internalFormat{ CompressedFormat(image.BlockFormat, image.SRGB) };
+	if (!internalFormat)
+		throw std::invalid_argument("Compressed texture format not supported");
+
+	Create(texType, slot, interpolationType, texMappingType);
+
+	GLsizei width{ (GLsizei)image.Width };
+	GLsizei height{ (GLsizei)image.Height };
+	for (size_t level{ 0 }; level < image.Levels.size(); level++)
+	{
+		glCompressedTexImage2D(texType, (GLint)level, internalFormat, width, height, 0, (GLsizei)image.Levels[level].size(), image.Levels[level].data());
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	glTexParameteri(texType, GL_TEXTURE_MAX_LEVEL, (GLint)image.Levels.size() - 1);
+
+	GLStateCache::Get().BindTexture(texType, 0);
+}
+
+void Texture::Create(GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType)
+{
+	type = texType;
+
+	glGenTextures(1, &ID);
+	GLStateCache::Get().ActiveTexture(slot);
+	unit = slot;
+	GLStateCache::Get().BindTexture(texType, ID);
+
+	glTexParameteri(texType, GL_TEXTURE_MIN_FILTER, interpolationType);
+	glTexParameteri(texType, GL_TEXTURE_MAG_FILTER, interpolationType);
+
+	glTexParameteri(texType, GL_TEXTURE_WRAP_S, texMappingType);
+	glTexParameteri(texType, GL_TEXTURE_WRAP_T, texMappingType);
+}
+
+GLenum Texture::CompressedFormat(TextureCompressor::Format format, bool srgb)
+{
+	// RGTC is core since 3.0; S3TC and its sRGB variants are extensions every desktop driver has.
+	bool s3tc{ GLAD_GL_EXT_texture_compression_s3tc && (!srgb || GLAD_GL_EXT_texture_sRGB) };
+
+	switch (format)
+	{
+	case TextureCompressor::Format::BC1: return !s3tc ? 0 : srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case TextureCompressor::Format::BC3: return !s3tc ? 0 : srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case TextureCompressor::Format::BC4: return GL_COMPRESSED_RED_RGTC1;
+	case TextureCompressor::Format::BC5: return GL_COMPRESSED_RG_RGTC2;
+	}
+	return 0;
+}
+
+size_t Texture::Bytes() const
+{
+	GLStateCache::Get().BindTexture(type, ID);
+
+	// Levels under the base level may have been dropped.
+	GLint baseLevel{ 0 };
+	glGetTexParameteriv(type, GL_TEXTURE_BASE_LEVEL, &baseLevel);
+
+	size_t bytes{ 0 };
+	for (GLint level{ baseLevel };; level++)
+	{
+		GLint width{ 0 }, height{ 0 }, compressed{ 0 };
+		glGetTexLevelParameteriv(type, level, GL_TEXTURE_WIDTH, &width);
+		glGetTexLevelParameteriv(type, level, GL_TEXTURE_HEIGHT, &height);
+		if (width == 0 || height == 0)
+			break;
+
+		glGetTexLevelParameteriv(type, level, GL_TEXTURE_COMPRESSED, &compressed);
+		if (compressed)
+		{
+			GLint size{ 0 };
+			glGetTexLevelParameteriv(type, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+			bytes += (size_t)size;
+			continue;
+		}
+
+		GLint bits{ 0 };
+		for (GLenum component : { GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE })
+		{
+			GLint size{ 0 };
+			glGetTexLevelParameteriv(type, level, component, &size);
+			bits += size;
+		}
+		// Drivers keep 3 byte texels padded out to 4.
+		size_t texelBytes{ (size_t)(bits + 7) / 8 };
+		bytes += (size_t)width * height * (texelBytes == 3 ? 4 : texelBytes);
+	}
+
+	GLStateCache::Get().BindTexture(type, 0);
+	return bytes;
+}
+
+void Texture::PrintMipReport(const char* image)
+{
+	int width, height, channels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* bytes{ stbi_load(image, &width, &height, &channels, 4) };
+	if (!bytes)
+	{
+		std::cerr << "Failed to load texture " << image << "\n";
+		return;
+	}
+
+	// What the driver makes of the same image.
+	GLuint texture;
+	glGenTextures(1, &texture);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, bytes);
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	std::vector<MipGenerator::Level> driverLevels;
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	for (GLint level{ 1 };; level++)
+	{
+		GLint levelWidth{ 0 }, levelHeight{ 0 };
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &levelWidth);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &levelHeight);
+		if (levelWidth == 0 || levelHeight == 0)
+			break;
+
+		driverLevels.emplace_back();
+		driverLevels.back().Width = (uint32_t)levelWidth;
+		driverLevels.back().Height = (uint32_t)levelHeight;
+		driverLevels.back().Pixels.resize((size_t)levelWidth * levelHeight * 4);
+		glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, driverLevels.back().Pixels.data());
+	}
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	GLStateCache::Get().BindTexture(GL_TEXTURE_2D, 0);
+	GLStateCache::Get().DeleteTexture(texture);
+
+	MipGenerator::PrintReport(image, bytes, (uint32_t)width, (uint32_t)height, true, driverLevels);
+	stbi_image_free(bytes);
+}
+
+void Texture::texUnit(Shader& shader, const char* uniform, GLuint unit)
+{
+	shader.Activate();
+	shader.SetInt(uniform, (GLint)unit);
+}
+
+void Texture::Bind()
+{
+	GLStateCache::Get().BindTexture(unit, type, ID);
+}
+
+void Texture::Unbind()
+{
+	GLStateCache::Get().BindTexture(type, 0);
+}
+
+void Texture::Delete()
+{
+	GLStateCache::Get().DeleteTexture(ID);
 }
\ No newline at end of file
@@ -1,21 +1,42 @@
-#pragma once
-
-#include "glad/glad.h"
-#include "stb_image.h"
-
-#include "Shader.h"
-
-class Texture
-{
-public:
-	GLuint ID;
-	GLenum type;
-	GLuint unit;
-
-	Texture(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType);
-
-	void texUnit(Shader& shader, const char* uniform, GLuint unit);
-	void Bind();
-	void Unbind();
-	void Delete();
+#pragma once
+
+#include "glad/glad.h"
+#include "stb_image.h"
+
+#include "MipGenerator.h"
+#include "Shader.h"
+#include "TextureCompressor.h"
+
+class Texture
+{
+public:
+	GLuint ID;
+	GLenum type;
+	GLuint unit;
+
+	Texture(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType);
+	// Uploads a block compressed image and its stored mip chain as is.
+	Texture(const TextureCompressor::Image& image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType);
+	// A 1x1 texture of the placeholder RGBA color, for a TextureLoader to fill in later.
+	Texture(const GLubyte placeholder[4], GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType);
+
+	// Filter for the mip chains of images loaded from files, built on the CPU in linear space.
+	static MipGenerator::Filter MipFilter;
+
+	// Internal format of a compressed image, or 0 if the driver cannot sample it.
+	static GLenum CompressedFormat(TextureCompressor::Format format, bool srgb);
+
+	// Texture memory of the levels from the base level up, as the driver reports it.
+	size_t Bytes() const;
+
+	// Benchmarks MipGenerator on an image and compares it with glGenerateMipmap.
+	static void PrintMipReport(const char* image);
+
+	void texUnit(Shader& shader, const char* uniform, GLuint unit);
+	void Bind();
+	void Unbind();
+	void Delete();
+
+private:
+	void Create(GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType);
 };
\ No newline at end of file
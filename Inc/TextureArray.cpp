@@ -0,0 +1,79 @@
+#include "TextureArray.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GLStateCache.h"
+
+TextureArray::TextureArray(const std::vector<std::string>& images, GLuint slot, GLenum interpolationType, GLenum texMappingType, GLsizei layerSize, const GLubyte placeholder[4])
+{
+	ID = 0;
+	type = GL_TEXTURE_2D_ARRAY;
+	unit = slot;
+
+	Images = images;
+	std::memcpy(Placeholder, placeholder, sizeof(Placeholder));
+	Width = layerSize;
+	Height = layerSize;
+	Layers = (GLsizei)images.size();
+	Levels = 1;
+	while ((layerSize >> Levels) > 0)
+		Levels++;
+
+	if (images.empty())
+		return;
+
+	glGenTextures(1, &ID);
+	GLStateCache::Get().ActiveTexture(slot);
+	GLStateCache::Get().BindTexture(type, ID);
+
+	// Minified through the whole chain, filtered within and between levels alike.
+	glTexParameteri(type, GL_TEXTURE_MIN_FILTER, interpolationType == GL_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(type, GL_TEXTURE_MAG_FILTER, interpolationType);
+
+	glTexParameteri(type, GL_TEXTURE_WRAP_S, texMappingType);
+	glTexParameteri(type, GL_TEXTURE_WRAP_T, texMappingType);
+
+	std::vector<GLubyte> texels;
+	for (GLsizei layer{ 0 }; layer < Layers; layer++)
+		texels.insert(texels.end(), Placeholder, Placeholder + 4);
+	glTexImage3D(type, 0, GL_SRGB_ALPHA, 1, 1, Layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+	glTexParameteri(type, GL_TEXTURE_MAX_LEVEL, 0);
+
+	GLStateCache::Get().BindTexture(type, 0);
+}
+
+size_t TextureArray::Bytes() const
+{
+	size_t bytes{ 0 };
+	GLsizei width{ Width };
+	GLsizei height{ Height };
+	for (GLint level{ 0 }; level < Levels; level++)
+	{
+		bytes += size_t(width) * height * 4 * Layers;
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	return bytes;
+}
+
+void TextureArray::texUnit(Shader& shader, const char* uniform, GLuint unit)
+{
+	shader.Activate();
+	shader.SetInt(uniform, (GLint)unit);
+}
+
+void TextureArray::Bind()
+{
+	GLStateCache::Get().BindTexture(unit, type, ID);
+}
+
+void TextureArray::Unbind()
+{
+	GLStateCache::Get().BindTexture(type, 0);
+}
+
+void TextureArray::Delete()
+{
+	GLStateCache::Get().DeleteTexture(ID);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+
+// Several images in one GL_TEXTURE_2D_ARRAY, so every material made of them binds it once.
+//
+// Every image is resized to one layer size and gets a layer of its own with its whole mip
+// chain, so a surface seen at a grazing angle can sample the coarsest levels like a separate
+// texture would. Texture coordinates span the image whatever its size, so resizing only
+// changes how many texels it has. Until TextureCache::Load has the layers decoded on the
+// worker pool and uploaded, each layer is a single placeholder texel. Image i is layer i
+// (see TEXTURE_ARRAY in Shaders/lit.frag).
+class TextureArray
+{
+public:
+	GLuint ID;
+	GLenum type;
+	GLuint unit;
+
+	TextureArray(const std::vector<std::string>& images, GLuint slot, GLenum interpolationType, GLenum texMappingType, GLsizei layerSize, const GLubyte placeholder[4]);
+
+	std::vector<std::string> Images;
+	GLubyte Placeholder[4];
+	GLsizei Width{ 0 };
+	GLsizei Height{ 0 };
+	GLsizei Layers{ 0 };
+	GLint Levels{ 0 };
+
+	// Once every layer is in.
+	size_t Bytes() const;
+
+	void texUnit(Shader& shader, const char* uniform, GLuint unit);
+	void Bind();
+	void Unbind();
+	void Delete();
+};
@@ -0,0 +1,402 @@
+#include "TextureCache.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+TextureCache::Handle::Handle(Entry* entry, GLuint unit)
+	: entry(entry), unit(unit)
+{
+	if (entry)
+		Target()->References++;
+}
+
+TextureCache::Handle::Handle(const Handle& other)
+	: entry(other.entry), unit(other.unit)
+{
+	if (entry)
+		Target()->References++;
+}
+
+TextureCache::Handle& TextureCache::Handle::operator=(const Handle& other)
+{
+	if (other.entry)
+		other.Target()->References++;
+	if (entry)
+		Target()->References--;
+
+	entry = other.entry;
+	unit = other.unit;
+	return *this;
+}
+
+TextureCache::Handle::~Handle()
+{
+	if (entry)
+		Target()->References--;
+}
+
+TextureCache::Entry* TextureCache::Handle::Target() const
+{
+	return entry && entry->Shared ? entry->Shared : entry;
+}
+
+void TextureCache::Handle::texUnit(Shader& shader, const char* uniform, GLuint unit)
+{
+	shader.Activate();
+	shader.SetInt(uniform, (GLint)unit);
+}
+
+void TextureCache::Handle::Bind()
+{
+	GLStateCache::Get().BindTexture(unit, Target()->Tex.type, Target()->Tex.ID);
+}
+
+void TextureCache::Handle::Unbind()
+{
+	GLStateCache::Get().BindTexture(Target()->Tex.type, 0);
+}
+
+void TextureCache::Handle::Use(float screenPixels)
+{
+	Target()->ScreenPixels = std::max(Target()->ScreenPixels, screenPixels);
+}
+
+GLuint TextureCache::Handle::ID() const
+{
+	return entry ? Target()->Tex.ID : 0;
+}
+
+TextureCache::TextureCache(ThreadPool& pool, size_t budgetBytes)
+	: BudgetBytes(budgetBytes), loader(pool)
+{
+	loader.Decoded = [this](GLuint textureID, uint64_t hash, uint32_t width, uint32_t height)
+	{
+		return Decoded(textureID, hash, width, height);
+	};
+}
+
+size_t TextureCache::Entry::Bytes() const
+{
+	size_t bytes{ 0 };
+	for (size_t level{ (size_t)BaseLevel }; level < LevelBytes.size(); level++)
+		bytes += LevelBytes[level];
+	return bytes;
+}
+
+TextureCache::Handle TextureCache::Get(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType, const GLubyte placeholder[4])
+{
+	Lookups++;
+
+	Entry* found{ Find(byPath, image, texType, interpolationType, texMappingType) };
+	if (found)
+	{
+		Hits++;
+		return Handle(found, slot);
+	}
+
+	std::unique_ptr<Entry> entry;
+	std::string compressedPath{ TextureCompressor::CompressedPath(image) };
+	TextureCompressor::Image compressed;
+	if (UseCompressed && TextureCompressor::ReadDDS(compressedPath, compressed) && Texture::CompressedFormat(compressed.BlockFormat, compressed.SRGB))
+	{
+		// Already in memory, so hashing it reads nothing more, and a match uploads nothing.
+		uint64_t hash{ 0xCBF29CE484222325ull };
+		for (const std::vector<uint8_t>& level : compressed.Levels)
+			hash = (hash ^ TextureLoader::Hash(level.data(), level.size())) * 0x100000001B3ull;
+
+		Entry* same{ Find(byHash, hash, texType, interpolationType, texMappingType) };
+		if (same)
+		{
+			SharedHits++;
+			byPath.emplace(image, same);
+			return Handle(same, slot);
+		}
+
+		entry = std::make_unique<Entry>(Texture(compressed, texType, slot, interpolationType, texMappingType));
+		entry->CompressedImage = compressedPath;
+		entry->Hash = hash;
+		entry->Width = compressed.Width;
+		entry->Height = compressed.Height;
+		for (const std::vector<uint8_t>& level : compressed.Levels)
+			entry->LevelBytes.push_back(level.size());
+		entry->CompressedFormat = Texture::CompressedFormat(compressed.BlockFormat, compressed.SRGB);
+		entry->CompressedLevels = std::move(compressed.Levels);
+	}
+	else
+	{
+		// The 1x1 placeholder until the loader has decoded the image (see Decoded).
+		entry = std::make_unique<Entry>(Texture(placeholder, texType, slot, interpolationType, texMappingType));
+		loader.Load(entry->Tex, image);
+		entry->LevelBytes.push_back(4);
+	}
+
+	entry->Interpolation = interpolationType;
+	entry->Wrap = texMappingType;
+	entry->Image = image;
+	entry->LastUsed = frame;
+
+	Entry* added{ entry.get() };
+	entries.push_back(std::move(entry));
+	byPath.emplace(image, added);
+	if (added->Hash)
+		byHash.emplace(added->Hash, added);
+
+	MakeRoom(0, added, false);
+	return Handle(added, slot);
+}
+
+bool TextureCache::Decoded(GLuint textureID, uint64_t hash, uint32_t width, uint32_t height)
+{
+	auto decoded{ std::find_if(entries.begin(), entries.end(), [textureID](const std::unique_ptr<Entry>& entry) { return entry->Tex.ID == textureID; }) };
+	if (decoded == entries.end())
+		return true;
+	Entry& entry{ **decoded };
+
+	Entry* same{ Find(byHash, hash, entry.Tex.type, entry.Interpolation, entry.Wrap) };
+	if (same)
+	{
+		Share(entry, *same);
+		return false;
+	}
+
+	entry.Hash = hash;
+	byHash.emplace(hash, &entry);
+
+	// What the loader is about to allocate.
+	entry.Width = width;
+	entry.Height = height;
+	entry.LevelBytes.clear();
+	while (true)
+	{
+		entry.LevelBytes.push_back((size_t)width * height * 4);
+		if (width == 1 && height == 1)
+			break;
+		width = std::max(width / 2, 1u);
+		height = std::max(height / 2, 1u);
+	}
+
+	MakeRoom(0, &entry, false);
+	return true;
+}
+
+void TextureCache::Share(Entry& entry, Entry& same)
+{
+	SharedHits++;
+
+	same.References += entry.References;
+	same.ScreenPixels = std::max(same.ScreenPixels, entry.ScreenPixels);
+	same.LastUsed = std::max(same.LastUsed, entry.LastUsed);
+	entry.References = 0;
+	entry.Shared = &same;
+
+	// Later lookups of its path go straight to same.
+	for (auto path{ byPath.begin() }; path != byPath.end(); path++)
+	{
+		if (path->second == &entry)
+			path->second = &same;
+	}
+
+	entry.Tex.Delete();
+	auto retired{ std::find_if(entries.begin(), entries.end(), [&entry](const std::unique_ptr<Entry>& cached) { return cached.get() == &entry; }) };
+	sharing.push_back(std::move(*retired));
+	entries.erase(retired);
+}
+
+void TextureCache::Load(TextureArray& array)
+{
+	loader.LoadArray(array.ID, array.type, array.Images, array.Width, array.Height, array.Placeholder);
+	arrays.push_back(&array);
+	MakeRoom(0, nullptr, false);
+}
+
+void TextureCache::Update()
+{
+	frame++;
+
+	// Entries with handles are never evicted, so these pointers outlive MakeRoom.
+	std::vector<Entry*> referenced;
+	for (std::unique_ptr<Entry>& entry : entries)
+	{
+		if (entry->References > 0)
+			referenced.push_back(entry.get());
+	}
+
+	for (Entry* entry : referenced)
+	{
+		if (entry->ScreenPixels > 0.0f)
+		{
+			// Coarsest level that still has a texel for every pixel.
+			float texels{ (float)std::max(entry->Width, entry->Height) };
+			GLint wanted{ 0 };
+			while (wanted < entry->TopLevel() && texels * 0.5f >= entry->ScreenPixels)
+			{
+				texels *= 0.5f;
+				wanted++;
+			}
+
+			entry->WantedLevel = wanted;
+			entry->LastUsed = frame;
+			entry->ScreenPixels = 0.0f;
+		}
+
+		if (Busy(*entry))
+			continue;
+
+		if (entry->WantedLevel < entry->BaseLevel)
+		{
+			// As many of the missing levels as fit without taking from anything drawn this frame.
+			GLint level{ entry->BaseLevel };
+			size_t extraBytes{ 0 };
+			while (level > entry->WantedLevel && MakeRoom(extraBytes + entry->LevelBytes[level - 1], entry, true))
+			{
+				extraBytes += entry->LevelBytes[level - 1];
+				level--;
+			}
+
+			if (level < entry->BaseLevel)
+				StreamIn(*entry, level);
+		}
+		else if (entry->WantedLevel > entry->BaseLevel + 1)
+		{
+			// One level of slack so a texture on the edge does not stream every frame.
+			StreamOut(*entry, entry->WantedLevel - 1);
+		}
+	}
+
+	MakeRoom(0, nullptr, false);
+	loader.Update();
+}
+
+void TextureCache::Finish()
+{
+	loader.Finish();
+}
+
+float TextureCache::ScreenPixels(float worldSize, float distance, float screenHeight, float fovDegrees)
+{
+	return worldSize * screenHeight / (2.0f * std::tan(fovDegrees * 0.5f * 3.14159265f / 180.0f) * std::max(distance, 0.001f));
+}
+
+size_t TextureCache::Compressed() const
+{
+	return (size_t)std::count_if(entries.begin(), entries.end(), [](const std::unique_ptr<Entry>& entry) { return !entry->CompressedImage.empty(); });
+}
+
+size_t TextureCache::ResidentBytes() const
+{
+	size_t bytes{ 0 };
+	for (const std::unique_ptr<Entry>& entry : entries)
+		bytes += entry->Bytes();
+	for (const TextureArray* array : arrays)
+		bytes += array->Bytes();
+	return bytes;
+}
+
+void TextureCache::StreamIn(Entry& entry, GLint level)
+{
+	LevelsStreamedIn += (size_t)(entry.BaseLevel - level);
+
+	if (entry.CompressedImage.empty())
+	{
+		loader.LoadLevels(entry.Tex, entry.Image.c_str(), level, entry.BaseLevel);
+		entry.BaseLevel = level;
+		return;
+	}
+
+	// Block compressed levels are small and need no decoding; upload them right away from the
+	// copy Get kept.
+	GLStateCache::Get().BindTexture(entry.Tex.type, entry.Tex.ID);
+	for (GLint l{ level }; l < entry.BaseLevel; l++)
+	{
+		GLsizei width{ std::max((GLsizei)entry.Width >> l, 1) };
+		GLsizei height{ std::max((GLsizei)entry.Height >> l, 1) };
+		const std::vector<uint8_t>& data{ entry.CompressedLevels[l] };
+		glCompressedTexImage2D(entry.Tex.type, l, entry.CompressedFormat, width, height, 0, (GLsizei)data.size(), data.data());
+	}
+	glTexParameteri(entry.Tex.type, GL_TEXTURE_BASE_LEVEL, level);
+	GLStateCache::Get().BindTexture(entry.Tex.type, 0);
+
+	entry.BaseLevel = level;
+}
+
+void TextureCache::StreamOut(Entry& entry, GLint level)
+{
+	level = std::min(level, entry.TopLevel());
+	if (level <= entry.BaseLevel)
+		return;
+
+	GLStateCache::Get().BindTexture(entry.Tex.type, entry.Tex.ID);
+	glTexParameteri(entry.Tex.type, GL_TEXTURE_BASE_LEVEL, level);
+	// Respecifying a level as 0x0 lets the driver release its memory.
+	for (GLint l{ entry.BaseLevel }; l < level; l++)
+		glTexImage2D(entry.Tex.type, l, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	GLStateCache::Get().BindTexture(entry.Tex.type, 0);
+
+	LevelsStreamedOut += (size_t)(level - entry.BaseLevel);
+	entry.BaseLevel = level;
+}
+
+void TextureCache::Evict(Entry& entry)
+{
+	entry.Tex.Delete();
+	Evictions++;
+
+	for (auto path{ byPath.begin() }; path != byPath.end();)
+		path = path->second == &entry ? byPath.erase(path) : std::next(path);
+	for (auto hash{ byHash.begin() }; hash != byHash.end();)
+		hash = hash->second == &entry ? byHash.erase(hash) : std::next(hash);
+
+	entries.erase(std::find_if(entries.begin(), entries.end(), [&entry](const std::unique_ptr<Entry>& cached) { return cached.get() == &entry; }));
+}
+
+bool TextureCache::MakeRoom(size_t extraBytes, const Entry* keep, bool spareUsed)
+{
+	while (ResidentBytes() + extraBytes > BudgetBytes)
+	{
+		auto candidate = [&](const Entry& entry)
+		{
+			return &entry != keep && !(spareUsed && entry.LastUsed == frame) && !Busy(entry);
+		};
+
+		// Unreferenced textures go first, least recently used first.
+		Entry* victim{ nullptr };
+		for (std::unique_ptr<Entry>& entry : entries)
+		{
+			if (entry->References == 0 && candidate(*entry) && (!victim || entry->LastUsed < victim->LastUsed))
+				victim = entry.get();
+		}
+		if (victim)
+		{
+			Evict(*victim);
+			continue;
+		}
+
+		// Then the finest level of the least recently used texture, the largest on a tie.
+		for (std::unique_ptr<Entry>& entry : entries)
+		{
+			if (entry->BaseLevel < entry->TopLevel() && candidate(*entry) &&
+				(!victim || entry->LastUsed < victim->LastUsed || (entry->LastUsed == victim->LastUsed && entry->Bytes() > victim->Bytes())))
+				victim = entry.get();
+		}
+		if (!victim)
+			return false;
+
+		StreamOut(*victim, victim->BaseLevel + 1);
+	}
+
+	return true;
+}
+
+void TextureCache::Delete()
+{
+	loader.Delete();
+
+	for (std::unique_ptr<Entry>& entry : entries)
+		entry->Tex.Delete();
+
+	// Handles may still point at the entries; they go with the cache.
+	byPath.clear();
+	byHash.clear();
+	arrays.clear();
+}
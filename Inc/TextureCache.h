@@ -0,0 +1,168 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+#include "Texture.h"
+#include "TextureArray.h"
+#include "TextureLoader.h"
+#include "ThreadPool.h"
+
+// Shared, budgeted textures.
+//
+// Get looks an image up by path and loads it (the .dds copy if there is one, else through a
+// TextureLoader) when that misses. Once the loader has decoded it, an image with the same
+// contents as one already loaded is dropped and its handles share the other texture. Either
+// way only textures sampled alike are shared. Handles count references; an unreferenced
+// texture stays resident until the budget needs its memory.
+// Every frame, draws report how large each texture appears on screen with Use, and Update
+// drops mip levels finer than that or streams them back in. Over budget, unreferenced
+// textures are evicted least recently used first, then the finest levels of the rest.
+// Texture arrays load through the same loader and count against the same budget, but stay
+// resident whole; the other textures make room for them.
+class TextureCache
+{
+	struct Entry;
+
+public:
+	class Handle
+	{
+	public:
+		Handle() = default;
+		Handle(const Handle& other);
+		Handle& operator=(const Handle& other);
+		~Handle();
+
+		void texUnit(Shader& shader, const char* uniform, GLuint unit);
+		void Bind();
+		void Unbind();
+
+		// screenPixels: how many pixels one repeat of the texture spans on screen in a draw
+		// this frame, e.g. from ScreenPixels. The largest of the frame wins.
+		void Use(float screenPixels);
+
+		GLuint ID() const;
+
+	private:
+		friend class TextureCache;
+		Handle(Entry* entry, GLuint unit);
+
+		// The entry, or the one it turned out to share.
+		Entry* Target() const;
+
+		Entry* entry{ nullptr };
+		GLuint unit{ 0 };
+	};
+
+	TextureCache(ThreadPool& pool, size_t budgetBytes = 64 * 1024 * 1024);
+
+	Handle Get(const char* image, GLenum texType, GLuint slot, GLenum interpolationType, GLenum texMappingType, const GLubyte placeholder[4]);
+	// Queues the layers of array, which has to outlive the cache or be loaded again after Delete.
+	void Load(TextureArray& array);
+	// Streams and evicts for this frame's Use calls, then uploads what the loader has ready.
+	void Update();
+	// Loads everything still queued, without a per-frame limit.
+	void Finish();
+
+	// Size in pixels of worldSize units seen from distance, like MeshCache::SelectLod.
+	static float ScreenPixels(float worldSize, float distance, float screenHeight, float fovDegrees);
+
+	// Use the .dds copy of an image (see Tools/TextureBaker) when the driver can sample it.
+	bool UseCompressed{ true };
+	size_t BudgetBytes;
+
+	size_t Pending() const { return loader.Pending(); }
+	size_t Count() const { return entries.size(); }
+	size_t Compressed() const;
+	size_t ResidentBytes() const;
+
+	size_t Lookups{ 0 };
+	size_t Hits{ 0 };
+	// Misses that turned out to have the contents of a texture already loaded.
+	size_t SharedHits{ 0 };
+	size_t Evictions{ 0 };
+	size_t LevelsStreamedIn{ 0 };
+	size_t LevelsStreamedOut{ 0 };
+
+	float HitRate() const { return Lookups ? 100.0f * float(Hits) / float(Lookups) : 0.0f; }
+
+	void Delete();
+
+private:
+	struct Entry
+	{
+		Entry(const Texture& texture) : Tex(texture) {}
+
+		Texture Tex;
+		GLenum Interpolation{ 0 };
+		GLenum Wrap{ 0 };
+		std::string Image;
+		std::string CompressedImage;
+		// Every level of the .dds, kept so streaming a level back in reads no file.
+		std::vector<std::vector<uint8_t>> CompressedLevels;
+		GLenum CompressedFormat{ 0 };
+		uint64_t Hash{ 0 };
+		// 0 until decoded, as LevelBytes is only the placeholder's until then.
+		uint32_t Width{ 0 };
+		uint32_t Height{ 0 };
+		// Bytes of each level, and the finest level resident or on its way.
+		std::vector<size_t> LevelBytes;
+		GLint BaseLevel{ 0 };
+		GLint WantedLevel{ 0 };
+
+		size_t References{ 0 };
+		float ScreenPixels{ 0.0f };
+		uint64_t LastUsed{ 0 };
+
+		// Set once its contents turn out to match this one's, which then takes its references.
+		Entry* Shared{ nullptr };
+
+		GLint TopLevel() const { return (GLint)LevelBytes.size() - 1; }
+		size_t Bytes() const;
+	};
+
+	TextureLoader loader;
+	std::vector<std::unique_ptr<Entry>> entries;
+	// Entries that found a match, kept for the handles that still point at them.
+	std::vector<std::unique_ptr<Entry>> sharing;
+	std::vector<const TextureArray*> arrays;
+	// An image may be loaded once for each way it is sampled.
+	std::unordered_multimap<std::string, Entry*> byPath;
+	std::unordered_multimap<uint64_t, Entry*> byHash;
+	uint64_t frame{ 0 };
+
+	// The entry under key sampled the same way, or nullptr.
+	template <typename Map>
+	static Entry* Find(const Map& map, const typename Map::key_type& key, GLenum texType, GLenum interpolationType, GLenum texMappingType)
+	{
+		auto range{ map.equal_range(key) };
+		for (auto found{ range.first }; found != range.second; found++)
+		{
+			const Entry& entry{ *found->second };
+			if (entry.Tex.type == texType && entry.Interpolation == interpolationType && entry.Wrap == texMappingType)
+				return found->second;
+		}
+		return nullptr;
+	}
+
+	// From the loader: dedupes the entry of textureID by hash, else sizes its levels.
+	bool Decoded(GLuint textureID, uint64_t hash, uint32_t width, uint32_t height);
+	// Hands entry's references over to same and retires it.
+	void Share(Entry& entry, Entry& same);
+
+	bool Busy(const Entry& entry) const { return loader.Loading(entry.Tex.ID); }
+	// Lowers the base level to level, uploading what is missing.
+	void StreamIn(Entry& entry, GLint level);
+	// Raises the base level to level and frees the levels under it.
+	void StreamOut(Entry& entry, GLint level);
+	void Evict(Entry& entry);
+	// Frees memory until ResidentBytes() + extraBytes fits in the budget, sparing keep and,
+	// with spareUsed, every texture drawn this frame. False if that is not possible.
+	bool MakeRoom(size_t extraBytes, const Entry* keep, bool spareUsed);
+};
@@ -0,0 +1,665 @@
+#include "TextureCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	// sRGB byte to linear [0, 1].
+	struct LinearTable
+	{
+		float Values[256];
+
+		LinearTable()
+		{
+			for (int i{ 0 }; i < 256; i++)
+			{
+				float c{ i / 255.0f };
+				Values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+		}
+	};
+
+	const LinearTable linearTable;
+
+	uint8_t ToByte(float value)
+	{
+		return (uint8_t)std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f);
+	}
+
+	uint16_t To565(const float color[3])
+	{
+		auto channel = [](float value, int max) { return (uint16_t)std::clamp((int)std::lround(value * max / 255.0f), 0, max); };
+		return (uint16_t)((channel(color[0], 31) << 11) | (channel(color[1], 63) << 5) | channel(color[2], 31));
+	}
+
+	void From565(uint16_t packed, float color[3])
+	{
+		int r{ (packed >> 11) & 31 };
+		int g{ (packed >> 5) & 63 };
+		int b{ packed & 31 };
+		color[0] = (float)((r << 3) | (r >> 2));
+		color[1] = (float)((g << 2) | (g >> 4));
+		color[2] = (float)((b << 3) | (b >> 2));
+	}
+
+	// Picks the closest of the four colours c0 / c1 interpolate to for every texel and returns
+	// the summed squared error. indices use the 4 colour palette order: c0, c1, 2/3 c0, 1/3 c0.
+	float FitBC1(const float texels[16][3], uint16_t c0, uint16_t c1, uint8_t indices[16])
+	{
+		float palette[4][3];
+		From565(c0, palette[0]);
+		From565(c1, palette[1]);
+		for (int c{ 0 }; c < 3; c++)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+
+		// Equal endpoints decode in the 3 colour mode, where only index 0 is safe to use.
+		int paletteSize{ c0 == c1 ? 1 : 4 };
+
+		float error{ 0.0f };
+		for (int i{ 0 }; i < 16; i++)
+		{
+			float best{ INFINITY };
+			for (int p{ 0 }; p < paletteSize; p++)
+			{
+				float dr{ texels[i][0] - palette[p][0] };
+				float dg{ texels[i][1] - palette[p][1] };
+				float db{ texels[i][2] - palette[p][2] };
+				float distance{ dr * dr + dg * dg + db * db };
+				if (distance < best)
+				{
+					best = distance;
+					indices[i] = (uint8_t)p;
+				}
+			}
+			error += best;
+		}
+
+		return error;
+	}
+
+	// Least squares endpoints for fixed indices. Returns false if every texel uses the same weight.
+	bool RefineBC1(const float texels[16][3], const uint8_t indices[16], float end0[3], float end1[3])
+	{
+		constexpr float weights[4]{ 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+		float aa{ 0.0f }, ab{ 0.0f }, bb{ 0.0f };
+		float ax[3]{ 0.0f, 0.0f, 0.0f };
+		float bx[3]{ 0.0f, 0.0f, 0.0f };
+		for (int i{ 0 }; i < 16; i++)
+		{
+			float a{ weights[indices[i]] };
+			float b{ 1.0f - a };
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (int c{ 0 }; c < 3; c++)
+			{
+				ax[c] += a * texels[i][c];
+				bx[c] += b * texels[i][c];
+			}
+		}
+
+		float determinant{ aa * bb - ab * ab };
+		if (std::fabs(determinant) < 1e-6f)
+			return false;
+
+		for (int c{ 0 }; c < 3; c++)
+		{
+			end0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+			end1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+		}
+
+		return true;
+	}
+
+	void WriteBC1(uint16_t c0, uint16_t c1, uint8_t indices[16], uint8_t block[8])
+	{
+		// c0 > c1 selects the 4 colour mode; swapping the endpoints swaps indices 0 / 1 and 2 / 3.
+		if (c0 < c1)
+		{
+			std::swap(c0, c1);
+			for (int i{ 0 }; i < 16; i++)
+				indices[i] ^= 1;
+		}
+
+		uint32_t bits{ 0 };
+		for (int i{ 0 }; i < 16; i++)
+			bits |= (uint32_t)indices[i] << (2 * i);
+
+		block[0] = (uint8_t)(c0 & 0xFF);
+		block[1] = (uint8_t)(c0 >> 8);
+		block[2] = (uint8_t)(c1 & 0xFF);
+		block[3] = (uint8_t)(c1 >> 8);
+		std::memcpy(block + 4, &bits, sizeof(bits));
+	}
+
+	float SRGBToLinear(uint8_t value)
+	{
+		return linearTable.Values[value];
+	}
+
+	// Fills a 4x4 block starting at (x, y), repeating the last row / column past the edges.
+	void GatherBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t x, uint32_t y, uint8_t texels[64])
+	{
+		for (uint32_t row{ 0 }; row < 4; row++)
+		{
+			uint32_t sy{ std::min(y + row, height - 1) };
+			for (uint32_t column{ 0 }; column < 4; column++)
+			{
+				uint32_t sx{ std::min(x + column, width - 1) };
+				std::memcpy(texels + (row * 4 + column) * 4, rgba + ((size_t)sy * width + sx) * 4, 4);
+			}
+		}
+	}
+
+	void EncodeLevel(const uint8_t* rgba, uint32_t width, uint32_t height, TextureCompressor::Format format, std::vector<uint8_t>& level)
+	{
+		using TextureCompressor::Format;
+
+		size_t blockBytes{ TextureCompressor::BlockBytes(format) };
+		level.resize(TextureCompressor::LevelBytes(format, width, height));
+
+		uint8_t* block{ level.data() };
+		uint8_t texels[64];
+		for (uint32_t y{ 0 }; y < height; y += 4)
+		{
+			for (uint32_t x{ 0 }; x < width; x += 4)
+			{
+				GatherBlock(rgba, width, height, x, y, texels);
+				switch (format)
+				{
+				case Format::BC1: TextureCompressor::EncodeBC1(texels, block); break;
+				case Format::BC3: TextureCompressor::EncodeBC3(texels, block); break;
+				case Format::BC4: TextureCompressor::EncodeBC4(texels, block); break;
+				case Format::BC5: TextureCompressor::EncodeBC5(texels, block); break;
+				}
+				block += blockBytes;
+			}
+		}
+	}
+
+	// DDS_HEADER and DDS_HEADER_DXT10 as the DirectX documentation lays them out.
+	struct DDSPixelFormat
+	{
+		uint32_t Size;
+		uint32_t Flags;
+		char FourCC[4];
+		uint32_t RGBBitCount;
+		uint32_t Masks[4];
+	};
+
+	struct DDSHeader
+	{
+		char Magic[4];
+		uint32_t Size;
+		uint32_t Flags;
+		uint32_t Height;
+		uint32_t Width;
+		uint32_t PitchOrLinearSize;
+		uint32_t Depth;
+		uint32_t MipMapCount;
+		uint32_t Reserved1[11];
+		DDSPixelFormat PixelFormat;
+		uint32_t Caps[4];
+		uint32_t Reserved2;
+	};
+
+	struct DDSHeaderDX10
+	{
+		uint32_t DXGIFormat;
+		uint32_t ResourceDimension;
+		uint32_t MiscFlag;
+		uint32_t ArraySize;
+		uint32_t MiscFlags2;
+	};
+
+	static_assert(sizeof(DDSHeader) == 128 && sizeof(DDSHeaderDX10) == 20);
+
+	constexpr uint32_t ddsFlags{ 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000 };
+	constexpr uint32_t ddsFourCCFlag{ 0x4 };
+	constexpr uint32_t ddsCaps{ 0x8 | 0x1000 | 0x400000 };
+	constexpr uint32_t dimensionTexture2D{ 3 };
+
+	uint32_t DXGIFormat(TextureCompressor::Format format, bool srgb)
+	{
+		using TextureCompressor::Format;
+
+		switch (format)
+		{
+		case Format::BC1: return srgb ? 72 : 71;
+		case Format::BC3: return srgb ? 78 : 77;
+		case Format::BC4: return 80;
+		case Format::BC5: return 83;
+		}
+		return 0;
+	}
+
+	bool FromDXGIFormat(uint32_t dxgiFormat, TextureCompressor::Format& format, bool& srgb)
+	{
+		using TextureCompressor::Format;
+
+		switch (dxgiFormat)
+		{
+		case 71: case 72: format = Format::BC1; srgb = dxgiFormat == 72; return true;
+		case 77: case 78: format = Format::BC3; srgb = dxgiFormat == 78; return true;
+		case 80: format = Format::BC4; srgb = false; return true;
+		case 83: format = Format::BC5; srgb = false; return true;
+		default: return false;
+		}
+	}
+
+	bool FromFourCC(const char fourCC[4], TextureCompressor::Format& format)
+	{
+		using TextureCompressor::Format;
+
+		std::string code(fourCC, 4);
+		if (code == "DXT1") format = Format::BC1;
+		else if (code == "DXT5") format = Format::BC3;
+		else if (code == "ATI1" || code == "BC4U") format = Format::BC4;
+		else if (code == "ATI2" || code == "BC5U") format = Format::BC5;
+		else return false;
+		return true;
+	}
+}
+
+size_t TextureCompressor::BlockBytes(Format format)
+{
+	return format == Format::BC1 || format == Format::BC4 ? 8 : 16;
+}
+
+size_t TextureCompressor::LevelBytes(Format format, uint32_t width, uint32_t height)
+{
+	return (size_t)((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+}
+
+void TextureCompressor::EncodeBC1(const uint8_t rgba[64], uint8_t block[8])
+{
+	float texels[16][3];
+	float mean[3]{ 0.0f, 0.0f, 0.0f };
+	float low[3]{ 255.0f, 255.0f, 255.0f };
+	float high[3]{ 0.0f, 0.0f, 0.0f };
+	for (int i{ 0 }; i < 16; i++)
+	{
+		for (int c{ 0 }; c < 3; c++)
+		{
+			texels[i][c] = rgba[i * 4 + c];
+			mean[c] += texels[i][c] / 16.0f;
+			low[c] = std::min(low[c], texels[i][c]);
+			high[c] = std::max(high[c], texels[i][c]);
+		}
+	}
+
+	// Principal axis of the colours by power iteration on their covariance.
+	float covariance[6]{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int i{ 0 }; i < 16; i++)
+	{
+		float r{ texels[i][0] - mean[0] };
+		float g{ texels[i][1] - mean[1] };
+		float b{ texels[i][2] - mean[2] };
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	float axis[3]{ high[0] - low[0], high[1] - low[1], high[2] - low[2] };
+	for (int iteration{ 0 }; iteration < 8; iteration++)
+	{
+		float next[3]
+		{
+			covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+			covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+			covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+		};
+		float length{ std::max({ std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2]) }) };
+		if (length < 1e-6f)
+			break;
+		for (int c{ 0 }; c < 3; c++)
+			axis[c] = next[c] / length;
+	}
+
+	float minProjection{ INFINITY };
+	float maxProjection{ -INFINITY };
+	float axisLength{ axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] };
+	if (axisLength > 1e-12f)
+	{
+		for (int i{ 0 }; i < 16; i++)
+		{
+			float projection{ ((texels[i][0] - mean[0]) * axis[0] + (texels[i][1] - mean[1]) * axis[1] + (texels[i][2] - mean[2]) * axis[2]) / axisLength };
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+	}
+	else
+	{
+		minProjection = maxProjection = 0.0f;
+	}
+
+	float end0[3];
+	float end1[3];
+	for (int c{ 0 }; c < 3; c++)
+	{
+		end0[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+		end1[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+	}
+
+	uint16_t bestC0{ To565(end0) };
+	uint16_t bestC1{ To565(end1) };
+	uint8_t bestIndices[16];
+	float bestError{ FitBC1(texels, bestC0, bestC1, bestIndices) };
+
+	uint8_t indices[16];
+	std::memcpy(indices, bestIndices, sizeof(indices));
+	for (int iteration{ 0 }; iteration < 2 && bestError > 0.0f; iteration++)
+	{
+		if (!RefineBC1(texels, indices, end0, end1))
+			break;
+
+		uint16_t c0{ To565(end0) };
+		uint16_t c1{ To565(end1) };
+		float error{ FitBC1(texels, c0, c1, indices) };
+		if (error >= bestError)
+			break;
+
+		bestError = error;
+		bestC0 = c0;
+		bestC1 = c1;
+		std::memcpy(bestIndices, indices, sizeof(indices));
+	}
+
+	WriteBC1(bestC0, bestC1, bestIndices, block);
+}
+
+void TextureCompressor::EncodeBC3(const uint8_t rgba[64], uint8_t block[16])
+{
+	EncodeBC4(rgba, block, 3);
+	EncodeBC1(rgba, block + 8);
+}
+
+void TextureCompressor::EncodeBC4(const uint8_t rgba[64], uint8_t block[8], int channel)
+{
+	uint8_t low{ 255 };
+	uint8_t high{ 0 };
+	for (int i{ 0 }; i < 16; i++)
+	{
+		low = std::min(low, rgba[i * 4 + channel]);
+		high = std::max(high, rgba[i * 4 + channel]);
+	}
+
+	// high > low selects the 8 value mode: high, low and six steps between them.
+	int palette[8]{ high, low };
+	for (int p{ 2 }; p < 8; p++)
+		palette[p] = ((8 - p) * high + (p - 1) * low + 3) / 7;
+
+	uint64_t bits{ 0 };
+	if (high != low)
+	{
+		for (int i{ 0 }; i < 16; i++)
+		{
+			int value{ rgba[i * 4 + channel] };
+			int best{ 0 };
+			for (int p{ 1 }; p < 8; p++)
+			{
+				if (std::abs(palette[p] - value) < std::abs(palette[best] - value))
+					best = p;
+			}
+			bits |= (uint64_t)best << (3 * i);
+		}
+	}
+
+	block[0] = high;
+	block[1] = low;
+	for (int b{ 0 }; b < 6; b++)
+		block[2 + b] = (uint8_t)(bits >> (8 * b));
+}
+
+void TextureCompressor::EncodeBC5(const uint8_t rgba[64], uint8_t block[16])
+{
+	EncodeBC4(rgba, block, 0);
+	EncodeBC4(rgba, block + 8, 1);
+}
+
+void TextureCompressor::DecodeBC1(const uint8_t block[8], uint8_t rgba[64])
+{
+	uint16_t c0{ (uint16_t)(block[0] | (block[1] << 8)) };
+	uint16_t c1{ (uint16_t)(block[2] | (block[3] << 8)) };
+	uint32_t bits;
+	std::memcpy(&bits, block + 4, sizeof(bits));
+
+	float palette[4][4];
+	From565(c0, palette[0]);
+	From565(c1, palette[1]);
+	palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255.0f;
+	for (int c{ 0 }; c < 3; c++)
+	{
+		if (c0 > c1)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+			palette[3][c] = 0.0f;
+		}
+	}
+	if (c0 <= c1)
+		palette[3][3] = 0.0f;
+
+	for (int i{ 0 }; i < 16; i++)
+	{
+		const float* color{ palette[(bits >> (2 * i)) & 3] };
+		for (int c{ 0 }; c < 4; c++)
+			rgba[i * 4 + c] = (uint8_t)(color[c] + 0.5f);
+	}
+}
+
+void TextureCompressor::DecodeBC4(const uint8_t block[8], uint8_t rgba[64], int channel)
+{
+	int high{ block[0] };
+	int low{ block[1] };
+	int palette[8]{ high, low };
+	if (high > low)
+	{
+		for (int p{ 2 }; p < 8; p++)
+			palette[p] = ((8 - p) * high + (p - 1) * low + 3) / 7;
+	}
+	else
+	{
+		for (int p{ 2 }; p < 6; p++)
+			palette[p] = ((6 - p) * high + (p - 1) * low + 2) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t bits{ 0 };
+	for (int b{ 0 }; b < 6; b++)
+		bits |= (uint64_t)block[2 + b] << (8 * b);
+
+	for (int i{ 0 }; i < 16; i++)
+		rgba[i * 4 + channel] = (uint8_t)palette[(bits >> (3 * i)) & 7];
+}
+
+size_t TextureCompressor::Image::Bytes() const
+{
+	size_t bytes{ 0 };
+	for (const std::vector<uint8_t>& level : Levels)
+		bytes += level.size();
+	return bytes;
+}
+
+TextureCompressor::Image TextureCompressor::Compress(const uint8_t* rgba, uint32_t width, uint32_t height, Format format, bool srgb, MipGenerator::Filter filter)
+{
+	Image image;
+	image.BlockFormat = format;
+	image.Width = width;
+	image.Height = height;
+
+	// BC4 / BC5 hold data rather than colour, and GL samples them without any sRGB decode.
+	bool linearOutput{ format == Format::BC4 || format == Format::BC5 };
+	image.SRGB = srgb && !linearOutput;
+
+	const uint8_t* source{ rgba };
+	std::vector<uint8_t> linear;
+	if (srgb && linearOutput)
+	{
+		linear.assign(rgba, rgba + (size_t)width * height * 4);
+		for (size_t i{ 0 }; i < linear.size(); i++)
+		{
+			if ((i & 3) != 3)
+				linear[i] = ToByte(SRGBToLinear(linear[i]));
+		}
+		source = linear.data();
+	}
+
+	std::vector<MipGenerator::Level> mips{ MipGenerator::Generate(source, width, height, image.SRGB, filter) };
+
+	image.Levels.resize(mips.size() + 1);
+	EncodeLevel(source, width, height, format, image.Levels[0]);
+	for (size_t level{ 0 }; level < mips.size(); level++)
+		EncodeLevel(mips[level].Pixels.data(), mips[level].Width, mips[level].Height, format, image.Levels[level + 1]);
+
+	return image;
+}
+
+float TextureCompressor::PSNR(const uint8_t* rgba, const Image& image, bool srgb)
+{
+	bool linearOutput{ image.BlockFormat == Format::BC4 || image.BlockFormat == Format::BC5 };
+	int channels{ image.BlockFormat == Format::BC1 ? 3 : image.BlockFormat == Format::BC3 ? 4 : image.BlockFormat == Format::BC4 ? 1 : 2 };
+
+	size_t blockBytes{ BlockBytes(image.BlockFormat) };
+	const uint8_t* block{ image.Levels[0].data() };
+
+	double squaredError{ 0.0 };
+	uint8_t decoded[64];
+	for (uint32_t y{ 0 }; y < image.Height; y += 4)
+	{
+		for (uint32_t x{ 0 }; x < image.Width; x += 4)
+		{
+			switch (image.BlockFormat)
+			{
+			case Format::BC1: DecodeBC1(block, decoded); break;
+			case Format::BC3: DecodeBC1(block + 8, decoded); DecodeBC4(block, decoded, 3); break;
+			case Format::BC4: DecodeBC4(block, decoded); break;
+			case Format::BC5: DecodeBC4(block, decoded, 0); DecodeBC4(block + 8, decoded, 1); break;
+			}
+			block += blockBytes;
+
+			for (uint32_t row{ 0 }; row < 4 && y + row < image.Height; row++)
+			{
+				for (uint32_t column{ 0 }; column < 4 && x + column < image.Width; column++)
+				{
+					const uint8_t* source{ rgba + ((size_t)(y + row) * image.Width + x + column) * 4 };
+					for (int c{ 0 }; c < channels; c++)
+					{
+						float expected{ srgb && linearOutput ? SRGBToLinear(source[c]) * 255.0f : (float)source[c] };
+						double difference{ expected - decoded[(row * 4 + column) * 4 + c] };
+						squaredError += difference * difference;
+					}
+				}
+			}
+		}
+	}
+
+	double meanSquaredError{ squaredError / ((double)image.Width * image.Height * channels) };
+	return meanSquaredError > 0.0 ? (float)(10.0 * std::log10(255.0 * 255.0 / meanSquaredError)) : INFINITY;
+}
+
+bool TextureCompressor::WriteDDS(const std::string& path, const Image& image)
+{
+	DDSHeader header{};
+	std::memcpy(header.Magic, "DDS ", 4);
+	header.Size = sizeof(DDSHeader) - sizeof(header.Magic);
+	header.Flags = ddsFlags;
+	header.Height = image.Height;
+	header.Width = image.Width;
+	header.PitchOrLinearSize = (uint32_t)LevelBytes(image.BlockFormat, image.Width, image.Height);
+	header.MipMapCount = (uint32_t)image.Levels.size();
+	header.PixelFormat.Size = sizeof(DDSPixelFormat);
+	header.PixelFormat.Flags = ddsFourCCFlag;
+	std::memcpy(header.PixelFormat.FourCC, "DX10", 4);
+	header.Caps[0] = ddsCaps;
+
+	DDSHeaderDX10 dx10{};
+	dx10.DXGIFormat = DXGIFormat(image.BlockFormat, image.SRGB);
+	dx10.ResourceDimension = dimensionTexture2D;
+	dx10.ArraySize = 1;
+
+	std::error_code error;
+	std::filesystem::path parent{ std::filesystem::path(path).parent_path() };
+	if (!parent.empty())
+		std::filesystem::create_directories(parent, error);
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+		return false;
+
+	out.write((const char*)&header, sizeof(header));
+	out.write((const char*)&dx10, sizeof(dx10));
+	for (const std::vector<uint8_t>& level : image.Levels)
+		out.write((const char*)level.data(), (std::streamsize)level.size());
+
+	return (bool)out;
+}
+
+bool TextureCompressor::ReadDDS(const std::string& path, Image& image)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return false;
+
+	DDSHeader header;
+	if (!in.read((char*)&header, sizeof(header)) || std::memcmp(header.Magic, "DDS ", 4) != 0 || header.Size != sizeof(DDSHeader) - sizeof(header.Magic))
+		return false;
+	if (!(header.PixelFormat.Flags & ddsFourCCFlag) || header.Width == 0 || header.Height == 0)
+		return false;
+
+	image.Width = header.Width;
+	image.Height = header.Height;
+
+	if (std::memcmp(header.PixelFormat.FourCC, "DX10", 4) == 0)
+	{
+		DDSHeaderDX10 dx10;
+		if (!in.read((char*)&dx10, sizeof(dx10)) || dx10.ResourceDimension != dimensionTexture2D || dx10.ArraySize > 1)
+			return false;
+		if (!FromDXGIFormat(dx10.DXGIFormat, image.BlockFormat, image.SRGB))
+			return false;
+	}
+	else
+	{
+		if (!FromFourCC(header.PixelFormat.FourCC, image.BlockFormat))
+			return false;
+		image.SRGB = false;
+	}
+
+	uint32_t levelCount{ (header.Flags & 0x20000) && header.MipMapCount ? header.MipMapCount : 1 };
+	image.Levels.assign(levelCount, {});
+
+	uint32_t width{ image.Width };
+	uint32_t height{ image.Height };
+	for (std::vector<uint8_t>& level : image.Levels)
+	{
+		level.resize(LevelBytes(image.BlockFormat, width, height));
+		if (!in.read((char*)level.data(), (std::streamsize)level.size()))
+			return false;
+
+		width = std::max(width / 2, 1u);
+		height = std::max(height / 2, 1u);
+	}
+
+	return true;
+}
+
+std::string TextureCompressor::CompressedPath(const std::string& imagePath)
+{
+	return std::filesystem::path(imagePath).replace_extension(".dds").string();
+}
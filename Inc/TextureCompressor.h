@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MipGenerator.h"
+
+// Block compression of 8-bit images into the BCn formats GL can sample directly, and the
+// .dds container they are stored in.
+//
+// Every format works on 4x4 texel blocks: BC1 packs RGB into 8 bytes, BC4 one channel into
+// 8 bytes, BC3 is a BC4 style alpha block followed by a BC1 colour block and BC5 is two BC4
+// blocks for red and green. Nothing here touches GL, so offline tools can link it with
+// MipGenerator alone.
+namespace TextureCompressor
+{
+	enum class Format : uint32_t
+	{
+		BC1,
+		BC3,
+		BC4,
+		BC5
+	};
+
+	size_t BlockBytes(Format format);
+	// Bytes of one mip level, rounding the size up to whole blocks.
+	size_t LevelBytes(Format format, uint32_t width, uint32_t height);
+
+	// Each block reads 16 RGBA texels in row order and writes BlockBytes(format) bytes.
+	void EncodeBC1(const uint8_t rgba[64], uint8_t block[8]);
+	void EncodeBC3(const uint8_t rgba[64], uint8_t block[16]);
+	// Encodes channel (0 = red ... 3 = alpha) of the texels.
+	void EncodeBC4(const uint8_t rgba[64], uint8_t block[8], int channel = 0);
+	void EncodeBC5(const uint8_t rgba[64], uint8_t block[16]);
+
+	void DecodeBC1(const uint8_t block[8], uint8_t rgba[64]);
+	// Writes channel of each texel, leaving the others alone.
+	void DecodeBC4(const uint8_t block[8], uint8_t rgba[64], int channel = 0);
+
+	// A compressed image with its whole mip chain. Rows run bottom to top, the order GL
+	// expects and stb_image gives with vertical flipping on.
+	struct Image
+	{
+		Format BlockFormat{ Format::BC1 };
+		bool SRGB{ false };
+		uint32_t Width{ 0 };
+		uint32_t Height{ 0 };
+		std::vector<std::vector<uint8_t>> Levels;
+
+		size_t Bytes() const;
+	};
+
+	// Compresses an RGBA image and its MipGenerator chain down to 1x1. BC4 / BC5 store
+	// linear values, converted from sRGB first if srgb is set, since GL has no sRGB
+	// variants of them.
+	Image Compress(const uint8_t* rgba, uint32_t width, uint32_t height, Format format, bool srgb,
+		MipGenerator::Filter filter = MipGenerator::Filter::Kaiser);
+
+	// Peak signal to noise ratio in dB of level 0 against the source image, over the
+	// channels the format stores. srgb must match the Compress call.
+	float PSNR(const uint8_t* rgba, const Image& image, bool srgb);
+
+	bool WriteDDS(const std::string& path, const Image& image);
+	bool ReadDDS(const std::string& path, Image& image);
+
+	// Where the compressed copy of an image lives: the same path with a .dds extension.
+	std::string CompressedPath(const std::string& imagePath);
+}
@@ -0,0 +1,355 @@
+#include "TextureLoader.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+TextureLoader::TextureLoader(ThreadPool& pool, size_t uploadBudget, size_t ringSize)
+	: UploadBudget(uploadBudget), pool(pool), ring(std::max<size_t>(ringSize, 1))
+{
+	stbi_set_flip_vertically_on_load(true);
+
+	for (Slot& slot : ring)
+	{
+		slot.Size = (GLsizeiptr)uploadBudget;
+		glGenBuffers(1, &slot.Buffer);
+		GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, slot.Size, NULL, GL_STREAM_DRAW);
+	}
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureLoader::Load(const Texture& texture, const char* image)
+{
+	Job* job{ Queue(texture, image) };
+
+	// Only 4 bytes, from a texture just created from client memory.
+	GLStateCache::Get().BindTexture(texture.type, texture.ID);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glGetTexImage(texture.type, 0, GL_RGBA, GL_UNSIGNED_BYTE, job->Placeholder);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	GLStateCache::Get().BindTexture(texture.type, 0);
+}
+
+void TextureLoader::LoadLevels(const Texture& texture, const char* image, GLint firstLevel, GLint endLevel)
+{
+	Job* job{ Queue(texture, image) };
+	job->HasPlaceholder = false;
+	job->FirstLevel = firstLevel;
+	job->EndLevel = endLevel;
+	job->NextLevel = (size_t)firstLevel;
+}
+
+void TextureLoader::LoadArray(GLuint textureID, GLenum type, const std::vector<std::string>& images, GLsizei width, GLsizei height, const GLubyte placeholder[4])
+{
+	if (images.empty())
+		return;
+
+	jobs.push_back(std::make_unique<Job>());
+	Job* job{ jobs.back().get() };
+	job->TextureID = textureID;
+	job->Type = type;
+	job->Path = images[0];
+	job->Filter = Texture::MipFilter;
+	std::memcpy(job->Placeholder, placeholder, sizeof(job->Placeholder));
+	job->Width = width;
+	job->Height = height;
+	job->LayerPaths = images;
+	job->LayerPixels.resize(images.size());
+	job->LayerMips.resize(images.size());
+	job->LayerFailed.resize(images.size(), 0);
+	job->LayersLeft = images.size();
+
+	for (size_t layer{ 0 }; layer < images.size(); layer++)
+	{
+		pool.Submit([this, job, layer]
+		{
+			int imageWidth, imageHeight, channels;
+			unsigned char* pixels{ stbi_load(job->LayerPaths[layer].c_str(), &imageWidth, &imageHeight, &channels, 4) };
+			std::vector<uint8_t>& resized{ job->LayerPixels[layer] };
+			if (pixels)
+			{
+				resized = MipGenerator::Resize(pixels, (uint32_t)imageWidth, (uint32_t)imageHeight, (uint32_t)job->Width, (uint32_t)job->Height, true);
+				stbi_image_free(pixels);
+			}
+			else
+			{
+				job->LayerFailed[layer] = 1;
+				resized.resize(size_t(job->Width) * job->Height * 4);
+				for (size_t texel{ 0 }; texel < resized.size(); texel += 4)
+					std::memcpy(&resized[texel], job->Placeholder, 4);
+			}
+			job->LayerMips[layer] = MipGenerator::Generate(resized.data(), (uint32_t)job->Width, (uint32_t)job->Height, true, job->Filter);
+
+			// The last layer done hands the whole array over.
+			if (--job->LayersLeft == 0)
+			{
+				std::lock_guard<std::mutex> lock(readyMutex);
+				ready.push_back(job);
+			}
+		});
+	}
+}
+
+TextureLoader::Job* TextureLoader::Queue(const Texture& texture, const char* image)
+{
+	jobs.push_back(std::make_unique<Job>());
+	Job* job{ jobs.back().get() };
+	job->TextureID = texture.ID;
+	job->Type = texture.type;
+	job->Path = image;
+	job->Filter = Texture::MipFilter;
+
+	pool.Submit([this, job]
+	{
+		// Read whole, so hashing it costs no second read.
+		std::ifstream in(job->Path, std::ios::binary);
+		std::vector<char> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		if (!file.empty())
+		{
+			int channels;
+			job->Hash = Hash(file.data(), file.size());
+			job->Pixels = stbi_load_from_memory((const stbi_uc*)file.data(), (int)file.size(), &job->Width, &job->Height, &channels, 4);
+		}
+		if (job->Pixels)
+			job->Mips = MipGenerator::Generate(job->Pixels, (uint32_t)job->Width, (uint32_t)job->Height, true, job->Filter);
+
+		std::lock_guard<std::mutex> lock(readyMutex);
+		ready.push_back(job);
+	});
+
+	return job;
+}
+
+uint64_t TextureLoader::Hash(const void* data, size_t size)
+{
+	uint64_t hash{ 0xCBF29CE484222325ull };
+	for (size_t i{ 0 }; i < size; i++)
+		hash = (hash ^ ((const unsigned char*)data)[i]) * 0x100000001B3ull;
+	return hash;
+}
+
+bool TextureLoader::Loading(GLuint textureID) const
+{
+	return std::any_of(jobs.begin(), jobs.end(), [textureID](const std::unique_ptr<Job>& job) { return job->TextureID == textureID; });
+}
+
+void TextureLoader::Update()
+{
+	size_t budget{ UploadBudget };
+	while (budget > 0)
+	{
+		if (!uploading)
+		{
+			{
+				std::lock_guard<std::mutex> lock(readyMutex);
+				if (ready.empty())
+					break;
+
+				uploading = ready.front();
+				ready.pop_front();
+			}
+
+			if (Decoded && uploading->HasPlaceholder && uploading->Pixels && uploading->LayerPaths.empty() &&
+				!Decoded(uploading->TextureID, uploading->Hash, (uint32_t)uploading->Width, (uint32_t)uploading->Height))
+			{
+				Complete(uploading);
+				continue;
+			}
+		}
+
+		size_t used{ UploadRows(budget) };
+		if (used == 0)
+			break;
+
+		budget -= std::min(used, budget);
+	}
+}
+
+size_t TextureLoader::UploadRows(size_t budget)
+{
+	Job* job{ uploading };
+	bool array{ !job->LayerPaths.empty() };
+
+	if (!array && !job->Pixels)
+	{
+		std::cerr << "Failed to load texture " << job->Path << "\n";
+		Complete(job);
+		return 1;
+	}
+
+	GLint topLevel{ (GLint)(array ? job->LayerMips[0].size() : job->Mips.size()) };
+	GLint endLevel{ job->EndLevel < 0 ? topLevel + 1 : std::min(job->EndLevel, topLevel + 1) };
+	if (job->FirstLevel >= endLevel)
+	{
+		Complete(job);
+		return 1;
+	}
+
+	Slot& slot{ ring[nextSlot] };
+	if (slot.Fence)
+	{
+		// The GPU may still be reading the slot from an earlier frame; try again next frame.
+		if (glClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+			return 0;
+
+		glDeleteSync(slot.Fence);
+		slot.Fence = 0;
+	}
+
+	const unsigned char* pixels{ array ? job->LayerPixels[job->NextLayer].data() : job->Pixels };
+	int width{ job->Width };
+	int height{ job->Height };
+	if (job->NextLevel > 0)
+	{
+		const MipGenerator::Level& level{ array ? job->LayerMips[job->NextLayer][job->NextLevel - 1] : job->Mips[job->NextLevel - 1] };
+		pixels = level.Pixels.data();
+		width = (int)level.Width;
+		height = (int)level.Height;
+	}
+
+	// A row wider than the whole budget still goes up, alone, at the start of a frame.
+	size_t rowBytes{ size_t(width) * 4 };
+	size_t rows{ std::min(size_t(height - job->NextRow), budget / rowBytes) };
+	if (rows == 0 && budget < UploadBudget)
+		return 0;
+	rows = std::max<size_t>(rows, 1);
+	size_t bytes{ rows * rowBytes };
+
+	GLStateCache::Get().ActiveTexture(0);
+	GLStateCache::Get().BindTexture(job->Type, job->TextureID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// Reallocate the levels at full size with the first rows. A placeholder moves to the 1x1
+	// level and stays the only one sampled until the last level is in.
+	if (!job->Started)
+	{
+		job->Started = true;
+		const std::vector<MipGenerator::Level>& mips{ array ? job->LayerMips[0] : job->Mips };
+		GLsizei layers{ (GLsizei)job->LayerPaths.size() };
+		std::vector<GLubyte> placeholders;
+		for (GLsizei layer{ 0 }; layer < std::max(layers, 1); layer++)
+			placeholders.insert(placeholders.end(), job->Placeholder, job->Placeholder + 4);
+
+		for (GLint level{ job->FirstLevel }; level < endLevel; level++)
+		{
+			GLsizei levelWidth{ level == 0 ? job->Width : (GLsizei)mips[level - 1].Width };
+			GLsizei levelHeight{ level == 0 ? job->Height : (GLsizei)mips[level - 1].Height };
+			const GLubyte* initial{ job->HasPlaceholder && level == topLevel ? placeholders.data() : NULL };
+			if (array)
+				glTexImage3D(job->Type, level, GL_SRGB_ALPHA, levelWidth, levelHeight, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, initial);
+			else if (initial)
+				glTexImage2D(job->Type, level, GL_SRGB_ALPHA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, initial);
+			else
+				glTexImage2D(job->Type, level, GL_SRGB_ALPHA, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+
+		for (size_t layer{ 0 }; layer < job->LayerFailed.size(); layer++)
+		{
+			if (job->LayerFailed[layer])
+				std::cerr << "Failed to load texture " << job->LayerPaths[layer] << "\n";
+		}
+
+		if (job->HasPlaceholder)
+		{
+			glTexParameteri(job->Type, GL_TEXTURE_BASE_LEVEL, topLevel);
+			glTexParameteri(job->Type, GL_TEXTURE_MAX_LEVEL, topLevel);
+		}
+	}
+
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+	if ((GLsizeiptr)bytes > slot.Size)
+	{
+		slot.Size = (GLsizeiptr)bytes;
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, slot.Size, NULL, GL_STREAM_DRAW);
+	}
+
+	void* mapped{ glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT) };
+	std::memcpy(mapped, pixels + size_t(job->NextRow) * rowBytes, bytes);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	if (array)
+		glTexSubImage3D(job->Type, (GLint)job->NextLevel, 0, job->NextRow, (GLint)job->NextLayer, width, (GLsizei)rows, 1, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+	else
+		glTexSubImage2D(job->Type, (GLint)job->NextLevel, 0, job->NextRow, width, (GLsizei)rows, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+	slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	nextSlot = (nextSlot + 1) % ring.size();
+
+	GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	job->NextRow += (int)rows;
+	BytesUploaded += bytes;
+
+	if (job->NextRow == height)
+	{
+		// Every layer of a level before the next level.
+		job->NextRow = 0;
+		if (!array || ++job->NextLayer == job->LayerPaths.size())
+		{
+			job->NextLayer = 0;
+			job->NextLevel++;
+		}
+	}
+
+	bool done{ (GLint)job->NextLevel >= endLevel };
+	if (done)
+	{
+		glTexParameteri(job->Type, GL_TEXTURE_BASE_LEVEL, job->FirstLevel);
+		glTexParameteri(job->Type, GL_TEXTURE_MAX_LEVEL, topLevel);
+		if (job->HasPlaceholder)
+			Loaded++;
+	}
+
+	GLStateCache::Get().BindTexture(job->Type, 0);
+	// Last, as it frees the job.
+	if (done)
+		Complete(job);
+	return bytes;
+}
+
+void TextureLoader::Complete(Job* job)
+{
+	stbi_image_free(job->Pixels);
+	uploading = nullptr;
+
+	jobs.erase(std::find_if(jobs.begin(), jobs.end(), [job](const std::unique_ptr<Job>& queued) { return queued.get() == job; }));
+}
+
+void TextureLoader::Finish()
+{
+	pool.Wait();
+
+	size_t budget{ UploadBudget };
+	UploadBudget = SIZE_MAX;
+	while (!jobs.empty())
+	{
+		Update();
+	}
+	UploadBudget = budget;
+}
+
+void TextureLoader::Delete()
+{
+	// Workers may still be writing into jobs.
+	pool.Wait();
+
+	for (std::unique_ptr<Job>& job : jobs)
+	{
+		stbi_image_free(job->Pixels);
+	}
+	jobs.clear();
+	ready.clear();
+	uploading = nullptr;
+
+	for (Slot& slot : ring)
+	{
+		if (slot.Fence)
+			glDeleteSync(slot.Fence);
+		GLStateCache::Get().DeleteBuffer(slot.Buffer);
+	}
+	ring.clear();
+}
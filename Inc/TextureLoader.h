@@ -0,0 +1,112 @@
+#pragma once
+
+#include "glad/glad.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Texture.h"
+#include "ThreadPool.h"
+
+// Decodes images on a thread pool and streams them into existing textures.
+//
+// Load queues the decode and the mip chain (with Texture::MipFilter); Update, called once
+// per frame on the GL thread, copies rows of each level into a ring of pixel unpack buffers
+// and issues glTexSubImage2D from them, so no frame uploads more than UploadBudget bytes.
+// A texture keeps whatever it held before (normally a 1x1 placeholder) until the last rows
+// of its last level arrive. LoadLevels refills levels a texture had dropped, sampling the
+// levels it still has until they are in. LoadArray fills every layer of a texture array the
+// same way, decoding and resizing the layers on the pool in parallel.
+class TextureLoader
+{
+public:
+	TextureLoader(ThreadPool& pool, size_t uploadBudget = 512 * 1024, size_t ringSize = 3);
+
+	void Load(const Texture& texture, const char* image);
+	// Uploads levels [firstLevel, endLevel) of the image, then lowers the base level to firstLevel.
+	void LoadLevels(const Texture& texture, const char* image, GLint firstLevel, GLint endLevel);
+	// A layer of width x height for each image, sampling placeholder until all are in. An
+	// image that cannot be read leaves its layer the placeholder colour.
+	void LoadArray(GLuint textureID, GLenum type, const std::vector<std::string>& images, GLsizei width, GLsizei height, const GLubyte placeholder[4]);
+	void Update();
+	// Uploads everything still queued, waiting for decodes, with no per-frame limit.
+	void Finish();
+
+	// Called on the GL thread with each image Load decoded, before any of it goes up: hash is
+	// of the file's bytes. Returning false drops the upload and leaves the texture as it is.
+	std::function<bool(GLuint textureID, uint64_t hash, uint32_t width, uint32_t height)> Decoded;
+
+	// FNV-1a.
+	static uint64_t Hash(const void* data, size_t size);
+
+	size_t Pending() const { return jobs.size(); }
+	bool Loading(GLuint textureID) const;
+	size_t Loaded{ 0 };
+	size_t BytesUploaded{ 0 };
+	size_t UploadBudget;
+
+	void Delete();
+
+private:
+	struct Job
+	{
+		GLuint TextureID;
+		GLenum Type;
+		std::string Path;
+		GLubyte Placeholder[4]{ 0, 0, 0, 255 };
+		// Without a placeholder only [FirstLevel, EndLevel) is reallocated and uploaded.
+		bool HasPlaceholder{ true };
+		GLint FirstLevel{ 0 };
+		GLint EndLevel{ -1 };
+
+		MipGenerator::Filter Filter{ MipGenerator::Filter::Box };
+
+		// RGBA level 0 from stb_image, then the levels MipGenerator built from it.
+		uint64_t Hash{ 0 };
+		unsigned char* Pixels{ nullptr };
+		int Width{ 0 };
+		int Height{ 0 };
+		std::vector<MipGenerator::Level> Mips;
+
+		// Of a texture array instead: every layer resized to Width x Height, then its levels.
+		std::vector<std::string> LayerPaths;
+		std::vector<std::vector<uint8_t>> LayerPixels;
+		std::vector<std::vector<MipGenerator::Level>> LayerMips;
+		// A byte per layer, as each layer's worker writes its own.
+		std::vector<uint8_t> LayerFailed;
+		std::atomic<size_t> LayersLeft{ 0 };
+		size_t NextLayer{ 0 };
+
+		size_t NextLevel{ 0 };
+		int NextRow{ 0 };
+		bool Started{ false };
+	};
+
+	struct Slot
+	{
+		GLuint Buffer{ 0 };
+		GLsizeiptr Size{ 0 };
+		GLsync Fence{ 0 };
+	};
+
+	ThreadPool& pool;
+	std::vector<Slot> ring;
+	size_t nextSlot{ 0 };
+
+	std::vector<std::unique_ptr<Job>> jobs;
+	// Decoded by a worker, in the order they finished. Guarded by readyMutex.
+	std::deque<Job*> ready;
+	std::mutex readyMutex;
+	Job* uploading{ nullptr };
+
+	Job* Queue(const Texture& texture, const char* image);
+	// Uploads rows of the current job within budget bytes; returns the bytes used.
+	size_t UploadRows(size_t budget);
+	void Complete(Job* job);
+};
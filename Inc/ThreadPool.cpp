@@ -0,0 +1,70 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+	threadCount = std::max<size_t>(threadCount, 1);
+
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		workers.emplace_back(&ThreadPool::Work, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	jobReady.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(std::move(job));
+	}
+	jobReady.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	jobsDone.wait(lock, [this] { return jobs.empty() && running == 0; });
+}
+
+void ThreadPool::Work()
+{
+	for (;;)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (jobs.empty())
+				return;
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+			running++;
+		}
+
+		job();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running--;
+		}
+		jobsDone.notify_all();
+	}
+}
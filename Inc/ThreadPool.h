@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running queued jobs in submission order. Jobs must not
+// touch GL; hand results back to the main thread instead.
+class ThreadPool
+{
+public:
+	// 0 picks one thread per core, leaving one for the main thread.
+	ThreadPool(size_t threadCount = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Submit(std::function<void()> job);
+	// Blocks until every submitted job has finished.
+	void Wait();
+
+	size_t Size() const { return workers.size(); }
+
+private:
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex mutex;
+	std::condition_variable jobReady;
+	std::condition_variable jobsDone;
+	size_t running{ 0 };
+	bool stopping{ false };
+
+	void Work();
+};
@@ -0,0 +1,69 @@
+#include "UBO.h"
+#include "GLStateCache.h"
+
+#include <cstring>
+#include <stdexcept>
+
+std::unordered_map<std::string, GLuint> UBO::bindings;
+
+UBO::UBO(GLsizeiptr size)
+{
+	data.resize((size_t)size);
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+	glGenBuffers(1, &ID);
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, ID);
+	glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+}
+
+GLintptr UBO::Allocate(GLsizeiptr size)
+{
+	GLintptr offset{ (used + alignment - 1) / alignment * alignment };
+	if (offset + size > (GLsizeiptr)data.size()) throw std::runtime_error("UBO: out of space");
+
+	used = offset + size;
+	return offset;
+}
+
+void UBO::Write(GLintptr offset, const void* source, GLsizeiptr size)
+{
+	std::memcpy(data.data() + offset, source, (size_t)size);
+}
+
+void UBO::Upload()
+{
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, ID);
+	// Orphan the old storage so a draw still reading last frame's data doesn't stall us.
+	glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)data.size(), NULL, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, used, data.data());
+}
+
+void UBO::BindRange(const char* block, GLintptr offset, GLsizeiptr size)
+{
+	GLStateCache::Get().BindBufferRange(GL_UNIFORM_BUFFER, BindingPoint(block), ID, offset, size);
+}
+
+void UBO::Bind()
+{
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, ID);
+}
+
+void UBO::Unbind()
+{
+	GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UBO::Delete()
+{
+	GLStateCache::Get().DeleteBuffer(ID);
+}
+
+GLuint UBO::BindingPoint(const std::string& block)
+{
+	std::unordered_map<std::string, GLuint>::iterator it{ bindings.find(block) };
+	if (it != bindings.end()) return it->second;
+
+	GLuint point{ (GLuint)bindings.size() };
+	bindings.emplace(block, point);
+	return point;
+}
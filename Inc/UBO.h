@@ -0,0 +1,66 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-frame data shared by every lit program. Matches the std140 FrameData block in Shaders/.
+struct FrameData
+{
+	glm::mat4 CamMatrix;
+	glm::vec4 LightColor;
+	glm::vec3 LightPos;
+	float pad0;
+	glm::vec3 CamPos;
+	float pad1;
+};
+static_assert(sizeof(FrameData) == 112, "FrameData must match the std140 block");
+
+// Per-draw data, bound as a range of the frame's buffer. A std140 mat3 is three vec4
+// columns, which is the first 48 bytes of a mat4 built from it.
+struct ObjectData
+{
+	glm::mat4 Model;
+	// The albedo and specular layers in a TextureArray.
+	glm::vec2 Layers;
+	glm::vec2 pad0;
+	glm::mat4 NormalMatrix;
+};
+static_assert(sizeof(ObjectData) == 144, "ObjectData must match the std140 block");
+
+// Uniform buffer filled on the CPU and uploaded with one call per frame.
+//
+// Blocks are bound by name: every block name gets a fixed binding point from a registry,
+// and Shader points its blocks at them after linking, since GLSL 330 has no binding layout.
+class UBO
+{
+public:
+	GLuint ID;
+	UBO() : ID(0) {}
+	UBO(GLsizeiptr size);
+
+	// Reserves size bytes at an offset that can be bound with BindRange and returns it.
+	GLintptr Allocate(GLsizeiptr size);
+	// Copies into the CPU side of the buffer; nothing reaches GL until Upload.
+	void Write(GLintptr offset, const void* data, GLsizeiptr size);
+	void Upload();
+	// Frees every allocation, so the buffer can be laid out again.
+	void Clear() { used = 0; }
+	GLsizeiptr UsedBytes() const { return used; }
+
+	void BindRange(const char* block, GLintptr offset, GLsizeiptr size);
+	void Bind();
+	void Unbind();
+	void Delete();
+
+	static GLuint BindingPoint(const std::string& block);
+
+private:
+	std::vector<unsigned char> data;
+	GLsizeiptr used{ 0 };
+	GLint alignment{ 256 };
+
+	static std::unordered_map<std::string, GLuint> bindings;
+};
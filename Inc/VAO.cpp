@@ -1,31 +1,32 @@
-#include "VAO.h"
-
-VAO::VAO()
-{
-	glGenVertexArrays(1, &ID);
-}
-
-void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset)
-{
-	VBO.Bind();
-
-	glVertexAttribPointer(layout, numComponents, type, GL_FALSE, stride, offset);
-	glEnableVertexAttribArray(layout);
-
-	VBO.Unbind();
-}
-
-void VAO::Bind()
-{
-	glBindVertexArray(ID);
-}
-
-void VAO::Unbind()
-{
-	glBindVertexArray(0);
-}
-
-void VAO::Delete()
-{
-	glDeleteVertexArrays(1, &ID);
+#include "VAO.h"
+#include "GLStateCache.h"
+
+VAO::VAO()
+{
+	glGenVertexArrays(1, &ID);
+}
+
+void VAO::LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset, GLboolean normalized, GLuint divisor)
+{
+	// Left bound for the next attribute, which most likely reads the same buffer.
+	VBO.Bind();
+
+	glVertexAttribPointer(layout, numComponents, type, normalized, (GLsizei)stride, offset);
+	glEnableVertexAttribArray(layout);
+	glVertexAttribDivisor(layout, divisor);
+}
+
+void VAO::Bind()
+{
+	GLStateCache::Get().BindVertexArray(ID);
+}
+
+void VAO::Unbind()
+{
+	GLStateCache::Get().BindVertexArray(0);
+}
+
+void VAO::Delete()
+{
+	GLStateCache::Get().DeleteVertexArray(ID);
 }
\ No newline at end of file
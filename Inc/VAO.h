@@ -1,16 +1,17 @@
-#pragma once
-
-#include <glad/glad.h>
-#include "VBO.h"
-
-class VAO
-{
-public:
-	GLuint ID;
-	VAO();
-
-	void LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset);
-	void Bind();
-	void Unbind();
-	void Delete();
+#pragma once
+
+#include <glad/glad.h>
+#include "VBO.h"
+
+class VAO
+{
+public:
+	GLuint ID;
+	VAO();
+
+	// divisor 0 steps the attribute per vertex, N once every N instances.
+	void LinkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizeiptr stride, void* offset, GLboolean normalized = GL_FALSE, GLuint divisor = 0);
+	void Bind();
+	void Unbind();
+	void Delete();
 };
\ No newline at end of file
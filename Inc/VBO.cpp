@@ -1,30 +1,31 @@
-#include "VBO.h"
-
-VBO::VBO(GLfloat* vertices, GLsizeiptr size)
-{
-	glGenBuffers(1, &ID);
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-	glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
-}
-
-void VBO::setup(GLfloat* vertices, GLsizeiptr size)
-{
-	glGenBuffers(1, &ID);
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-	glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
-}
-
-void VBO::Bind()
-{
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-}
-
-void VBO::Unbind()
-{
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-}
-
-void VBO::Delete()
-{
-	glDeleteBuffers(1, &ID);
+#include "VBO.h"
+#include "GLStateCache.h"
+
+VBO::VBO(const void* vertices, GLsizeiptr size)
+{
+	glGenBuffers(1, &ID);
+	GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, ID);
+	glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+}
+
+void VBO::setup(const void* vertices, GLsizeiptr size)
+{
+	glGenBuffers(1, &ID);
+	GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, ID);
+	glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+}
+
+void VBO::Bind()
+{
+	GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, ID);
+}
+
+void VBO::Unbind()
+{
+	GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VBO::Delete()
+{
+	GLStateCache::Get().DeleteBuffer(ID);
 }
\ No newline at end of file
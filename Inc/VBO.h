@@ -1,16 +1,16 @@
-#pragma once
-
-#include "glad/glad.h"
-
-class VBO
-{
-public:
-	GLuint ID;
-	VBO() : ID(0) {}
-	VBO(GLfloat* vertices, GLsizeiptr size);
-
-	void setup(GLfloat* vertices, GLsizeiptr size);
-	void Bind();
-	void Unbind();
-	void Delete();
+#pragma once
+
+#include "glad/glad.h"
+
+class VBO
+{
+public:
+	GLuint ID;
+	VBO() : ID(0) {}
+	VBO(const void* vertices, GLsizeiptr size);
+
+	void setup(const void* vertices, GLsizeiptr size);
+	void Bind();
+	void Unbind();
+	void Delete();
 };
\ No newline at end of file
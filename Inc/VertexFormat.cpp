@@ -0,0 +1,312 @@
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/packing.hpp"
+
+// Signed normalized values are decoded with the GL 4.2+ rule, max(c / (2^(b-1) - 1), -1),
+// which is what current drivers use in 3.3 contexts as well.
+namespace
+{
+	GLuint PositionBytes(VertexFormat::PositionType type)
+	{
+		return type == VertexFormat::PositionType::Float32 ? 3 * sizeof(GLfloat) : 4 * sizeof(uint16_t);
+	}
+
+	GLuint TexCoordBytes(VertexFormat::TexCoordType type)
+	{
+		return type == VertexFormat::TexCoordType::Float32 ? 2 * sizeof(GLfloat) : 2 * sizeof(uint16_t);
+	}
+
+	GLuint NormalBytes(VertexFormat::NormalType type)
+	{
+		return type == VertexFormat::NormalType::Float32 ? 3 * sizeof(GLfloat) : sizeof(uint32_t);
+	}
+
+	glm::vec2 SignNotZero(glm::vec2 v)
+	{
+		return glm::vec2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	glm::vec2 OctahedralWrap(glm::vec3 n)
+	{
+		n /= std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+
+		glm::vec2 p{ n.x, n.y };
+		if (n.z < 0.0f)
+			p = (glm::vec2(1.0f) - glm::abs(glm::vec2(p.y, p.x))) * SignNotZero(p);
+
+		return p;
+	}
+
+	// Same math as DecodeNormal in the mesh vertex shaders.
+	glm::vec3 OctahedralUnwrap(glm::vec2 p)
+	{
+		glm::vec3 n{ p.x, p.y, 1.0f - std::fabs(p.x) - std::fabs(p.y) };
+		float t{ std::max(-n.z, 0.0f) };
+		n.x += n.x >= 0.0f ? -t : t;
+		n.y += n.y >= 0.0f ? -t : t;
+
+		return glm::normalize(n);
+	}
+
+	// Tries the four floor/ceil roundings of the wrapped coordinates and keeps the one that
+	// decodes closest to n. Plain rounding can be up to ~2x worse near the octahedron edges.
+	void EncodeOctahedral(glm::vec3 n, uint16_t out[2])
+	{
+		glm::vec2 p{ OctahedralWrap(n) * 32767.0f };
+		float bestDot{ -2.0f };
+
+		for (int i{ 0 }; i < 4; i++)
+		{
+			float x{ (i & 1) ? std::ceil(p.x) : std::floor(p.x) };
+			float y{ (i & 2) ? std::ceil(p.y) : std::floor(p.y) };
+			x = std::clamp(x, -32767.0f, 32767.0f);
+			y = std::clamp(y, -32767.0f, 32767.0f);
+
+			float d{ glm::dot(OctahedralUnwrap(glm::vec2(x, y) / 32767.0f), n) };
+			if (d > bestDot)
+			{
+				bestDot = d;
+				out[0] = (uint16_t)(int16_t)x;
+				out[1] = (uint16_t)(int16_t)y;
+			}
+		}
+	}
+
+	float AngleDegrees(glm::vec3 a, glm::vec3 b)
+	{
+		// atan2 instead of acos, which loses all precision for nearly parallel vectors.
+		return glm::degrees(std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b)));
+	}
+}
+
+VertexFormat::Attribute VertexFormat::PositionAttrib() const
+{
+	switch (Position)
+	{
+	case PositionType::Half16:
+		return { 0, 3, GL_HALF_FLOAT, GL_FALSE, 0 };
+	case PositionType::Snorm16:
+		return { 0, 3, GL_SHORT, GL_TRUE, 0 };
+	default:
+		return { 0, 3, GL_FLOAT, GL_FALSE, 0 };
+	}
+}
+
+VertexFormat::Attribute VertexFormat::TexCoordAttrib() const
+{
+	GLuint offset{ PositionBytes(Position) };
+
+	if (TexCoord == TexCoordType::Half16)
+		return { 1, 2, GL_HALF_FLOAT, GL_FALSE, offset };
+
+	return { 1, 2, GL_FLOAT, GL_FALSE, offset };
+}
+
+VertexFormat::Attribute VertexFormat::NormalAttrib() const
+{
+	GLuint offset{ PositionBytes(Position) + TexCoordBytes(TexCoord) };
+
+	switch (Normal)
+	{
+	case NormalType::Octahedral16:
+		return { 2, 2, GL_SHORT, GL_TRUE, offset };
+	case NormalType::Snorm10:
+		return { 2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offset };
+	default:
+		return { 2, 3, GL_FLOAT, GL_FALSE, offset };
+	}
+}
+
+GLsizei VertexFormat::Stride() const
+{
+	return (GLsizei)(PositionBytes(Position) + TexCoordBytes(TexCoord) + NormalBytes(Normal));
+}
+
+std::string VertexFormat::Name() const
+{
+	const char* positionNames[]{ "f32", "half", "snorm16" };
+	const char* texCoordNames[]{ "f32", "half" };
+	const char* normalNames[]{ "f32", "oct16", "snorm10" };
+
+	return std::string(positionNames[(int)Position]) + "/" + texCoordNames[(int)TexCoord] + "/" + normalNames[(int)Normal];
+}
+
+void VertexFormat::Link(VAO& vao, VBO& vbo) const
+{
+	for (const Attribute& attrib : { PositionAttrib(), TexCoordAttrib(), NormalAttrib() })
+	{
+		vao.LinkAttrib(vbo, attrib.Layout, attrib.Components, attrib.Type, Stride(), (void*)(uintptr_t)attrib.Offset, attrib.Normalized);
+	}
+}
+
+glm::mat4 EncodedMesh::DecodeMatrix() const
+{
+	glm::mat4 decode{ glm::mat4(1.0f) };
+	decode = glm::translate(decode, PositionOffset);
+	decode = glm::scale(decode, PositionScale);
+
+	return decode;
+}
+
+EncodedMesh EncodeVertices(const GLfloat* vertices, size_t vertexCount, const VertexFormat& format)
+{
+	EncodedMesh mesh;
+	mesh.Format = format;
+	mesh.VertexCount = vertexCount;
+	mesh.Data.resize(vertexCount * format.Stride());
+
+	if (vertexCount == 0)
+		return mesh;
+
+	glm::vec3 boundsMin{ vertices[0], vertices[1], vertices[2] };
+	glm::vec3 boundsMax{ boundsMin };
+	for (size_t i{ 1 }; i < vertexCount; i++)
+	{
+		glm::vec3 p{ vertices[i * 8 + 0], vertices[i * 8 + 1], vertices[i * 8 + 2] };
+		boundsMin = glm::min(boundsMin, p);
+		boundsMax = glm::max(boundsMax, p);
+	}
+
+	if (format.Position != VertexFormat::PositionType::Float32)
+		mesh.PositionOffset = (boundsMin + boundsMax) * 0.5f;
+
+	if (format.Position == VertexFormat::PositionType::Snorm16)
+	{
+		mesh.PositionScale = (boundsMax - boundsMin) * 0.5f;
+		for (int axis{ 0 }; axis < 3; axis++)
+		{
+			if (mesh.PositionScale[axis] <= 0.0f)
+				mesh.PositionScale[axis] = 1.0f;
+		}
+	}
+
+	VertexFormat::Attribute texAttrib{ format.TexCoordAttrib() };
+	VertexFormat::Attribute normalAttrib{ format.NormalAttrib() };
+
+	for (size_t i{ 0 }; i < vertexCount; i++)
+	{
+		const GLfloat* src{ vertices + i * 8 };
+		uint8_t* dst{ mesh.Data.data() + i * format.Stride() };
+
+		glm::vec3 position{ src[0], src[1], src[2] };
+		glm::vec2 texCoord{ src[3], src[4] };
+		glm::vec3 normal{ src[5], src[6], src[7] };
+
+		glm::vec3 decodedPosition{ position };
+		glm::vec2 decodedTexCoord{ texCoord };
+		glm::vec3 decodedNormal{ normal };
+
+		switch (format.Position)
+		{
+		case VertexFormat::PositionType::Float32:
+			std::memcpy(dst, src, 3 * sizeof(GLfloat));
+			break;
+		case VertexFormat::PositionType::Half16:
+		{
+			uint16_t packed[4]{};
+			for (int axis{ 0 }; axis < 3; axis++)
+			{
+				packed[axis] = glm::packHalf1x16(position[axis] - mesh.PositionOffset[axis]);
+				decodedPosition[axis] = glm::unpackHalf1x16(packed[axis]) + mesh.PositionOffset[axis];
+			}
+			std::memcpy(dst, packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::PositionType::Snorm16:
+		{
+			uint16_t packed[4]{};
+			for (int axis{ 0 }; axis < 3; axis++)
+			{
+				packed[axis] = glm::packSnorm1x16((position[axis] - mesh.PositionOffset[axis]) / mesh.PositionScale[axis]);
+				decodedPosition[axis] = glm::unpackSnorm1x16(packed[axis]) * mesh.PositionScale[axis] + mesh.PositionOffset[axis];
+			}
+			std::memcpy(dst, packed, sizeof(packed));
+			break;
+		}
+		}
+
+		if (format.TexCoord == VertexFormat::TexCoordType::Half16)
+		{
+			uint16_t packed[2]{ glm::packHalf1x16(texCoord.x), glm::packHalf1x16(texCoord.y) };
+			decodedTexCoord = glm::vec2(glm::unpackHalf1x16(packed[0]), glm::unpackHalf1x16(packed[1]));
+			std::memcpy(dst + texAttrib.Offset, packed, sizeof(packed));
+		}
+		else
+		{
+			std::memcpy(dst + texAttrib.Offset, src + 3, 2 * sizeof(GLfloat));
+		}
+
+		// Degenerate normals from the loader are passed through as +Y instead of NaNs.
+		float normalLength{ glm::length(normal) };
+		glm::vec3 unitNormal{ normalLength > 0.0f ? normal / normalLength : glm::vec3(0.0f, 1.0f, 0.0f) };
+
+		switch (format.Normal)
+		{
+		case VertexFormat::NormalType::Float32:
+			std::memcpy(dst + normalAttrib.Offset, src + 5, 3 * sizeof(GLfloat));
+			break;
+		case VertexFormat::NormalType::Octahedral16:
+		{
+			uint16_t packed[2];
+			EncodeOctahedral(unitNormal, packed);
+			decodedNormal = OctahedralUnwrap(glm::vec2(glm::unpackSnorm1x16(packed[0]), glm::unpackSnorm1x16(packed[1])));
+			std::memcpy(dst + normalAttrib.Offset, packed, sizeof(packed));
+			break;
+		}
+		case VertexFormat::NormalType::Snorm10:
+		{
+			uint32_t packed{ glm::packSnorm3x10_1x2(glm::vec4(unitNormal, 0.0f)) };
+			decodedNormal = glm::normalize(glm::vec3(glm::unpackSnorm3x10_1x2(packed)));
+			std::memcpy(dst + normalAttrib.Offset, &packed, sizeof(packed));
+			break;
+		}
+		}
+
+		mesh.MaxPositionError = std::max(mesh.MaxPositionError, glm::length(decodedPosition - position));
+		mesh.MaxTexCoordError = std::max(mesh.MaxTexCoordError, glm::length(decodedTexCoord - texCoord));
+		if (normalLength > 0.0f)
+			mesh.MaxNormalErrorDegrees = std::max(mesh.MaxNormalErrorDegrees, AngleDegrees(glm::normalize(decodedNormal), unitNormal));
+	}
+
+	return mesh;
+}
+
+void PrintVertexFormatReport(const std::string& name, const GLfloat* vertices, size_t vertexCount)
+{
+	using P = VertexFormat::PositionType;
+	using T = VertexFormat::TexCoordType;
+	using N = VertexFormat::NormalType;
+
+	const VertexFormat formats[]{
+		VertexFormat::Full(),
+		VertexFormat(P::Half16, T::Half16, N::Octahedral16),
+		VertexFormat(P::Snorm16, T::Half16, N::Snorm10),
+		VertexFormat::Compact()
+	};
+
+	std::streamsize precision{ std::cout.precision() };
+
+	std::cout << "- " << name << " vertex formats (" << vertexCount << " vertices)\n";
+	std::cout << "  " << std::left << std::setw(22) << "format" << std::right << std::setw(6) << "B/vtx" << std::setw(10) << "KB"
+		<< std::setw(12) << "pos err" << std::setw(12) << "uv err" << std::setw(12) << "nrm deg" << "\n";
+
+	for (const VertexFormat& format : formats)
+	{
+		EncodedMesh mesh{ EncodeVertices(vertices, vertexCount, format) };
+
+		std::cout << "  " << std::left << std::setw(22) << format.Name() << std::right << std::setw(6) << format.Stride()
+			<< std::setw(10) << std::fixed << std::setprecision(1) << mesh.Bytes() / 1024.0
+			<< std::setw(12) << std::scientific << std::setprecision(2) << mesh.MaxPositionError
+			<< std::setw(12) << mesh.MaxTexCoordError
+			<< std::setw(12) << std::fixed << std::setprecision(3) << mesh.MaxNormalErrorDegrees << "\n";
+	}
+
+	std::cout << std::defaultfloat << std::setprecision(precision);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "VAO.h"
+#include "VBO.h"
+
+// Storage layout of the position / texture coordinate / normal attributes of a mesh vertex.
+//
+// Every format feeds the same shader inputs (location 0 = aPos, 1 = aTex, 2 = aNormal).
+// Snorm16 positions are relative to the mesh bounds, so the model matrix has to be
+// multiplied by EncodedMesh::DecodeMatrix. Octahedral normals arrive as aNormal.xy and
+// are unpacked in the vertex shader built with the OCT_NORMALS permutation define.
+class VertexFormat
+{
+public:
+	enum class PositionType { Float32, Half16, Snorm16 };
+	enum class TexCoordType { Float32, Half16 };
+	enum class NormalType { Float32, Octahedral16, Snorm10 };
+
+	struct Attribute
+	{
+		GLuint Layout;
+		GLuint Components;
+		GLenum Type;
+		GLboolean Normalized;
+		GLuint Offset;
+	};
+
+	PositionType Position{ PositionType::Float32 };
+	TexCoordType TexCoord{ TexCoordType::Float32 };
+	NormalType Normal{ NormalType::Float32 };
+
+	VertexFormat() = default;
+	VertexFormat(PositionType position, TexCoordType texCoord, NormalType normal) : Position(position), TexCoord(texCoord), Normal(normal) {}
+
+	// 32 bytes: the 8 float layout written by MeshCache.
+	static VertexFormat Full() { return VertexFormat(); }
+	// 16 bytes: snorm16 position, half UV, octahedral snorm16 normal.
+	static VertexFormat Compact() { return VertexFormat(PositionType::Snorm16, TexCoordType::Half16, NormalType::Octahedral16); }
+
+	Attribute PositionAttrib() const;
+	Attribute TexCoordAttrib() const;
+	Attribute NormalAttrib() const;
+	GLsizei Stride() const;
+
+	bool OctahedralNormals() const { return Normal == NormalType::Octahedral16; }
+	bool operator==(const VertexFormat& other) const { return Position == other.Position && TexCoord == other.TexCoord && Normal == other.Normal; }
+	std::string Name() const;
+
+	// Calls VAO::LinkAttrib for the three attributes. The VAO has to be bound.
+	void Link(VAO& vao, VBO& vbo) const;
+};
+
+// Vertex data converted to a VertexFormat along with the worst error the conversion made.
+struct EncodedMesh
+{
+	VertexFormat Format;
+	std::vector<uint8_t> Data;
+	size_t VertexCount{ 0 };
+
+	// Decoded position = attribute * PositionScale + PositionOffset.
+	glm::vec3 PositionOffset{ 0.0f };
+	glm::vec3 PositionScale{ 1.0f };
+
+	float MaxPositionError{ 0.0f };
+	float MaxTexCoordError{ 0.0f };
+	float MaxNormalErrorDegrees{ 0.0f };
+
+	GLsizeiptr Bytes() const { return (GLsizeiptr)Data.size(); }
+	glm::mat4 DecodeMatrix() const;
+};
+
+// vertices is the interleaved position(3) / texture(2) / normal(3) float layout.
+EncodedMesh EncodeVertices(const GLfloat* vertices, size_t vertexCount, const VertexFormat& format);
+
+// Encodes the mesh in every format and prints bytes per vertex and the error of each.
+void PrintVertexFormatReport(const std::string& name, const GLfloat* vertices, size_t vertexCount);
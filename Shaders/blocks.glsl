@@ -0,0 +1,14 @@
+layout (std140) uniform FrameData
+{
+	mat4 camMatrix;
+	vec4 lightColor;
+	vec3 lightPos;
+	vec3 camPos;
+};
+
+layout (std140) uniform ObjectData
+{
+	mat4 model;
+	vec2 layers;
+	mat3 normalMatrix;
+};
\ No newline at end of file
@@ -1,7 +1,7 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-void main()
-{
-	gl_Position = vec4(aPos, 1.0f);
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+void main()
+{
+	gl_Position = vec4(aPos, 1.0f);
 }
\ No newline at end of file
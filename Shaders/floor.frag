@@ -1,49 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-in vec2 texCoord;
-
-in vec3 Normal;
-in vec3 crntPos;
-
-uniform sampler2D tex0;
-uniform sampler2D tex1;
-
-uniform vec4 lightColor;
-uniform vec3 lightPos;
-uniform vec3 camPos;
-
-vec4 pointLight()
-{
-	vec3 lightVec = lightPos - crntPos;
-	float dist = length(lightVec);
-	float a = 0.05f;
-	float b = 0.01f;
-	float inten = 1.0f/ (a * dist * dist + b * dist + 1.0f);
-
-	float ambient = 0.14f;
-
-	vec3 normal = normalize(Normal);
-	vec3 lightDirection = normalize(lightVec);
-	float diffuse = max(dot(normal, lightDirection), 0.0f);
-
-	float specular = 0.0f;
-	if (diffuse != 0.0f)
-	{
-		float specularLight = 0.50f;
-		vec3 viewDirection = normalize(camPos - crntPos);
-		vec3 reflectionDirection = reflect(-lightDirection, normal);
-
-		vec3 halfwayVec = normalize(viewDirection + lightDirection);
-
-		float specAmount = pow(max(dot(normal, halfwayVec), 0.0f), 8);
-		specular = specAmount * specularLight;
-	}
-	
-	return (texture(tex0, texCoord) * lightColor * (diffuse * inten + ambient) + texture(tex1, texCoord).r * specular * inten) * lightColor;
-}
-
-void main()
-{
-	FragColor = pointLight();
-}
\ No newline at end of file
@@ -1,9 +1,9 @@
-#version 330 core
-out vec4 FragColor;
-
-uniform vec4 lightColor;
-
-void main()
-{
-	FragColor = lightColor;
+#version 330 core
+out vec4 FragColor;
+
+#include "blocks.glsl"
+
+void main()
+{
+	FragColor = lightColor;
 }
\ No newline at end of file
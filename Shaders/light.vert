@@ -1,10 +1,9 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-uniform mat4 lightModel;
-uniform mat4 camMatrix;
-
-void main()
-{
-	gl_Position = camMatrix * lightModel * vec4(aPos, 1.0f);
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+#include "blocks.glsl"
+
+void main()
+{
+	gl_Position = camMatrix * model * vec4(aPos, 1.0f);
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTex;
+layout (location = 2) in vec3 aNormal;
+
+out vec2 texCoord;
+
+out vec3 Normal;
+out vec3 crntPos;
+
+#include "blocks.glsl"
+
+#ifdef TEX_SCALE
+uniform vec2 texScale;
+#endif
+
+#ifdef INSTANCED
+// Per copy, from an InstanceBuffer, in place of the ObjectData matrices.
+layout (location = 3) in mat4 instanceModel;
+layout (location = 7) in mat3 instanceNormalMatrix;
+layout (location = 10) in vec2 instanceLayers;
+
+flat out vec2 objectLayers;
+#endif
+
+// Octahedral normals come in as aNormal.xy (see VertexFormat).
+vec3 DecodeNormal(vec3 n)
+{
+#ifdef OCT_NORMALS
+	vec3 v = vec3(n.xy, 1.0f - abs(n.x) - abs(n.y));
+	float t = max(-v.z, 0.0f);
+	v.x += (v.x >= 0.0f) ? -t : t;
+	v.y += (v.y >= 0.0f) ? -t : t;
+
+	return normalize(v);
+#else
+	return n;
+#endif
+}
+
+void main()
+{
+#ifdef INSTANCED
+	mat4 objectModel = instanceModel;
+	mat3 objectNormalMatrix = instanceNormalMatrix;
+	objectLayers = instanceLayers;
+#else
+	mat4 objectModel = model;
+	mat3 objectNormalMatrix = normalMatrix;
+#endif
+
+	crntPos = vec3(objectModel * vec4(aPos, 1.0f));
+
+	gl_Position = camMatrix * vec4(crntPos, 1.0f);
+#ifdef TEX_SCALE
+	texCoord = aTex * texScale;
+#else
+	texCoord = aTex;
+#endif
+#ifdef NORMAL_MATRIX
+	Normal = normalize(objectNormalMatrix * DecodeNormal(aNormal));
+#else
+	Normal = DecodeNormal(aNormal);
+#endif
+}
\ No newline at end of file
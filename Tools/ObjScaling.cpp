@@ -0,0 +1,222 @@
+// Synthetic .obj generator and thread scaling benchmark for objl::Loader::LoadFileParallel.
+//
+// Usage: ObjScaling generate <out.obj> [faces]
+//        ObjScaling bench <file.obj> [max threads]
+// generate writes four height field objects with about faces face lines in total (2 million
+// by default, about 180 MB) plus the .mtl next to it. The faces mix v/vt/vn quads, negative
+// indices, v//vn, v/vt and bare v corners, with a usemtl in the middle of an object, so every
+// path of the parser is hit.
+// bench loads the file once with LoadFileMapped as the reference, then with LoadFileParallel
+// on 1, 2, 4, ... threads up to max threads (every hardware thread by default). It prints the
+// time, throughput and speedup over one thread of each, and checks the result against the
+// reference. Returns 1 if any thread count gives different meshes.
+//
+// Build it on its own next to the main project, e.g.
+//   g++ -std=c++17 -O2 -pthread Tools/ObjScaling.cpp -o ObjScaling
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Inc/OBJ_Loader.hpp"
+
+namespace
+{
+	constexpr int objectCount{ 4 };
+
+	bool Generate(const std::string& path, size_t faces)
+	{
+		std::filesystem::path mtlPath{ std::filesystem::path(path).replace_extension(".mtl") };
+
+		FILE* mtl{ std::fopen(mtlPath.string().c_str(), "w") };
+		if (!mtl)
+			return false;
+		for (int m{ 0 }; m < 3; m++)
+			std::fprintf(mtl, "newmtl m%d\nKd 0.8 0.8 0.8\n\n", m);
+		std::fclose(mtl);
+
+		FILE* out{ std::fopen(path.c_str(), "w") };
+		if (!out)
+			return false;
+
+		std::vector<char> buffer(1 << 20);
+		std::setvbuf(out, buffer.data(), _IOFBF, buffer.size());
+
+		// Every three grid cells write five face lines between them.
+		size_t cells{ faces * 3 / 5 / objectCount };
+		long long grid{ (long long)std::sqrt((double)cells) + 1 };
+
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> height(0.0f, 0.1f);
+
+		std::fprintf(out, "# synthetic\nmtllib %s\n", mtlPath.filename().string().c_str());
+
+		long long written{ 0 };
+		for (int o{ 0 }; o < objectCount; o++)
+		{
+			std::fprintf(out, "o Obj%d\n", o);
+
+			long long base{ written };
+			for (long long i{ 0 }; i < grid; i++)
+			{
+				for (long long j{ 0 }; j < grid; j++)
+				{
+					std::fprintf(out, "v %.6f %.6f %.6f\n", i * 0.01, height(random), j * 0.01);
+					std::fprintf(out, "vt %.6f %.6f\n", (double)i / grid, (double)j / grid);
+					std::fprintf(out, "vn 0.000000 1.000000 0.000000\n");
+					written++;
+				}
+			}
+
+			std::fprintf(out, "usemtl m%d\n", o % 2);
+			for (long long i{ 0 }; i + 1 < grid; i++)
+			{
+				// Half way through the second object, so a mesh splits mid-object.
+				if (o == 1 && i == grid / 2)
+					std::fprintf(out, "usemtl m2\n");
+
+				for (long long j{ 0 }; j + 1 < grid; j++)
+				{
+					long long a{ base + i * grid + j + 1 };
+					long long b{ a + 1 };
+					long long c{ a + grid };
+					long long d{ c + 1 };
+
+					switch ((i + j) % 3)
+					{
+					case 0:
+						std::fprintf(out, "f %lld/%lld/%lld %lld/%lld/%lld %lld/%lld/%lld %lld/%lld/%lld\n", a, a, a, b, b, b, d, d, d, c, c, c);
+						break;
+					case 1:
+					{
+						long long ra{ a - written - 1 };
+						long long rb{ b - written - 1 };
+						long long rd{ d - written - 1 };
+						std::fprintf(out, "f %lld/%lld/%lld %lld/%lld/%lld %lld/%lld/%lld\n", ra, ra, ra, rb, rb, rb, rd, rd, rd);
+						std::fprintf(out, "f %lld//%lld %lld//%lld %lld//%lld\n", a, a, d, d, c, c);
+						break;
+					}
+					default:
+						std::fprintf(out, "f %lld/%lld %lld/%lld %lld/%lld\n", a, a, b, b, d, d);
+						std::fprintf(out, "f %lld %lld %lld\n", a, d, c);
+						break;
+					}
+				}
+			}
+		}
+
+		std::fclose(out);
+		return true;
+	}
+
+	bool SameVertex(const objl::Vertex& a, const objl::Vertex& b)
+	{
+		return std::memcmp(&a, &b, sizeof(objl::Vertex)) == 0;
+	}
+
+	bool SameResult(const objl::Loader& reference, const objl::Loader& loader)
+	{
+		if (reference.LoadedIndices != loader.LoadedIndices
+			|| reference.LoadedVertices.size() != loader.LoadedVertices.size()
+			|| reference.LoadedMeshes.size() != loader.LoadedMeshes.size())
+			return false;
+
+		for (size_t i{ 0 }; i < reference.LoadedVertices.size(); i++)
+		{
+			if (!SameVertex(reference.LoadedVertices[i], loader.LoadedVertices[i]))
+				return false;
+		}
+
+		for (size_t m{ 0 }; m < reference.LoadedMeshes.size(); m++)
+		{
+			const objl::Mesh& a{ reference.LoadedMeshes[m] };
+			const objl::Mesh& b{ loader.LoadedMeshes[m] };
+			if (a.MeshName != b.MeshName || a.MeshMaterial.name != b.MeshMaterial.name
+				|| a.VertexOffset != b.VertexOffset || a.VertexCount != b.VertexCount
+				|| a.IndexOffset != b.IndexOffset || a.IndexCount != b.IndexCount)
+				return false;
+		}
+
+		return true;
+	}
+
+	int Bench(const std::string& path, unsigned int maxThreads)
+	{
+		// Arena keeps one copy of the data, so the reference and the run under test fit together.
+		objl::Loader reference;
+		reference.Storage = objl::Loader::StorageMode::Arena;
+		if (!reference.LoadFileMapped(path))
+		{
+			std::fprintf(stderr, "Failed to load %s\n", path.c_str());
+			return 1;
+		}
+
+		std::printf("\n%s: %.1f MB, %zu meshes, %zu vertices\n", path.c_str(), reference.LastLoadStats.Bytes / (1024.0 * 1024.0),
+			reference.LoadedMeshes.size(), reference.LoadedVertices.size());
+		std::printf("LoadFileMapped: %.1f ms (%.1f MB/s)\n\n", reference.LastLoadStats.Seconds * 1000.0, reference.LastLoadStats.ThroughputMBs());
+
+		struct Run
+		{
+			unsigned int Threads;
+			double Seconds;
+			double Throughput;
+			bool Same;
+		};
+		std::vector<Run> runs;
+
+		std::vector<unsigned int> threadCounts;
+		for (unsigned int threads{ 1 }; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(maxThreads);
+
+		for (unsigned int threads : threadCounts)
+		{
+			objl::Loader loader;
+			loader.Storage = objl::Loader::StorageMode::Arena;
+			loader.LoadFileParallel(path, threads);
+			runs.push_back({ threads, loader.LastLoadStats.Seconds, loader.LastLoadStats.ThroughputMBs(), SameResult(reference, loader) });
+		}
+
+		bool allSame{ true };
+		std::printf("\n%8s %10s %10s %8s\n", "threads", "ms", "MB/s", "speedup");
+		for (const Run& run : runs)
+		{
+			std::printf("%8u %10.1f %10.1f %7.2fx %s\n", run.Threads, run.Seconds * 1000.0, run.Throughput,
+				runs.front().Seconds / run.Seconds, run.Same ? "same as mapped" : "DIFFERENT");
+			allSame = allSame && run.Same;
+		}
+
+		return allSame ? 0 : 1;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc >= 3 && std::strcmp(argv[1], "generate") == 0)
+	{
+		size_t faces{ argc >= 4 ? (size_t)std::strtoull(argv[3], nullptr, 10) : 2000000 };
+		if (!Generate(argv[2], faces))
+		{
+			std::fprintf(stderr, "Failed to write %s\n", argv[2]);
+			return 1;
+		}
+		std::printf("Wrote %s (%.1f MB)\n", argv[2], std::filesystem::file_size(argv[2]) / (1024.0 * 1024.0));
+		return 0;
+	}
+
+	if (argc >= 3 && std::strcmp(argv[1], "bench") == 0)
+	{
+		unsigned int maxThreads{ argc >= 4 ? (unsigned int)std::atoi(argv[3]) : std::thread::hardware_concurrency() };
+		return Bench(argv[2], std::max(maxThreads, 1u));
+	}
+
+	std::fprintf(stderr, "Usage: ObjScaling generate <out.obj> [faces]\n       ObjScaling bench <file.obj> [max threads]\n");
+	return 1;
+}
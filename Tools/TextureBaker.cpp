@@ -0,0 +1,140 @@
+// Offline converter from the Assets images to block compressed .dds files with mipmaps.
+//
+// Usage: TextureBaker [image ...]
+// With no arguments every .png in Assets is converted. Each output goes next to its source
+// (TextureCompressor::CompressedPath), where main.cpp picks it up instead of the .png.
+// Specular maps ("specular" in the name) only keep their red channel, as BC4; everything
+// else is BC1, or BC3 if any texel is not fully opaque.
+//
+// Build it on its own next to the main project, e.g.
+//   g++ -std=c++17 -O2 -I<stb_image dir> Tools/TextureBaker.cpp Inc/TextureCompressor.cpp Inc/MipGenerator.cpp -o TextureBaker
+// and run it from the repository root.
+
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+
+#include "../Inc/TextureCompressor.h"
+
+namespace
+{
+	const char* FormatName(TextureCompressor::Format format)
+	{
+		switch (format)
+		{
+		case TextureCompressor::Format::BC1: return "BC1";
+		case TextureCompressor::Format::BC3: return "BC3";
+		case TextureCompressor::Format::BC4: return "BC4";
+		case TextureCompressor::Format::BC5: return "BC5";
+		}
+		return "?";
+	}
+
+	// What the runtime .png path costs: RGBA8 with a full mip chain from glGenerateMipmap.
+	size_t UncompressedBytes(uint32_t width, uint32_t height)
+	{
+		size_t bytes{ 0 };
+		while (true)
+		{
+			bytes += (size_t)width * height * 4;
+			if (width == 1 && height == 1)
+				return bytes;
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> images;
+	for (int i{ 1 }; i < argc; i++)
+		images.push_back(argv[i]);
+
+	if (images.empty())
+	{
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("Assets", error))
+		{
+			if (entry.path().extension() == ".png")
+				images.push_back(entry.path().generic_string());
+		}
+		std::sort(images.begin(), images.end());
+	}
+
+	if (images.empty())
+	{
+		std::cerr << "No images to convert; run from the repository root or pass image paths\n";
+		return 1;
+	}
+
+	stbi_set_flip_vertically_on_load(true);
+
+	size_t totalBefore{ 0 };
+	size_t totalAfter{ 0 };
+	int failures{ 0 };
+	for (const std::string& path : images)
+	{
+		std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+
+		int width, height, channels;
+		unsigned char* pixels{ stbi_load(path.c_str(), &width, &height, &channels, 4) };
+		if (!pixels)
+		{
+			std::cerr << "Failed to load " << path << "\n";
+			failures++;
+			continue;
+		}
+
+		TextureCompressor::Format format{ TextureCompressor::Format::BC1 };
+		if (std::filesystem::path(path).filename().string().find("specular") != std::string::npos)
+		{
+			format = TextureCompressor::Format::BC4;
+		}
+		else
+		{
+			for (size_t i{ 3 }; i < (size_t)width * height * 4; i += 4)
+			{
+				if (pixels[i] != 255)
+				{
+					format = TextureCompressor::Format::BC3;
+					break;
+				}
+			}
+		}
+
+		// The runtime samples every .png as sRGB, specular maps included.
+		TextureCompressor::Image image{ TextureCompressor::Compress(pixels, (uint32_t)width, (uint32_t)height, format, true) };
+		float psnr{ TextureCompressor::PSNR(pixels, image, true) };
+		stbi_image_free(pixels);
+
+		std::string output{ TextureCompressor::CompressedPath(path) };
+		if (!TextureCompressor::WriteDDS(output, image))
+		{
+			std::cerr << "Failed to write " << output << "\n";
+			failures++;
+			continue;
+		}
+
+		double ms{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() };
+		size_t before{ UncompressedBytes((uint32_t)width, (uint32_t)height) };
+		totalBefore += before;
+		totalAfter += image.Bytes();
+
+		std::printf("%-36s %4dx%-4d %s %2zu mips  %7.1f KB -> %6.1f KB  %5.1f dB  %6.1f ms\n", path.c_str(), width, height, FormatName(format),
+			image.Levels.size(), before / 1024.0, image.Bytes() / 1024.0, psnr, ms);
+	}
+
+	if (totalAfter)
+		std::printf("Total %.1f KB -> %.1f KB of texture memory (%.1fx smaller)\n", totalBefore / 1024.0, totalAfter / 1024.0, (double)totalBefore / totalAfter);
+
+	return failures ? 1 : 0;
+}
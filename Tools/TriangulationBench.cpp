@@ -0,0 +1,175 @@
+// Robustness checks and timings for objl::triangulation, the face triangulation every .obj
+// load goes through.
+//
+// Usage: TriangulationBench
+// Each shape of the robustness set is triangulated in the XY, XZ and a tilted plane and has
+// to give n - 2 triangles wound like the polygon, covering exactly its area. The timing table
+// then gives the time per polygon for convex polygons (the fan) and stars (the ear clipper)
+// of growing size. Returns 1 if any shape fails.
+//
+// Build it on its own next to the main project, e.g.
+//   g++ -std=c++17 -O2 Tools/TriangulationBench.cpp -o TriangulationBench
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../Inc/OBJ_Loader.hpp"
+
+namespace
+{
+	using Outline = std::vector<objl::Vector2>;
+
+	enum class Plane { XY, XZ, Tilted };
+
+	std::vector<objl::Vertex> ToVertices(const Outline& outline, Plane plane)
+	{
+		std::vector<objl::Vertex> vertices;
+		for (const objl::Vector2& point : outline)
+		{
+			objl::Vertex vertex;
+			if (plane == Plane::XY)
+				vertex.Position = objl::Vector3(point.X, point.Y, 0.0f);
+			else if (plane == Plane::XZ)
+				vertex.Position = objl::Vector3(point.X, 0.0f, point.Y);
+			else
+				vertex.Position = objl::Vector3(point.X * 0.7f, point.Y, point.X * 0.7f);
+			vertices.push_back(vertex);
+		}
+		return vertices;
+	}
+
+	// Positive for counter-clockwise points.
+	double SignedArea(const objl::Vector2& a, const objl::Vector2& b, const objl::Vector2& c)
+	{
+		return ((double)b.X - a.X) * ((double)c.Y - a.Y) - ((double)c.X - a.X) * ((double)b.Y - a.Y);
+	}
+
+	double OutlineArea(const Outline& outline)
+	{
+		double area{ 0.0 };
+		for (size_t i{ 0 }, j{ outline.size() - 1 }; i < outline.size(); j = i++)
+			area += (double)outline[j].X * outline[i].Y - (double)outline[i].X * outline[j].Y;
+		return area;
+	}
+
+	bool Check(const char* name, const Outline& outline)
+	{
+		bool passed{ true };
+		double expected{ OutlineArea(outline) };
+		const char* planeNames[]{ "XY", "XZ", "tilted" };
+
+		for (Plane plane : { Plane::XY, Plane::XZ, Plane::Tilted })
+		{
+			std::vector<objl::Vertex> vertices{ ToVertices(outline, plane) };
+			std::vector<unsigned int> indices;
+			objl::triangulation::Triangulate(indices, vertices.data(), vertices.size());
+
+			if (indices.size() != (outline.size() - 2) * 3)
+			{
+				std::printf("  %s, %s plane: %zu triangles, expected %zu\n", name, planeNames[(int)plane], indices.size() / 3, outline.size() - 2);
+				passed = false;
+				continue;
+			}
+
+			// Every triangle is wound like the outline and together they cover its area once.
+			double covered{ 0.0 };
+			bool wound{ true };
+			for (size_t t{ 0 }; t < indices.size(); t += 3)
+			{
+				double area{ SignedArea(outline[indices[t]], outline[indices[t + 1]], outline[indices[t + 2]]) };
+				covered += std::fabs(area);
+				if (area * expected < -1e-9)
+					wound = false;
+			}
+
+			if (std::fabs(covered - std::fabs(expected)) > 1e-3 * std::fabs(expected) + 1e-6 || !wound)
+			{
+				std::printf("  %s, %s plane: area %f of %f, %s\n", name, planeNames[(int)plane], covered / 2.0, std::fabs(expected) / 2.0,
+					wound ? "wound right" : "a triangle is flipped");
+				passed = false;
+			}
+		}
+
+		std::printf("%-14s %4zu vertices  %s\n", name, outline.size(), passed ? "ok" : "FAILED");
+		return passed;
+	}
+
+	Outline Circle(int count, bool clockwise = false)
+	{
+		Outline outline;
+		for (int i{ 0 }; i < count; i++)
+		{
+			float angle{ (clockwise ? -6.2831853f : 6.2831853f) * i / count };
+			outline.push_back(objl::Vector2(std::cos(angle), std::sin(angle)));
+		}
+		return outline;
+	}
+
+	// Alternates between radius 1 and 0.4, so every other corner is reflex.
+	Outline Star(int count)
+	{
+		Outline outline;
+		for (int i{ 0 }; i < count; i++)
+		{
+			float angle{ 6.2831853f * i / count };
+			float radius{ i % 2 ? 0.4f : 1.0f };
+			outline.push_back(objl::Vector2(radius * std::cos(angle), radius * std::sin(angle)));
+		}
+		return outline;
+	}
+
+	// A bar along the bottom with teeth rising from it, the worst case for ear searches.
+	Outline Comb(int teeth)
+	{
+		Outline outline{ objl::Vector2(0.0f, 0.0f), objl::Vector2(teeth * 2.0f, 0.0f) };
+		for (int t{ teeth - 1 }; t >= 0; t--)
+		{
+			outline.push_back(objl::Vector2(t * 2.0f + 2.0f, 3.0f));
+			outline.push_back(objl::Vector2(t * 2.0f + 1.0f, 3.0f));
+			outline.push_back(objl::Vector2(t * 2.0f + 1.0f, 1.0f));
+			outline.push_back(objl::Vector2(t * 2.0f, 1.0f));
+		}
+		outline.back() = objl::Vector2(0.0f, 3.0f);
+		return outline;
+	}
+
+	double MicrosecondsPerPolygon(const Outline& outline)
+	{
+		std::vector<objl::Vertex> vertices{ ToVertices(outline, Plane::Tilted) };
+		std::vector<unsigned int> indices;
+		int repeats{ outline.size() < 64 ? 20000 : 500 };
+
+		std::chrono::steady_clock::time_point start{ std::chrono::steady_clock::now() };
+		for (int r{ 0 }; r < repeats; r++)
+		{
+			indices.clear();
+			objl::triangulation::Triangulate(indices, vertices.data(), vertices.size());
+		}
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeats;
+	}
+}
+
+int main()
+{
+	bool passed{ true };
+
+	passed &= Check("triangle", Circle(3));
+	passed &= Check("quad", { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } });
+	passed &= Check("quad cw", { { 0, 0 }, { 0, 1 }, { 1, 1 }, { 1, 0 } });
+	passed &= Check("concave quad", { { 0, 0 }, { 2, 0 }, { 0.5f, 0.5f }, { 0, 2 } });
+	passed &= Check("collinear", { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 2, 1 }, { 1, 1 }, { 0, 1 } });
+	passed &= Check("L shape", { { 0, 0 }, { 2, 0 }, { 2, 1 }, { 1, 1 }, { 1, 2 }, { 0, 2 } });
+	passed &= Check("circle 64", Circle(64));
+	passed &= Check("circle 64 cw", Circle(64, true));
+	passed &= Check("star 16", Star(16));
+	passed &= Check("star 256", Star(256));
+	passed &= Check("comb 20", Comb(20));
+
+	std::printf("\n%8s %14s %14s\n", "vertices", "convex us", "star us");
+	for (int count : { 4, 8, 16, 32, 64, 128, 256, 512 })
+		std::printf("%8d %14.2f %14.2f\n", count, MicrosecondsPerPolygon(Circle(count)), MicrosecondsPerPolygon(Star(count)));
+
+	return passed ? 0 : 1;
+}
@@ -1,686 +1,1167 @@
-#define STB_IMAGE_IMPLEMENTATION
-
-#include <iostream>
-
-#include "glad/glad.h"
-#include "GLFW/glfw3.h"
-#include "glm/glm.hpp"
-#include "glm/gtc/matrix_transform.hpp"
-#include "glm/gtc/type_ptr.hpp"
-
-#include "imgui/imgui.h"
-#include "imgui/imgui_impl_glfw.h"
-#include "imgui/imgui_impl_opengl3.h"
-
-#include "Inc/Camera.h"
-#include "Inc/Texture.h"
-#include "Inc/OBJ_Loader.hpp"
-
-#include "Inc/Shader.h"
-#include "Inc/VAO.h"
-#include "Inc/VBO.h"
-#include "Inc/EBO.h"
-
-constexpr unsigned int wWidth{ 800 };
-constexpr unsigned int wHeight{ 800 };
-
-constexpr float gamma{ 2.2f };
-
-// TODO: Add footstep sound.
-// TODO: Add camera movement when walking.
-// TODO: Add collision.
-// TODO: Add walls and roof.
-// TODO: Make the light cube a light bulb.
-int main()
-{
-	glfwInit();
-
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_SAMPLES, 8);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
-
-	GLfloat crosshairVertices[]{
-		// Left Triangle
-		-0.0025f,  0.0025f, 0.0f,
-		 0.0025f,  0.0025f, 0.0f,
-		-0.0025f, -0.0025f, 0.0f,
-
-		// Right Triangle
-		-0.0025f, -0.0025f, 0.0f,
-		 0.0025f,  0.0025f, 0.0f,
-		 0.0025f, -0.0025f, 0.0f
-	};
-
-	GLuint crosshairIndices[]{
-		// Left Triangle
-		0, 1, 2,
-
-		// Right Triangle
-		3, 4, 5
-	};
-
-	GLfloat floorVertices[]{
-		//   COORDINATES     |   TEXTURE    |       NORMALS    //
-		// Bottom
-		-0.5f, -0.02f, 0.5f,	0.0f, 0.0f,		0.0f, -1.0f, 0.0f,
-		-0.5f, -0.02f, -0.5f,   0.0f, 5.0f,		0.0f, -1.0f, 0.0f,
-		0.5f, -0.02f, -0.5f,    5.0f, 5.0f,		0.0f, -1.0f, 0.0f,
-		0.5f, -0.02f, 0.5f,     5.0f, 0.0f,		0.0f, -1.0f, 0.0f,
-
-		// Top
-		-0.5f, 0.02f, 0.5f,	    0.0f, 0.0f,		0.0f, 1.0f, 0.0f,
-		-0.5f, 0.02f, -0.5f,    0.0f, 5.0f,		0.0f, 1.0f, 0.0f,
-		0.5f, 0.02f, -0.5f,     5.0f, 5.0f,		0.0f, 1.0f, 0.0f,
-		0.5f, 0.02f, 0.5f,      5.0f, 0.0f,		0.0f, 1.0f, 0.0f
-	};
-
-	GLuint floorIndices[]{
-		// Bottom
-		0, 1, 2,
-		0, 2, 3,
-
-		// Top
-		4, 5, 6,
-		4, 6, 7,
-
-		// Front
-		0, 3, 4,
-		3, 4, 7,
-
-		// Back
-		1, 2, 5,
-		2, 5, 6,
-
-		// Left
-		0, 1, 4,
-		1, 4, 5,
-
-		// Right
-		3, 2, 7,
-		2, 7, 6
-	};
-
-	GLfloat lightVertices[]{
-		-0.1f, -0.1f,  0.1f,
-		-0.1f, -0.1f, -0.1f,
-		 0.1f, -0.1f, -0.1f,
-		 0.1f, -0.1f,  0.1f,
-		-0.1f,  0.1f,  0.1f,
-		-0.1f,  0.1f, -0.1f,
-		 0.1f,  0.1f, -0.1f,
-		 0.1f,  0.1f,  0.1f
-	};
-
-	GLuint lightIndices[]{
-		0, 1, 2,
-		0, 2, 3,
-		0, 4, 7,
-		0, 7, 3,
-		3, 7, 6,
-		3, 6, 2,
-		2, 6, 5,
-		2, 5, 1,
-		1, 5, 4,
-		1, 4, 0,
-		4, 5, 6,
-		4, 6, 7
-	};
-
-	GLenum polygonMode{ GL_FILL };
-
-	bool falling{ false };
-	bool freecam{ false };
-
-	float floorHalfExtent{ (0.5f * 5.0f) + 0.06f };
-
-	GLFWwindow* window{ glfwCreateWindow(wWidth, wHeight, "3D Testing", NULL, NULL) };
-	if (window == NULL)
-	{
-		std::cerr << "Failed to create GLFW window.\n";
-
-		glfwTerminate();
-		return 1;
-	}
-	glfwMakeContextCurrent(window);
-
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-	{
-		std::cerr << "Failed to init GLAD.\n";
-
-		glfwDestroyWindow(window);
-		glfwTerminate();
-		return 1;
-	}
-
-	glViewport(0, 0, wWidth, wHeight);
-
-	objl::Loader tableLoader;
-	if (!tableLoader.LoadFile("Assets/table.obj"))
-	{
-		std::cerr << "Failed to load table.obj!\n";
-	}
-
-	VAO tableVAO;
-	VBO tableVBO;
-	EBO tableEBO;
-	size_t tableIndexCount{ 0 };
-
-	if (!tableLoader.LoadedMeshes.empty())
-	{
-		objl::Mesh& mesh{ tableLoader.LoadedMeshes[0] }; // Table is in 1 mesh
-		tableIndexCount = mesh.Indices.size();
-
-		std::vector<GLfloat> verts;
-		verts.reserve(mesh.Vertices.size() * 5);
-
-		for (objl::Vertex& v : mesh.Vertices)
-		{
-			verts.push_back(v.Position.X);
-			verts.push_back(v.Position.Y);
-			verts.push_back(v.Position.Z);
-
-			verts.push_back(v.Position.X * 2.5f);
-			verts.push_back(v.Position.Z * 2.5f);
-
-			verts.push_back(v.Normal.X);
-			verts.push_back(v.Normal.Y);
-			verts.push_back(v.Normal.Z);
-		}
-
-		tableVAO.Bind();
-		tableVBO.setup(verts.data(), verts.size() * sizeof(GLfloat));
-		tableEBO.setup(mesh.Indices.data(), mesh.Indices.size() * sizeof(GLuint));
-
-		tableVAO.LinkAttrib(tableVBO, 0, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)0);
-		tableVAO.LinkAttrib(tableVBO, 1, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(float)));
-		tableVAO.LinkAttrib(tableVBO, 2, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(5 * sizeof(float)));
-
-		tableVAO.Unbind();
-		tableVBO.Unbind();
-		tableEBO.Unbind();
-	}
-
-	objl::Loader chairLoader;
-	if (!chairLoader.LoadFile("Assets/chair.obj"))
-	{
-		std::cerr << "Failed to load chair.obj!\n";
-	}
-
-	VAO chairVAO;
-	VBO chairVBO;
-	EBO chairEBO;
-	size_t chairIndexCount{ 0 };
-
-	if (!chairLoader.LoadedMeshes.empty())
-	{
-		objl::Mesh& mesh{ chairLoader.LoadedMeshes[0] }; // Chair is in 1 mesh
-		chairIndexCount = mesh.Indices.size();
-
-		std::vector<GLfloat> verts;
-		verts.reserve(mesh.Vertices.size() * 5);
-
-		for (objl::Vertex& v : mesh.Vertices)
-		{
-			verts.push_back(v.Position.X);
-			verts.push_back(v.Position.Y);
-			verts.push_back(v.Position.Z);
-
-			verts.push_back(v.Position.X * 2.5f);
-			verts.push_back(v.Position.Z * 2.5f);
-
-			verts.push_back(v.Normal.X);
-			verts.push_back(v.Normal.Y);
-			verts.push_back(v.Normal.Z);
-		}
-
-		chairVAO.Bind();
-		chairVBO.setup(verts.data(), verts.size() * sizeof(GLfloat));
-		chairEBO.setup(mesh.Indices.data(), mesh.Indices.size() * sizeof(GLuint));
-
-		chairVAO.LinkAttrib(chairVBO, 0, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)0);
-		chairVAO.LinkAttrib(chairVBO, 1, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(float)));
-		chairVAO.LinkAttrib(chairVBO, 2, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(5 * sizeof(float)));
-
-		chairVAO.Unbind();
-		chairVBO.Unbind();
-		chairEBO.Unbind();
-	}
-
-	objl::Loader carpetLoader;
-	if (!carpetLoader.LoadFile("Assets/carpet.obj"))
-	{
-		std::cerr << "Failed to load carpet.obj!\n";
-	}
-
-	VAO carpetVAO;
-	VBO carpetVBO;
-	EBO carpetEBO;
-	size_t carpetIndexCount{ 0 };
-
-	if (!carpetLoader.LoadedMeshes.empty())
-	{
-		objl::Mesh& mesh{ carpetLoader.LoadedMeshes[0] }; // Carpet is in 1 mesh
-		carpetIndexCount = mesh.Indices.size();
-
-		std::vector<GLfloat> verts;
-		verts.reserve(mesh.Vertices.size() * 5);
-
-		for (objl::Vertex& v : mesh.Vertices)
-		{
-			verts.push_back(v.Position.X);
-			verts.push_back(v.Position.Y);
-			verts.push_back(v.Position.Z);
-
-			verts.push_back(v.Position.X * 0.6f);
-			verts.push_back(v.Position.Z * 0.6f);
-
-			verts.push_back(v.Normal.X);
-			verts.push_back(v.Normal.Y);
-			verts.push_back(v.Normal.Z);
-		}
-
-		carpetVAO.Bind();
-		carpetVBO.setup(verts.data(), verts.size() * sizeof(GLfloat));
-		carpetEBO.setup(mesh.Indices.data(), mesh.Indices.size() * sizeof(GLuint));
-
-		carpetVAO.LinkAttrib(carpetVBO, 0, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)0);
-		carpetVAO.LinkAttrib(carpetVBO, 1, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(float)));
-		carpetVAO.LinkAttrib(carpetVBO, 2, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(5 * sizeof(float)));
-
-		carpetVAO.Unbind();
-		carpetVBO.Unbind();
-		carpetEBO.Unbind();
-	}
-
-	Shader crosshairShader(get_file_contents("Shaders/crosshair.vert").c_str(), get_file_contents("Shaders/crosshair.frag").c_str());
-	Shader floorShader(get_file_contents("Shaders/floor.vert").c_str(), get_file_contents("Shaders/floor.frag").c_str());
-	Shader tableShader{ get_file_contents("Shaders/table.vert").c_str(), get_file_contents("Shaders/table.frag").c_str() };
-	Shader chairShader{ get_file_contents("Shaders/chair.vert").c_str(), get_file_contents("Shaders/chair.frag").c_str() };
-	Shader carpetShader{ get_file_contents("Shaders/carpet.vert").c_str(), get_file_contents("Shaders/carpet.frag").c_str() };
-	Shader lightShader{ get_file_contents("Shaders/light.vert").c_str(), get_file_contents("Shaders/light.frag").c_str() };
-
-	VAO crosshairVAO;
-	crosshairVAO.Bind();
-
-	VBO crosshairVBO(crosshairVertices, sizeof(crosshairVertices));
-	EBO crosshairEBO(crosshairIndices, sizeof(crosshairIndices));
-
-	crosshairVAO.LinkAttrib(crosshairVBO, 0, 3, GL_FLOAT, 3 * sizeof(GLfloat), (void*)0);
-	crosshairVAO.Unbind();
-	crosshairVBO.Unbind();
-	crosshairEBO.Unbind();
-
-	VAO floorVAO;
-	floorVAO.Bind();
-
-	VBO floorVBO(floorVertices, sizeof(floorVertices));
-	EBO floorEBO(floorIndices, sizeof(floorIndices));
-
-	floorVAO.LinkAttrib(floorVBO, 0, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)0);
-	floorVAO.LinkAttrib(floorVBO, 1, 2, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
-	floorVAO.LinkAttrib(floorVBO, 2, 3, GL_FLOAT, 8 * sizeof(GLfloat), (void*)(5 * sizeof(GLfloat)));
-	floorVAO.Unbind();
-	floorVBO.Unbind();
-	floorEBO.Unbind();
-
-	VAO lightVAO;
-	lightVAO.Bind();
-
-	VBO lightVBO(lightVertices, sizeof(lightVertices));
-	EBO lightEBO(lightIndices, sizeof(lightIndices));
-
-	lightVAO.LinkAttrib(lightVBO, 0, 3, GL_FLOAT, 3 * sizeof(GLfloat), (void*)0);
-	lightVAO.Unbind();
-	lightVBO.Unbind();
-	lightEBO.Unbind();
-
-	//glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
-	glClearColor(pow(0.07f, gamma), pow(0.13f, gamma), pow(0.17f, gamma), 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
-
-	glfwSwapBuffers(window);
-
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_MULTISAMPLE);
-	glEnable(GL_FRAMEBUFFER_SRGB);
-
-	glm::vec4 lightColor{ glm::vec4(1.0f, 1.0f, 1.0f, 1.0f) };
-
-	glm::vec3 lightPos{ glm::vec3(2.0f, 1.2f, 0.0f) };
-	glm::mat4 lightModel{ glm::mat4(1.0f) };
-	lightModel = glm::translate(lightModel, lightPos);
-
-	glm::vec3 floorPos{ glm::vec3(0.0f, 0.0f, 0.0f) };
-	glm::mat4 floorModel{ glm::mat4(1.0f) };
-	floorModel = glm::translate(floorModel, floorPos);
-	floorModel = glm::scale(floorModel, glm::vec3(5.0f, 1.0f, 5.0f));
-
-	glm::vec3 tablePos{ glm::vec3(2.0f, 0.0f, 0.0f) };
-	glm::mat4 tableModel{ glm::mat4(1.0f) };
-	tableModel = glm::translate(tableModel, tablePos);
-	tableModel = glm::scale(tableModel, glm::vec3(0.2f, 0.2f, 0.2f));
-
-	glm::vec3 chairPos{ glm::vec3(1.5f, 0.0f, 0.0f) };
-	glm::mat4 chairModel{ glm::mat4(1.0f) };
-	chairModel = glm::translate(chairModel, chairPos);
-	chairModel = glm::scale(chairModel, glm::vec3(0.16f, 0.16f, 0.16f));
-
-	glm::vec3 carpetPos{ glm::vec3(0.0f, 0.02f, 0.0f) };
-	glm::mat4 carpetModel{ glm::mat4(1.0f) };
-	carpetModel = glm::translate(carpetModel, carpetPos);
-	carpetModel = glm::scale(carpetModel, glm::vec3(0.2f, 0.16f, 0.2f));
-
-	Texture floorWoodTex("Assets/wood tex3.png", GL_TEXTURE_2D, 0, GL_LINEAR, GL_MIRRORED_REPEAT);
-	floorWoodTex.texUnit(floorShader, "tex0", 0);
-
-	Texture tableWoodTex("Assets/wood tex.png", GL_TEXTURE_2D, 0, GL_LINEAR, GL_MIRRORED_REPEAT);
-	tableWoodTex.texUnit(tableShader, "tex0", 0);
-
-	Texture chairWoodTex("Assets/wood tex2.png", GL_TEXTURE_2D, 0, GL_LINEAR, GL_MIRRORED_REPEAT);
-	chairWoodTex.texUnit(chairShader, "tex0", 0);
-
-	Texture carpetTex("Assets/carpet texture.png", GL_TEXTURE_2D, 0, GL_LINEAR, GL_MIRRORED_REPEAT);
-	carpetTex.texUnit(carpetShader, "tex0", 0);
-
-	Texture floorWoodTexSpec("Assets/wood tex3 specular.png", GL_TEXTURE_2D, 1, GL_LINEAR, GL_MIRRORED_REPEAT);
-	floorWoodTexSpec.texUnit(floorShader, "tex1", 1);
-
-	Texture tableWoodTexSpec("Assets/wood tex specular.png", GL_TEXTURE_2D, 1, GL_LINEAR, GL_MIRRORED_REPEAT);
-	tableWoodTexSpec.texUnit(tableShader, "tex1", 1);
-
-	Texture chairWoodTexSpec("Assets/wood tex2 specular.png", GL_TEXTURE_2D, 1, GL_LINEAR, GL_MIRRORED_REPEAT);
-	chairWoodTexSpec.texUnit(chairShader, "tex1", 1);
-
-	Texture carpetTexSpec("Assets/carpet texture specular.png", GL_TEXTURE_2D, 1, GL_LINEAR, GL_MIRRORED_REPEAT);
-	carpetTexSpec.texUnit(carpetShader, "tex1", 1);
-
-	Camera cam(wWidth, wHeight, glm::vec3(0.0f, 1.0f, 0.0f));
-	cam.speed = 0.02f;
-
-	double prevTime{ 0.0 };
-	double crntTime{ 0.0 };
-	double timeDiff;
-	unsigned int fpsCounter{ 0 };
-
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGuiIO& imIO{ ImGui::GetIO() }; (void)imIO;
-
-	ImGui::StyleColorsDark();
-
-	ImGui_ImplGlfw_InitForOpenGL(window, true);
-	ImGui_ImplOpenGL3_Init("#version 330");
-
-	while (!glfwWindowShouldClose(window))
-	{
-		crntTime = glfwGetTime();
-		timeDiff = crntTime - prevTime;
-		fpsCounter++;
-		if (timeDiff >= 1.0 / 30.0)
-		{
-			std::string fps{ std::to_string(static_cast<int>((1.0 / timeDiff) * fpsCounter)) };
-			std::string newTitle{ "3D Testing - " + fps + "FPS" };
-
-			glfwSetWindowTitle(window, newTitle.c_str());
-			prevTime = crntTime;
-			fpsCounter = 0;
-		}
-
-		glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
-
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
-		ImGui::NewFrame();
-
-		ImGui::Begin("Debug Menu");
-		if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, GL_TRUE);
-
-		if (glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS) cam.firstClick = true;
-
-		if (!ImGui::IsWindowFocused())
-		{
-			if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS && !falling)
-			{
-				cam.speed = 0.04f;
-			}
-			else if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS && !falling)
-			{
-				cam.speed = 0.008f;
-				//cam.Position.y = 0.5f;
-			}
-			else
-			{
-				cam.speed = 0.02f;
-				//cam.Position.y = 1.0f;
-			}
-		}
-
-		if (!falling)
-		{
-			if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS && (!ImGui::IsWindowFocused()))
-			{
-				if (!freecam) cam.Position.y = 0.5f;
-			}
-			else
-			{
-				if (!freecam) cam.Position.y = 1.0f;
-			}
-		}
-		else
-		{
-			cam.Position.y -= 0.04f;
-		}
-
-		if ((cam.Position.x < -floorHalfExtent || cam.Position.x > floorHalfExtent ||
-			cam.Position.z < -floorHalfExtent || cam.Position.z > floorHalfExtent) && !falling && !freecam)
-		{
-			falling = true;
-		}
-
-		glClearColor(pow(0.07f, gamma), pow(0.13f, gamma), pow(0.17f, gamma), 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		if (!ImGui::IsWindowFocused())
-		{
-			(!freecam) ? cam.InputsGame(window, !falling, !(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS)) : cam.Inputs(window, !(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS));
-		}
-		else
-		{
-			cam.firstClick = true;
-		}
-		cam.UpdateMatrix(45.0f, 0.1f, 100.0f);
-
-		// Draw light cube
-
-		lightShader.Activate();
-		lightVAO.Bind();
-
-		cam.Matrix(lightShader, "camMatrix");
-
-		glUniformMatrix4fv(lightShader.GetUniformLoc("lightModel"), 1, GL_FALSE, glm::value_ptr(lightModel));
-
-		glDrawElements(GL_TRIANGLES, sizeof(lightIndices) / sizeof(int), GL_UNSIGNED_INT, 0);
-
-		// Draw floor
-
-		floorShader.Activate();
-		floorWoodTex.Bind();
-		floorWoodTexSpec.Bind();
-		floorVAO.Bind();
-
-		cam.Matrix(floorShader, "camMatrix");
-
-		glUniformMatrix4fv(floorShader.GetUniformLoc("floorModel"), 1, GL_FALSE, glm::value_ptr(floorModel));
-		glUniform4f(floorShader.GetUniformLoc("lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-		glUniform3f(floorShader.GetUniformLoc("lightPos"), lightPos.x, lightPos.y, lightPos.z);
-		glUniform3f(floorShader.GetUniformLoc("camPos"), cam.Position.x, cam.Position.y, cam.Position.z);
-
-		glDrawElements(GL_TRIANGLES, sizeof(floorIndices) / sizeof(int), GL_UNSIGNED_INT, 0);
-
-		lightShader.Activate();
-		glUniformMatrix4fv(lightShader.GetUniformLoc("lightModel"), 1, GL_FALSE, glm::value_ptr(lightModel));
-		glUniform4f(lightShader.GetUniformLoc("lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-
-		// Draw table
-
-		tableShader.Activate();
-		tableWoodTex.Bind();
-		tableWoodTexSpec.Bind();
-		tableVAO.Bind();
-
-		cam.Matrix(tableShader, "camMatrix");
-
-		glUniformMatrix4fv(tableShader.GetUniformLoc("tableModel"), 1, GL_FALSE, glm::value_ptr(tableModel));
-		glUniform4f(tableShader.GetUniformLoc("lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-		glUniform3f(tableShader.GetUniformLoc("lightPos"), lightPos.x, lightPos.y, lightPos.z);
-		glUniform3f(tableShader.GetUniformLoc("camPos"), cam.Position.x, cam.Position.y, cam.Position.z);
-
-		glDrawElements(GL_TRIANGLES, (GLsizei)tableIndexCount, GL_UNSIGNED_INT, 0);
-
-		// Draw chairs
-
-		chairShader.Activate();
-		chairWoodTex.Bind();
-		chairWoodTexSpec.Bind();
-		chairVAO.Bind();
-
-		cam.Matrix(chairShader, "camMatrix");
-
-		glUniformMatrix4fv(chairShader.GetUniformLoc("chairModel"), 1, GL_FALSE, glm::value_ptr(chairModel));
-		glUniform4f(chairShader.GetUniformLoc("lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-		glUniform3f(chairShader.GetUniformLoc("lightPos"), lightPos.x, lightPos.y, lightPos.z);
-		glUniform3f(chairShader.GetUniformLoc("camPos"), cam.Position.x, cam.Position.y, cam.Position.z);
-		glUniformMatrix3fv(chairShader.GetUniformLoc("normalMatrix"), 1, GL_FALSE, glm::value_ptr(glm::transpose(glm::inverse(glm::mat3(chairModel)))));
-
-		glDrawElements(GL_TRIANGLES, (GLsizeiptr)chairIndexCount, GL_UNSIGNED_INT, 0);
-
-		chairModel = glm::mat4(1.0f);
-		chairPos = glm::vec3(2.0f, 0.0f, 0.5f);
-		chairModel = glm::translate(chairModel, chairPos);
-		chairModel = glm::scale(chairModel, glm::vec3(0.16f, 0.16f, 0.16f));
-		chairModel = glm::rotate(chairModel, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-		glUniformMatrix4fv(chairShader.GetUniformLoc("chairModel"), 1, GL_FALSE, glm::value_ptr(chairModel));
-		glUniformMatrix3fv(chairShader.GetUniformLoc("normalMatrix"), 1, GL_FALSE, glm::value_ptr(glm::transpose(glm::inverse(glm::mat3(chairModel)))));
-
-		glDrawElements(GL_TRIANGLES, (GLsizeiptr)chairIndexCount, GL_UNSIGNED_INT, 0);
-
-		chairModel = glm::mat4(1.0f);
-		chairPos = glm::vec3(2.0f, 0.0f, -0.5f);
-		chairModel = glm::translate(chairModel, chairPos);
-		chairModel = glm::scale(chairModel, glm::vec3(0.16f, 0.16f, 0.16f));
-		chairModel = glm::rotate(chairModel, glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-		glUniformMatrix4fv(chairShader.GetUniformLoc("chairModel"), 1, GL_FALSE, glm::value_ptr(chairModel));
-		glUniformMatrix3fv(chairShader.GetUniformLoc("normalMatrix"), 1, GL_FALSE, glm::value_ptr(glm::transpose(glm::inverse(glm::mat3(chairModel)))));
-
-		glDrawElements(GL_TRIANGLES, (GLsizeiptr)chairIndexCount, GL_UNSIGNED_INT, 0);
-
-		chairModel = glm::mat4(1.0f);
-		chairPos = glm::vec3(1.5f, 0.0f, 0.0f);
-		chairModel = glm::translate(chairModel, chairPos);
-		chairModel = glm::scale(chairModel, glm::vec3(0.16f, 0.16f, 0.16f));
-
-		// Draw carpet
-
-		carpetShader.Activate();
-		carpetTex.Bind();
-		carpetTexSpec.Bind();
-		carpetVAO.Bind();
-
-		cam.Matrix(carpetShader, "camMatrix");
-
-		glUniformMatrix4fv(carpetShader.GetUniformLoc("carpetModel"), 1, GL_FALSE, glm::value_ptr(carpetModel));
-		glUniform4f(carpetShader.GetUniformLoc("lightColor"), lightColor.x, lightColor.y, lightColor.z, lightColor.w);
-		glUniform3f(carpetShader.GetUniformLoc("lightPos"), lightPos.x, lightPos.y, lightPos.z);
-		glUniform3f(carpetShader.GetUniformLoc("camPos"), cam.Position.x, cam.Position.y, cam.Position.z);
-
-		glDrawElements(GL_TRIANGLES, (GLsizeiptr)carpetIndexCount, GL_UNSIGNED_INT, 0);
-
-		// Draw crosshair
-
-		crosshairShader.Activate();
-		crosshairVAO.Bind();
-
-		glDrawElements(GL_TRIANGLES, sizeof(crosshairIndices) / sizeof(int), GL_UNSIGNED_INT, 0);
-
-
-		ImGui::SetWindowSize(ImVec2{ 250, 300 });
-
-		ImGui::Text("            -General-");
-
-		if (ImGui::Button("Reset"))
-		{
-			falling = false;
-
-			cam.Position = glm::vec3(0.0f, 1.0f, 0.0f);
-			cam.Orientation = glm::vec3(0.0f, 0.0f, -1.0f);
-			cam.Up = glm::vec3(0.0f, 1.0f, 0.0f);
-		}
-
-		ImGui::Checkbox("Free Camera", &freecam);
-
-		ImGui::Text("             -Draw-");
-
-		if (ImGui::Button("Toggle Wireframe Mode"))
-		{
-			polygonMode = (polygonMode == GL_LINE) ? GL_FILL : GL_LINE;
-		}
-
-		ImGui::End();
-
-		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-		glfwSwapBuffers(window);
-		glfwPollEvents();
-	}
-
-	ImGui_ImplOpenGL3_Shutdown();
-	ImGui_ImplGlfw_Shutdown();
-	ImGui::DestroyContext();
-
-	crosshairVAO.Delete();
-	crosshairVBO.Delete();
-	crosshairEBO.Delete();
-	crosshairShader.Delete();
-
-	floorVAO.Delete();
-	floorVBO.Delete();
-	floorEBO.Delete();
-	floorShader.Delete();
-	floorWoodTex.Delete();
-	floorWoodTexSpec.Delete();
-
-	tableVAO.Delete();
-	tableVBO.Delete();
-	tableEBO.Delete();
-	tableShader.Delete();
-	tableWoodTex.Delete();
-	tableWoodTexSpec.Delete();
-
-	chairVAO.Delete();
-	chairVBO.Delete();
-	chairEBO.Delete();
-	chairShader.Delete();
-	chairWoodTex.Delete();
-	chairWoodTexSpec.Delete();
-
-	carpetVAO.Delete();
-	carpetVBO.Delete();
-	carpetEBO.Delete();
-	carpetShader.Delete();
-	carpetTex.Delete();
-	carpetTexSpec.Delete();
-
-	lightVAO.Delete();
-	lightVBO.Delete();
-	lightEBO.Delete();
-	lightShader.Delete();
-
-	glfwDestroyWindow(window);
-	glfwTerminate();
-	return 0;
+#define STB_IMAGE_IMPLEMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "glad/glad.h"
+#include "GLFW/glfw3.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_impl_glfw.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+#include "Inc/Camera.h"
+#include "Inc/DrawCommandList.h"
+#include "Inc/GeometryPool.h"
+#include "Inc/GLStateCache.h"
+#include "Inc/InstanceBuffer.h"
+#include "Inc/Texture.h"
+#include "Inc/TextureArray.h"
+#include "Inc/TextureCache.h"
+#include "Inc/ThreadPool.h"
+#include "Inc/OBJ_Loader.hpp"
+#include "Inc/MeshCache.h"
+#include "Inc/VertexFormat.h"
+#include "Inc/MeshletBuilder.h"
+#include "Inc/RenderQueue.h"
+
+#include "Inc/Shader.h"
+#include "Inc/ShaderPermutations.h"
+#include "Inc/UBO.h"
+#include "Inc/VAO.h"
+
+constexpr unsigned int wWidth{ 800 };
+constexpr unsigned int wHeight{ 800 };
+
+constexpr float gamma{ 2.2f };
+
+// TODO: Add footstep sound.
+// TODO: Add camera movement when walking.
+// TODO: Add collision.
+// TODO: Add walls and roof.
+// TODO: Make the light cube a light bulb.
+int main()
+{
+	std::chrono::steady_clock::time_point startupTime{ std::chrono::steady_clock::now() };
+
+	glfwInit();
+
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_SAMPLES, 8);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+
+	GLfloat crosshairVertices[]{
+		// Left Triangle
+		-0.0025f,  0.0025f, 0.0f,
+		 0.0025f,  0.0025f, 0.0f,
+		-0.0025f, -0.0025f, 0.0f,
+
+		// Right Triangle
+		-0.0025f, -0.0025f, 0.0f,
+		 0.0025f,  0.0025f, 0.0f,
+		 0.0025f, -0.0025f, 0.0f
+	};
+
+	GLuint crosshairIndices[]{
+		// Left Triangle
+		0, 1, 2,
+
+		// Right Triangle
+		3, 4, 5
+	};
+
+	GLfloat floorVertices[]{
+		//   COORDINATES     |   TEXTURE    |       NORMALS    //
+		// Bottom
+		-0.5f, -0.02f, 0.5f,	0.0f, 0.0f,		0.0f, -1.0f, 0.0f,
+		-0.5f, -0.02f, -0.5f,   0.0f, 5.0f,		0.0f, -1.0f, 0.0f,
+		0.5f, -0.02f, -0.5f,    5.0f, 5.0f,		0.0f, -1.0f, 0.0f,
+		0.5f, -0.02f, 0.5f,     5.0f, 0.0f,		0.0f, -1.0f, 0.0f,
+
+		// Top
+		-0.5f, 0.02f, 0.5f,	    0.0f, 0.0f,		0.0f, 1.0f, 0.0f,
+		-0.5f, 0.02f, -0.5f,    0.0f, 5.0f,		0.0f, 1.0f, 0.0f,
+		0.5f, 0.02f, -0.5f,     5.0f, 5.0f,		0.0f, 1.0f, 0.0f,
+		0.5f, 0.02f, 0.5f,      5.0f, 0.0f,		0.0f, 1.0f, 0.0f
+	};
+
+	GLuint floorIndices[]{
+		// Bottom
+		0, 1, 2,
+		0, 2, 3,
+
+		// Top
+		4, 5, 6,
+		4, 6, 7,
+
+		// Front
+		0, 3, 4,
+		3, 4, 7,
+
+		// Back
+		1, 2, 5,
+		2, 5, 6,
+
+		// Left
+		0, 1, 4,
+		1, 4, 5,
+
+		// Right
+		3, 2, 7,
+		2, 7, 6
+	};
+
+	GLfloat lightVertices[]{
+		-0.1f, -0.1f,  0.1f,
+		-0.1f, -0.1f, -0.1f,
+		 0.1f, -0.1f, -0.1f,
+		 0.1f, -0.1f,  0.1f,
+		-0.1f,  0.1f,  0.1f,
+		-0.1f,  0.1f, -0.1f,
+		 0.1f,  0.1f, -0.1f,
+		 0.1f,  0.1f,  0.1f
+	};
+
+	GLuint lightIndices[]{
+		0, 1, 2,
+		0, 2, 3,
+		0, 4, 7,
+		0, 7, 3,
+		3, 7, 6,
+		3, 6, 2,
+		2, 6, 5,
+		2, 5, 1,
+		1, 5, 4,
+		1, 4, 0,
+		4, 5, 6,
+		4, 6, 7
+	};
+
+	GLenum polygonMode{ GL_FILL };
+
+	bool falling{ false };
+	bool freecam{ false };
+
+	bool useLods{ true };
+	float lodPixelError{ 1.0f };
+	unsigned int tableLod{ 0 };
+	std::vector<unsigned int> chairLods;
+
+	bool useMeshlets{ true };
+	MeshletBuilder::CullStats cullStats;
+	std::vector<std::pair<uint32_t, uint32_t>> drawRanges;
+
+	bool hotReload{ true };
+	float reloadBudgetMs{ 2.0f };
+
+	float floorHalfExtent{ (0.5f * 5.0f) + 0.06f };
+
+	GLFWwindow* window{ glfwCreateWindow(wWidth, wHeight, "3D Testing", NULL, NULL) };
+	if (window == NULL)
+	{
+		std::cerr << "Failed to create GLFW window.\n";
+
+		glfwTerminate();
+		return 1;
+	}
+	glfwMakeContextCurrent(window);
+
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cerr << "Failed to init GLAD.\n";
+
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		return 1;
+	}
+
+	glViewport(0, 0, wWidth, wHeight);
+
+	const VertexFormat meshFormat{ VertexFormat::Compact() };
+
+	// Every mesh lives in one vertex and one index buffer, drawn from one VAO per format.
+	GeometryPool geometry(1024 * 1024, 256 * 1024);
+
+	// A model's vertex and index blocks go in as one mesh, empty if it failed to load. The
+	// cache bakes the vertices in meshFormat, so the report only prints when it bakes.
+	auto addModel = [&](const char* name, MeshCache& model, glm::mat4& decode)
+	{
+		if (model.Meshes.empty())
+			return geometry.Add(meshFormat, nullptr, 0, nullptr, 0);
+
+		if (!model.WarmStart)
+			PrintVertexFormatReport(name, model.Vertices, model.VertexCount);
+		decode = model.EncodedDecode;
+		return geometry.Add(meshFormat, model.EncodedVertices, model.VertexCount, model.Indices, model.IndexCount);
+	};
+
+	MeshCache tableMesh;
+	tableMesh.LodRatios = { 0.5f, 0.25f, 0.1f };
+	tableMesh.BuildMeshlets = true;
+	tableMesh.Encoding = meshFormat;
+	if (!tableMesh.Load("Assets/table.obj", 2.5f))
+	{
+		std::cerr << "Failed to load table.obj!\n";
+	}
+
+	MeshCache::Entry tableEntry{};
+	std::vector<MeshletBuilder::Meshlet> tableMeshlets;
+	glm::mat4 tableDecode{ glm::mat4(1.0f) };
+
+	if (!tableMesh.Meshes.empty())
+	{
+		tableMeshlets.assign(tableMesh.Meshlets, tableMesh.Meshlets + tableMesh.MeshletCount);
+		tableEntry = tableMesh.Meshes[0]; // Table is in 1 mesh
+	}
+	GeometryPool::Handle tableGeometry{ addModel("table.obj", tableMesh, tableDecode) };
+	tableMesh.Release();
+
+	MeshCache chairMesh;
+	chairMesh.LodRatios = { 0.5f, 0.25f, 0.1f };
+	chairMesh.BuildMeshlets = true;
+	chairMesh.Encoding = meshFormat;
+	if (!chairMesh.Load("Assets/chair.obj", 2.5f))
+	{
+		std::cerr << "Failed to load chair.obj!\n";
+	}
+
+	MeshCache::Entry chairEntry{};
+	std::vector<MeshletBuilder::Meshlet> chairMeshlets;
+	glm::mat4 chairDecode{ glm::mat4(1.0f) };
+
+	if (!chairMesh.Meshes.empty())
+	{
+		chairMeshlets.assign(chairMesh.Meshlets, chairMesh.Meshlets + chairMesh.MeshletCount);
+		chairEntry = chairMesh.Meshes[0]; // Chair is in 1 mesh
+	}
+	GeometryPool::Handle chairGeometry{ addModel("chair.obj", chairMesh, chairDecode) };
+	chairMesh.Release();
+
+	MeshCache carpetMesh;
+	carpetMesh.Encoding = meshFormat;
+	if (!carpetMesh.Load("Assets/carpet.obj", 0.6f))
+	{
+		std::cerr << "Failed to load carpet.obj!\n";
+	}
+
+	size_t carpetIndexCount{ 0 };
+	glm::mat4 carpetDecode{ glm::mat4(1.0f) };
+
+	if (!carpetMesh.Meshes.empty())
+	{
+		carpetIndexCount = carpetMesh.Meshes[0].IndexCount; // Carpet is in 1 mesh
+	}
+	GeometryPool::Handle carpetGeometry{ addModel("carpet.obj", carpetMesh, carpetDecode) };
+	carpetMesh.Release();
+
+	// Lit objects share Shaders/lit.*, specialized by the features each one needs. The
+	// table and carpet ask for the same ones, so they get the same program.
+	std::vector<std::string> meshFeatures;
+	if (meshFormat.OctahedralNormals()) meshFeatures.push_back("OCT_NORMALS");
+	std::vector<std::string> chairFeatures{ meshFeatures };
+	chairFeatures.push_back("NORMAL_MATRIX");
+
+	// The floor, table and carpet are drawn through DrawCommandLists, so they take their
+	// matrices and layers from an InstanceBuffer like the instanced chairs.
+	auto instanced = [](std::vector<std::string> features)
+	{
+		features.push_back("INSTANCED");
+		return features;
+	};
+
+	ShaderPermutations shaders;
+	Shader& crosshairShader{ shaders.Get("Shaders/crosshair.vert", "Shaders/crosshair.frag") };
+	Shader& lightShader{ shaders.Get("Shaders/light.vert", "Shaders/light.frag") };
+	Shader& floorShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", instanced({})) };
+	Shader& tableShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", instanced(meshFeatures)) };
+	Shader& carpetShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", instanced(meshFeatures)) };
+	Shader& chairShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", chairFeatures) };
+
+	// The same programs reading every map from one TextureArray.
+	auto packed = [](std::vector<std::string> features)
+	{
+		features.push_back("TEXTURE_ARRAY");
+		return features;
+	};
+	Shader& floorPackedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", packed(instanced({}))) };
+	Shader& tablePackedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", packed(instanced(meshFeatures))) };
+	Shader& carpetPackedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", packed(instanced(meshFeatures))) };
+	Shader& chairPackedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", packed(chairFeatures)) };
+
+	// Chairs drawn as instances take their matrices from an InstanceBuffer.
+	std::vector<std::string> chairInstancedFeatures{ instanced(chairFeatures) };
+	Shader& chairInstancedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", chairInstancedFeatures) };
+	Shader& chairInstancedPackedShader{ shaders.Get("Shaders/lit.vert", "Shaders/lit.frag", packed(chairInstancedFeatures)) };
+
+	std::cout << "- Shaders: " << (shaders.CacheHits() == shaders.Count() ? "warm" : "cold") << " start " << shaders.LoadSeconds() * 1000.0
+		<< " ms (" << shaders.CacheHits() << "/" << shaders.Count() << " programs from the binary cache)\n";
+
+	// The floor is in the 8 float layout already. The crosshair and light only have
+	// positions, so they get the same layout with the rest zeroed and share its VAO.
+	auto positionsOnly = [](const GLfloat* positions, size_t count)
+	{
+		std::vector<GLfloat> vertices(count * MeshCache::FloatsPerVertex, 0.0f);
+		for (size_t i{ 0 }; i < count; i++)
+			std::copy(positions + i * 3, positions + i * 3 + 3, vertices.begin() + i * MeshCache::FloatsPerVertex);
+		return vertices;
+	};
+
+	const VertexFormat fullFormat{ VertexFormat::Full() };
+
+	std::vector<GLfloat> crosshairFull{ positionsOnly(crosshairVertices, sizeof(crosshairVertices) / (3 * sizeof(GLfloat))) };
+	GeometryPool::Handle crosshairGeometry{ geometry.Add(fullFormat, crosshairFull.data(), crosshairFull.size() / MeshCache::FloatsPerVertex, crosshairIndices, sizeof(crosshairIndices) / sizeof(GLuint)) };
+
+	GeometryPool::Handle floorGeometry{ geometry.Add(fullFormat, floorVertices, sizeof(floorVertices) / (8 * sizeof(GLfloat)), floorIndices, sizeof(floorIndices) / sizeof(GLuint)) };
+
+	std::vector<GLfloat> lightFull{ positionsOnly(lightVertices, sizeof(lightVertices) / (3 * sizeof(GLfloat))) };
+	GeometryPool::Handle lightGeometry{ geometry.Add(fullFormat, lightFull.data(), lightFull.size() / MeshCache::FloatsPerVertex, lightIndices, sizeof(lightIndices) / sizeof(GLuint)) };
+
+	VAO& fullVAO{ geometry.VertexArray(fullFormat) };
+	VAO& meshVAO{ geometry.VertexArray(meshFormat) };
+	// The instanced chairs add their InstanceBuffer attributes to a VAO of their own, as does
+	// every DrawCommandList.
+	VAO& chairInstancedVAO{ geometry.NewVertexArray(meshFormat) };
+	VAO& chairMultiDrawVAO{ geometry.NewVertexArray(meshFormat) };
+	VAO& floorVAO{ geometry.NewVertexArray(fullFormat) };
+	VAO& tableVAO{ geometry.NewVertexArray(meshFormat) };
+	VAO& carpetVAO{ geometry.NewVertexArray(meshFormat) };
+
+	//glClearColor(0.07f, 0.13f, 0.17f, 1.0f);
+	glClearColor(pow(0.07f, gamma), pow(0.13f, gamma), pow(0.17f, gamma), 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	glfwSwapBuffers(window);
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_MULTISAMPLE);
+	glEnable(GL_FRAMEBUFFER_SRGB);
+
+	glm::vec4 lightColor{ glm::vec4(1.0f, 1.0f, 1.0f, 1.0f) };
+
+	glm::vec3 lightPos{ glm::vec3(2.0f, 1.2f, 0.0f) };
+	glm::mat4 lightModel{ glm::mat4(1.0f) };
+	lightModel = glm::translate(lightModel, lightPos);
+
+	glm::vec3 floorPos{ glm::vec3(0.0f, 0.0f, 0.0f) };
+	glm::mat4 floorModel{ glm::mat4(1.0f) };
+	floorModel = glm::translate(floorModel, floorPos);
+	floorModel = glm::scale(floorModel, glm::vec3(5.0f, 1.0f, 5.0f));
+
+	glm::vec3 tablePos{ glm::vec3(2.0f, 0.0f, 0.0f) };
+	glm::mat4 tableModel{ glm::mat4(1.0f) };
+	tableModel = glm::translate(tableModel, tablePos);
+	tableModel = glm::scale(tableModel, glm::vec3(0.2f, 0.2f, 0.2f));
+
+	// The chairs at the table: one at the end, one on each side facing it. The stress test
+	// swaps them for a grid of chairStressCount around the room (see placeChairs).
+	const glm::vec3 tableChairPositions[3]{ glm::vec3(1.5f, 0.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.5f), glm::vec3(2.0f, 0.0f, -0.5f) };
+	const float tableChairAngles[3]{ 0.0f, 90.0f, -90.0f };
+	const size_t chairStressCount{ 10000 };
+	// Around a chair's origin, enough to hold it, for culling the multi-draw chairs.
+	const float chairRadius{ 1.0f };
+	bool chairStress{ false };
+	size_t chairCount{ chairStressCount };
+	// One by one, a draw and an ObjectData range each; instanced, a draw per LOD; multi-draw,
+	// the visible chairs as one indirect draw built on the workers.
+	enum ChairMode : int { ChairsOneByOne, ChairsInstanced, ChairsMultiDraw };
+	int chairMode{ ChairsInstanced };
+
+	glm::vec3 carpetPos{ glm::vec3(0.0f, 0.02f, 0.0f) };
+	glm::mat4 carpetModel{ glm::mat4(1.0f) };
+	carpetModel = glm::translate(carpetModel, carpetPos);
+	carpetModel = glm::scale(carpetModel, glm::vec3(0.2f, 0.16f, 0.2f));
+
+	// Textures come from a cache that shares images by path and contents. Images with a .dds
+	// copy from Tools/TextureBaker load that, block compressed with its mipmaps. The rest
+	// decode on the worker pool and stream in over the first frames; until then each texture
+	// is a 1x1 placeholder. Afterwards the cache keeps only the mip levels each object needs
+	// at its size on screen, within textureBudgetMb. Set asyncTextures to false to load them
+	// all up front, or compressedTextures to false to always use the .png files.
+	const bool compressedTextures{ true };
+	const bool asyncTextures{ true };
+	// Prints MipGenerator speed per filter and ISA, and how its levels compare with glGenerateMipmap's.
+	const bool mipReport{ false };
+	const GLubyte diffusePlaceholder[4]{ 128, 128, 128, 255 };
+	const GLubyte specularPlaceholder[4]{ 0, 0, 0, 255 };
+	float textureBudgetMb{ 64.0f };
+
+	if (mipReport)
+		Texture::PrintMipReport("Assets/carpet texture.png");
+
+	ThreadPool workers;
+	TextureCache textures(workers, (size_t)(textureBudgetMb * 1024.0f * 1024.0f));
+	textures.UseCompressed = compressedTextures;
+
+	auto loadTexture = [&](const char* image, GLuint slot)
+	{
+		return textures.Get(image, GL_TEXTURE_2D, slot, GL_LINEAR, GL_MIRRORED_REPEAT, slot == 0 ? diffusePlaceholder : specularPlaceholder);
+	};
+
+	TextureCache::Handle floorWoodTex{ loadTexture("Assets/wood tex3.png", 0) };
+	floorWoodTex.texUnit(floorShader, "tex0", 0);
+
+	TextureCache::Handle tableWoodTex{ loadTexture("Assets/wood tex.png", 0) };
+	tableWoodTex.texUnit(tableShader, "tex0", 0);
+
+	TextureCache::Handle chairWoodTex{ loadTexture("Assets/wood tex2.png", 0) };
+	chairWoodTex.texUnit(chairShader, "tex0", 0);
+	chairWoodTex.texUnit(chairInstancedShader, "tex0", 0);
+
+	TextureCache::Handle carpetTex{ loadTexture("Assets/carpet texture.png", 0) };
+	carpetTex.texUnit(carpetShader, "tex0", 0);
+
+	TextureCache::Handle floorWoodTexSpec{ loadTexture("Assets/wood tex3 specular.png", 1) };
+	floorWoodTexSpec.texUnit(floorShader, "tex1", 1);
+
+	TextureCache::Handle tableWoodTexSpec{ loadTexture("Assets/wood tex specular.png", 1) };
+	tableWoodTexSpec.texUnit(tableShader, "tex1", 1);
+
+	TextureCache::Handle chairWoodTexSpec{ loadTexture("Assets/wood tex2 specular.png", 1) };
+	chairWoodTexSpec.texUnit(chairShader, "tex1", 1);
+	chairWoodTexSpec.texUnit(chairInstancedShader, "tex1", 1);
+
+	TextureCache::Handle carpetTexSpec{ loadTexture("Assets/carpet texture specular.png", 1) };
+	carpetTexSpec.texUnit(carpetShader, "tex1", 1);
+
+	if (!asyncTextures)
+		textures.Finish();
+
+	// The same eight maps packed into one texture, so a single bind serves every object. Each
+	// object's layers say where its maps are: albedo at its material index, specular 4 on.
+	// Each map is resized to a 512x512 layer with its full mip chain. The layers load on the
+	// workers like the textures above and count against the same budget.
+	const std::vector<std::string> packedImages{
+		"Assets/wood tex3.png", "Assets/wood tex.png", "Assets/wood tex2.png", "Assets/carpet texture.png",
+		"Assets/wood tex3 specular.png", "Assets/wood tex specular.png", "Assets/wood tex2 specular.png", "Assets/carpet texture specular.png"
+	};
+	const int floorMaterial{ 0 };
+	const int tableMaterial{ 1 };
+	const int chairMaterial{ 2 };
+	const int carpetMaterial{ 3 };
+
+	TextureArray textureArray(packedImages, 0, GL_LINEAR, GL_MIRRORED_REPEAT, 512, diffusePlaceholder);
+	textures.Load(textureArray);
+	if (!asyncTextures)
+		textures.Finish();
+	textureArray.texUnit(floorPackedShader, "tex0", 0);
+	textureArray.texUnit(tablePackedShader, "tex0", 0);
+	textureArray.texUnit(carpetPackedShader, "tex0", 0);
+	textureArray.texUnit(chairPackedShader, "tex0", 0);
+	textureArray.texUnit(chairInstancedPackedShader, "tex0", 0);
+
+	std::cout << "- Packed " << packedImages.size() << " textures into " << textureArray.Layers << " " << textureArray.Width << "x" << textureArray.Height
+		<< " layers, " << textureArray.Levels << " levels, " << textureArray.Bytes() / 1024 << " KB\n";
+
+	bool packTextures{ true };
+	// Texture binds of the last frame drawn each way: separate textures, then packed.
+	size_t textureBinds[2]{};
+
+	Camera cam(wWidth, wHeight, glm::vec3(0.0f, 1.0f, 0.0f));
+	cam.speed = 0.02f;
+
+	double prevTime{ 0.0 };
+	double crntTime{ 0.0 };
+	double timeDiff;
+	unsigned int fpsCounter{ 0 };
+
+	IMGUI_CHECKVERSION();
+	ImGui::CreateContext();
+	ImGuiIO& imIO{ ImGui::GetIO() }; (void)imIO;
+
+	ImGui::StyleColorsDark();
+
+	ImGui_ImplGlfw_InitForOpenGL(window, true);
+	ImGui_ImplOpenGL3_Init("#version 330");
+
+	// FrameData and each object's ObjectData live in one buffer, bound by range per draw.
+	UBO frameUBO(4096);
+	GLintptr frameSlot{ frameUBO.Allocate(sizeof(FrameData)) };
+	// Instanced draws take everything they read from their InstanceData, so only the light and
+	// the chairs drawn one by one have ObjectData.
+	GLintptr lightSlot{ frameUBO.Allocate(sizeof(ObjectData)) };
+
+	// material is an index into packedImages.
+	auto materialLayers = [&](int material)
+	{
+		return glm::vec2((float)material, (float)(material + 4));
+	};
+
+	// normalSource is the model matrix without the position decode, which leaves normals alone.
+	// material is -1 for objects without maps.
+	auto writeObject = [&](UBO& buffer, GLintptr slot, const glm::mat4& model, const glm::mat4& normalSource, int material)
+	{
+		ObjectData object{};
+		object.Model = model;
+		object.NormalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(normalSource))));
+		if (material >= 0)
+			object.Layers = materialLayers(material);
+		buffer.Write(slot, &object, sizeof(object));
+	};
+
+	// Every chair has its matrices in chairInstances for the instanced draws and its own
+	// ObjectData range in chairUBO for drawing them one by one. A std140 range is at most 256
+	// bytes apart on every driver.
+	std::vector<glm::vec3> chairPositions;
+	std::vector<glm::mat4> chairModels;
+	std::vector<InstanceData> chairInstanceData;
+	std::vector<InstanceData> chairInstancesByLod;
+	std::vector<unsigned int> chairInstanceLods;
+	InstanceBuffer chairInstances;
+	UBO chairUBO((GLsizeiptr)chairStressCount * 256);
+	std::vector<GLintptr> chairSlots;
+	DrawCommandList chairCommands;
+	// Frame time and CPU submit time in ms, averaged apart for each ChairMode. Submitting is
+	// everything from the first draw going into the queue to the last one issued.
+	double chairFrameMs[3]{};
+	double chairSubmitMs[3]{};
+
+	auto placeChair = [&](const glm::vec3& position, float angle)
+	{
+		glm::mat4 model{ glm::translate(glm::mat4(1.0f), position) };
+		model = glm::scale(model, glm::vec3(0.16f, 0.16f, 0.16f));
+		model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
+
+		chairPositions.push_back(position);
+		chairModels.push_back(model);
+		chairInstanceData.push_back(InstanceBuffer::Make(model * chairDecode, model, materialLayers(chairMaterial)));
+		chairSlots.push_back(chairUBO.Allocate(sizeof(ObjectData)));
+	};
+
+	auto placeChairs = [&]()
+	{
+		chairPositions.clear();
+		chairModels.clear();
+		chairInstanceData.clear();
+		chairInstanceLods.clear();
+		chairSlots.clear();
+		chairUBO.Clear();
+		std::fill(std::begin(chairFrameMs), std::end(chairFrameMs), 0.0);
+		std::fill(std::begin(chairSubmitMs), std::end(chairSubmitMs), 0.0);
+
+		if (!chairStress)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				placeChair(tableChairPositions[i], tableChairAngles[i]);
+			}
+			return;
+		}
+
+		// A square grid half a unit apart, centered on the room, each chair turned its own way.
+		size_t side{ (size_t)std::ceil(std::sqrt((double)chairCount)) };
+		for (size_t i{ 0 }; i < chairCount; i++)
+		{
+			float x{ ((float)(i % side) - (float)side * 0.5f) * 0.5f };
+			float z{ ((float)(i / side) - (float)side * 0.5f) * 0.5f };
+			placeChair(glm::vec3(x, 0.0f, z), (float)((i * 37) % 360));
+		}
+	};
+	placeChairs();
+
+	// The submit benchmark draws the stress test at each of benchmarkCounts chairs, each
+	// ChairMode in turn, for benchmarkFrames frames after as many to settle, then prints the
+	// average submit time of each.
+	const size_t benchmarkCounts[4]{ 1000, 2500, 5000, chairStressCount };
+	const int benchmarkFrames{ 30 };
+	bool benchmarking{ false };
+	size_t benchmarkStep{ 0 };
+	int benchmarkFrame{ 0 };
+	double benchmarkMs[4][3]{};
+	bool benchmarkRestoreStress{ false };
+	int benchmarkRestoreMode{ ChairsInstanced };
+
+	auto benchmarkSetup = [&]()
+	{
+		chairMode = (int)(benchmarkStep % 3);
+		benchmarkFrame = 0;
+		if (benchmarkStep % 3 == 0)
+		{
+			chairCount = benchmarkCounts[benchmarkStep / 3];
+			placeChairs();
+		}
+	};
+
+	// The index ranges of one detail level, into drawRanges. The full level goes through
+	// meshlet culling, with the camera brought into model space, and comes out as merged ranges.
+	auto meshRanges = [&](const MeshCache::Entry& entry, const std::vector<MeshletBuilder::Meshlet>& meshlets, unsigned int lod, const glm::mat4& model)
+	{
+		const MeshCache::Lod& level{ entry.Lods[lod] };
+		drawRanges.clear();
+		if (lod != 0 || !useMeshlets || meshlets.empty())
+		{
+			drawRanges.push_back({ level.IndexOffset, level.IndexCount });
+			return;
+		}
+
+		glm::vec4 planes[6];
+		MeshletBuilder::ExtractFrustum(cam.cameraMatrix * model, planes);
+		glm::vec3 viewer{ glm::inverse(model) * glm::vec4(cam.Position, 1.0f) };
+
+		MeshletBuilder::Cull(meshlets, entry.IndexOffset, viewer, planes, drawRanges, cullStats);
+	};
+
+	// Draws one detail level, range by range. Returns the number of draw calls.
+	auto drawMesh = [&](GeometryPool::Handle mesh, const MeshCache::Entry& entry, const std::vector<MeshletBuilder::Meshlet>& meshlets, unsigned int lod, const glm::mat4& model)
+	{
+		meshRanges(entry, meshlets, lod, model);
+		for (const std::pair<uint32_t, uint32_t>& range : drawRanges)
+		{
+			geometry.Draw(mesh, range.first, range.second);
+		}
+		return drawRanges.size();
+	};
+
+	// The floor, table and carpet each have a DrawCommandList, but a list draws every object
+	// that shares its program and maps. Packed, that puts the carpet in the table's. Only the
+	// table's ranges come from culling each frame; the floor's list is built when its layers
+	// change.
+	struct StaticDraw
+	{
+		GeometryPool::Handle Mesh;
+		GLuint IndexOffset;
+		GLuint IndexCount;
+		InstanceData Instance;
+	};
+	std::vector<StaticDraw> staticDraws;
+	DrawCommandList floorCommands;
+	glm::vec2 floorLayers{ -1.0f };
+	DrawCommandList tableCommands;
+	DrawCommandList carpetCommands;
+	size_t staticDrawCalls{ 0 };
+
+	auto buildStatic = [&](DrawCommandList& commands)
+	{
+		commands.Build(workers, staticDraws.size(), [&](size_t first, size_t end, DrawCommandList::Chunk& chunk)
+		{
+			for (size_t i{ first }; i < end; i++)
+			{
+				const StaticDraw& draw{ staticDraws[i] };
+				chunk.Add(geometry.Get(draw.Mesh), draw.IndexOffset, draw.IndexCount, draw.Instance);
+			}
+		});
+		commands.Upload();
+		staticDraws.clear();
+	};
+
+	// Counting from the start, so the savings show without a GPU profiler.
+	GLStateCache& state{ GLStateCache::Get() };
+	state.Count = true;
+	RenderQueue queue;
+
+	auto msSinceStartup = [&]()
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupTime).count();
+	};
+	bool firstFrame{ true };
+	bool texturesResident{ false };
+
+	while (!glfwWindowShouldClose(window))
+	{
+		crntTime = glfwGetTime();
+		timeDiff = crntTime - prevTime;
+		fpsCounter++;
+		if (timeDiff >= 1.0 / 30.0)
+		{
+			std::string fps{ std::to_string(static_cast<int>((1.0 / timeDiff) * fpsCounter)) };
+			std::string newTitle{ "3D Testing - " + fps + "FPS" };
+
+			glfwSetWindowTitle(window, newTitle.c_str());
+			prevTime = crntTime;
+			fpsCounter = 0;
+		}
+
+		glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui_ImplGlfw_NewFrame();
+		ImGui::NewFrame();
+
+		ImGui::Begin("Debug Menu");
+		if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, GL_TRUE);
+
+		if (glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS) cam.firstClick = true;
+
+		if (!ImGui::IsWindowFocused())
+		{
+			if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS && !falling)
+			{
+				cam.speed = 0.04f;
+			}
+			else if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS && !falling)
+			{
+				cam.speed = 0.008f;
+				//cam.Position.y = 0.5f;
+			}
+			else
+			{
+				cam.speed = 0.02f;
+				//cam.Position.y = 1.0f;
+			}
+		}
+
+		if (!falling)
+		{
+			if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS && (!ImGui::IsWindowFocused()))
+			{
+				if (!freecam) cam.Position.y = 0.5f;
+			}
+			else
+			{
+				if (!freecam) cam.Position.y = 1.0f;
+			}
+		}
+		else
+		{
+			cam.Position.y -= 0.04f;
+		}
+
+		if ((cam.Position.x < -floorHalfExtent || cam.Position.x > floorHalfExtent ||
+			cam.Position.z < -floorHalfExtent || cam.Position.z > floorHalfExtent) && !falling && !freecam)
+		{
+			falling = true;
+		}
+
+		glClearColor(pow(0.07f, gamma), pow(0.13f, gamma), pow(0.17f, gamma), 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		if (!ImGui::IsWindowFocused())
+		{
+			(!freecam) ? cam.InputsGame(window, !falling, !(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS)) : cam.Inputs(window, !(glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS));
+		}
+		else
+		{
+			cam.firstClick = true;
+		}
+		cam.UpdateMatrix(45.0f, 0.1f, 100.0f);
+
+		// ImGui binds behind the state cache's back.
+		state.Invalidate();
+		state.ResetStats();
+
+		if (hotReload) shaders.HotReload(reloadBudgetMs / 1000.0);
+		textures.BudgetBytes = (size_t)(textureBudgetMb * 1024.0f * 1024.0f);
+		textures.Update();
+
+		cullStats = MeshletBuilder::CullStats();
+		Shader::Stats = Shader::UniformStats();
+
+		// Everything the shaders read this frame goes up in one buffer update.
+
+		FrameData frame{};
+		frame.CamMatrix = cam.cameraMatrix;
+		frame.LightColor = lightColor;
+		frame.LightPos = lightPos;
+		frame.CamPos = cam.Position;
+		frameUBO.Write(frameSlot, &frame, sizeof(frame));
+
+		writeObject(frameUBO, lightSlot, lightModel, lightModel, -1);
+
+		frameUBO.Upload();
+		frameUBO.BindRange("FrameData", frameSlot, sizeof(FrameData));
+
+		// Every draw goes into the queue, which sorts them by program, material and vertex
+		// array before any state is bound.
+
+		auto submitStart{ std::chrono::steady_clock::now() };
+
+		auto depthOf = [&](const glm::vec3& position)
+		{
+			return glm::distance(cam.Position, position) / 100.0f;
+		};
+
+		// Packed, every material samples the one texture array.
+		auto materialPacket = [&](Shader& separate, Shader& packed, TextureCache::Handle& albedo, TextureCache::Handle& specular)
+		{
+			RenderQueue::Packet packet;
+			if (packTextures)
+			{
+				packet.Program = packed.ID;
+				packet.TextureType = textureArray.type;
+				packet.Textures[0] = textureArray.ID;
+			}
+			else
+			{
+				packet.Program = separate.ID;
+				packet.Textures[0] = albedo.ID();
+				packet.Textures[1] = specular.ID();
+			}
+			return packet;
+		};
+
+		// Light cube
+
+		RenderQueue::Packet lightPacket;
+		lightPacket.Program = lightShader.ID;
+		lightPacket.VertexArray = fullVAO.ID;
+		lightPacket.Draw = [&]()
+		{
+			frameUBO.BindRange("ObjectData", lightSlot, sizeof(ObjectData));
+			geometry.Draw(lightGeometry);
+		};
+		queue.Submit(RenderQueue::Pass::Opaque, depthOf(lightPos), std::move(lightPacket));
+
+		// Floor
+
+		// One repeat of each texture: the floor's spans 1 unit, the others their model scale over
+		// the texture coordinates of the mesh.
+		float floorPixels{ TextureCache::ScreenPixels(1.0f, std::max(cam.Position.y, 0.1f), (float)wHeight, 45.0f) };
+		floorWoodTex.Use(floorPixels);
+		floorWoodTexSpec.Use(floorPixels);
+
+		staticDrawCalls = 0;
+		if (materialLayers(floorMaterial) != floorLayers)
+		{
+			floorLayers = materialLayers(floorMaterial);
+			staticDraws.push_back({ floorGeometry, 0, geometry.Get(floorGeometry).IndexCount, InstanceBuffer::Make(floorModel, floorModel, floorLayers) });
+			buildStatic(floorCommands);
+		}
+
+		RenderQueue::Packet floorPacket{ materialPacket(floorShader, floorPackedShader, floorWoodTex, floorWoodTexSpec) };
+		floorPacket.VertexArray = floorVAO.ID;
+		floorPacket.Draw = [&]()
+		{
+			staticDrawCalls += floorCommands.Draw(floorVAO);
+		};
+		queue.Submit(RenderQueue::Pass::Opaque, 0.0f, std::move(floorPacket));
+
+		// Table
+
+		float tablePixels{ TextureCache::ScreenPixels(0.08f, glm::distance(cam.Position, tablePos), (float)wHeight, 45.0f) };
+		tableWoodTex.Use(tablePixels);
+		tableWoodTexSpec.Use(tablePixels);
+
+		tableLod = useLods ? MeshCache::SelectLod(tableEntry, 0.2f, glm::distance(cam.Position, tablePos), (float)wHeight, 45.0f, lodPixelError) : 0;
+
+		// A draw for each range left after meshlet culling, all with the table's instance.
+		InstanceData tableInstance{ InstanceBuffer::Make(tableModel * tableDecode, tableModel, materialLayers(tableMaterial)) };
+		meshRanges(tableEntry, tableMeshlets, tableLod, tableModel);
+		for (const std::pair<uint32_t, uint32_t>& range : drawRanges)
+		{
+			staticDraws.push_back({ tableGeometry, range.first, range.second, tableInstance });
+		}
+
+		// Carpet
+
+		float carpetPixels{ TextureCache::ScreenPixels(0.2f / 0.6f, glm::distance(cam.Position, carpetPos), (float)wHeight, 45.0f) };
+		carpetTex.Use(carpetPixels);
+		carpetTexSpec.Use(carpetPixels);
+
+		StaticDraw carpetDraw{ carpetGeometry, 0, (GLuint)carpetIndexCount, InstanceBuffer::Make(carpetModel * carpetDecode, carpetModel, materialLayers(carpetMaterial)) };
+		if (packTextures)
+			staticDraws.push_back(carpetDraw);
+		buildStatic(tableCommands);
+
+		RenderQueue::Packet tablePacket{ materialPacket(tableShader, tablePackedShader, tableWoodTex, tableWoodTexSpec) };
+		tablePacket.VertexArray = tableVAO.ID;
+		tablePacket.Draw = [&]()
+		{
+			staticDrawCalls += tableCommands.Draw(tableVAO);
+		};
+		queue.Submit(RenderQueue::Pass::Opaque, depthOf(tablePos), std::move(tablePacket));
+
+		if (!packTextures)
+		{
+			staticDraws.push_back(carpetDraw);
+			buildStatic(carpetCommands);
+
+			RenderQueue::Packet carpetPacket{ materialPacket(carpetShader, carpetPackedShader, carpetTex, carpetTexSpec) };
+			carpetPacket.VertexArray = carpetVAO.ID;
+			carpetPacket.Draw = [&]()
+			{
+				staticDrawCalls += carpetCommands.Draw(carpetVAO);
+			};
+			queue.Submit(RenderQueue::Pass::Opaque, depthOf(carpetPos), std::move(carpetPacket));
+		}
+
+		// Chairs
+
+		size_t chairsPerLod[MeshCache::MaxLods]{};
+		float nearestChair{ 1.0e9f };
+		chairLods.resize(chairPositions.size());
+		for (size_t i{ 0 }; i < chairPositions.size(); i++)
+		{
+			float distance{ glm::distance(cam.Position, chairPositions[i]) };
+			nearestChair = std::min(nearestChair, distance);
+			chairLods[i] = useLods ? MeshCache::SelectLod(chairEntry, 0.16f, distance, (float)wHeight, 45.0f, lodPixelError) : 0;
+			chairsPerLod[chairLods[i]]++;
+		}
+
+		float chairPixels{ TextureCache::ScreenPixels(0.064f, nearestChair, (float)wHeight, 45.0f) };
+		chairWoodTex.Use(chairPixels);
+		chairWoodTexSpec.Use(chairPixels);
+
+		const int chairsDrawn{ chairMode };
+		size_t chairDraws{ 0 };
+		// Drawn one by one, every chair's packet shares this, so none of them allocates a
+		// callable of its own. Out here as the queue calls it after the branches below.
+		std::function<void(uint32_t)> drawChair{ [&](uint32_t i)
+		{
+			chairUBO.BindRange("ObjectData", chairSlots[i], sizeof(ObjectData));
+			chairDraws += drawMesh(chairGeometry, chairEntry, chairMeshlets, chairLods[i], chairModels[i]);
+		} };
+		if (chairsDrawn == ChairsInstanced)
+		{
+			// Chairs grouped by LOD, one instanced draw per group. The matrices were built once
+			// when the chairs were placed and only go up again when a chair changes LOD.
+			if (chairInstanceLods != chairLods)
+			{
+				chairInstanceLods = chairLods;
+				chairInstancesByLod.clear();
+				for (unsigned int lod{ 0 }; lod < MeshCache::MaxLods; lod++)
+				{
+					for (size_t i{ 0 }; i < chairLods.size(); i++)
+					{
+						if (chairLods[i] == lod) chairInstancesByLod.push_back(chairInstanceData[i]);
+					}
+				}
+				chairInstances.Upload(chairInstancesByLod.data(), chairInstancesByLod.size());
+			}
+
+			RenderQueue::Packet chairPacket{ materialPacket(chairInstancedShader, chairInstancedPackedShader, chairWoodTex, chairWoodTexSpec) };
+			chairPacket.VertexArray = chairInstancedVAO.ID;
+			chairPacket.Draw = [&]()
+			{
+				size_t firstInstance{ 0 };
+				for (unsigned int lod{ 0 }; lod < MeshCache::MaxLods; lod++)
+				{
+					if (chairsPerLod[lod] == 0) continue;
+
+					const MeshCache::Lod& level{ chairEntry.Lods[lod] };
+					chairInstances.Link(chairInstancedVAO, firstInstance);
+					geometry.Draw(chairGeometry, level.IndexOffset, level.IndexCount, (GLsizei)chairsPerLod[lod]);
+
+					firstInstance += chairsPerLod[lod];
+					chairDraws++;
+				}
+			};
+			queue.Submit(RenderQueue::Pass::Opaque, nearestChair / 100.0f, std::move(chairPacket));
+		}
+		else if (chairsDrawn == ChairsMultiDraw)
+		{
+			// A command per chair in view, at its LOD, with its matrices as the instance the
+			// command points at. The full level is drawn whole, without meshlet culling.
+			glm::vec4 planes[6];
+			MeshletBuilder::ExtractFrustum(cam.cameraMatrix, planes);
+			const GeometryPool::Mesh& chairPoolMesh{ geometry.Get(chairGeometry) };
+
+			chairCommands.Build(workers, chairPositions.size(), [&](size_t first, size_t end, DrawCommandList::Chunk& chunk)
+			{
+				for (size_t i{ first }; i < end; i++)
+				{
+					bool visible{ true };
+					for (const glm::vec4& plane : planes)
+					{
+						if (glm::dot(glm::vec3(plane), chairPositions[i]) + plane.w < -chairRadius) visible = false;
+					}
+					if (!visible) continue;
+
+					const MeshCache::Lod& level{ chairEntry.Lods[chairLods[i]] };
+					chunk.Add(chairPoolMesh, level.IndexOffset, level.IndexCount, chairInstanceData[i]);
+				}
+			});
+			chairCommands.Upload();
+
+			RenderQueue::Packet chairPacket{ materialPacket(chairInstancedShader, chairInstancedPackedShader, chairWoodTex, chairWoodTexSpec) };
+			chairPacket.VertexArray = chairMultiDrawVAO.ID;
+			chairPacket.Draw = [&]()
+			{
+				chairDraws += chairCommands.Draw(chairMultiDrawVAO);
+			};
+			queue.Submit(RenderQueue::Pass::Opaque, nearestChair / 100.0f, std::move(chairPacket));
+		}
+		else
+		{
+			// One by one, every chair's normal matrix is worked out again and its ObjectData
+			// goes up in a range of its own.
+			for (size_t i{ 0 }; i < chairModels.size(); i++)
+			{
+				writeObject(chairUBO, chairSlots[i], chairModels[i] * chairDecode, chairModels[i], chairMaterial);
+			}
+			chairUBO.Upload();
+
+			RenderQueue::Packet chairPacket{ materialPacket(chairShader, chairPackedShader, chairWoodTex, chairWoodTexSpec) };
+			chairPacket.VertexArray = meshVAO.ID;
+			chairPacket.DrawObject = &drawChair;
+			for (size_t i{ 0 }; i < chairModels.size(); i++)
+			{
+				chairPacket.Object = (uint32_t)i;
+				queue.Submit(RenderQueue::Pass::Opaque, depthOf(chairPositions[i]), chairPacket);
+			}
+		}
+
+		// Crosshair, over everything else
+
+		RenderQueue::Packet crosshairPacket;
+		crosshairPacket.Program = crosshairShader.ID;
+		crosshairPacket.VertexArray = fullVAO.ID;
+		crosshairPacket.Draw = [&]()
+		{
+			geometry.Draw(crosshairGeometry);
+		};
+		queue.Submit(RenderQueue::Pass::Overlay, 0.0f, std::move(crosshairPacket));
+
+		queue.Execute(state);
+
+		double submitMs{ std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitStart).count() };
+
+		textureBinds[packTextures] = state.Counts.Textures.Issued;
+
+		ImGui::SetWindowSize(ImVec2{ 300, 960 });
+
+		ImGui::Text("            -General-");
+
+		if (ImGui::Button("Reset"))
+		{
+			falling = false;
+
+			cam.Position = glm::vec3(0.0f, 1.0f, 0.0f);
+			cam.Orientation = glm::vec3(0.0f, 0.0f, -1.0f);
+			cam.Up = glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+
+		ImGui::Checkbox("Free Camera", &freecam);
+
+		ImGui::Text("             -Draw-");
+
+		if (ImGui::Button("Toggle Wireframe Mode"))
+		{
+			polygonMode = (polygonMode == GL_LINE) ? GL_FILL : GL_LINE;
+		}
+
+		ImGui::Checkbox("Mesh LODs", &useLods);
+		ImGui::SliderFloat("Max Error (px)", &lodPixelError, 0.25f, 16.0f);
+		ImGui::Text("Table LOD %u, chairs per LOD %zu/%zu/%zu/%zu", tableLod, chairsPerLod[0], chairsPerLod[1], chairsPerLod[2], chairsPerLod[3]);
+
+		ImGui::Checkbox("Meshlet Culling", &useMeshlets);
+		ImGui::Text("Meshlets: %zu, %zu draws", cullStats.Meshlets, cullStats.Draws);
+		ImGui::Text("Culled %.1f%% (cone %zu, frustum %zu tris)", cullStats.RejectedPercent(), cullStats.ConeRejected, cullStats.FrustumRejected);
+		ImGui::Text("Uniforms: %zu set, %zu uploaded", Shader::Stats.Requested, Shader::Stats.Issued);
+		ImGui::Text("Uniform buffer: %d bytes in 1 update", (int)frameUBO.UsedBytes());
+		ImGui::Text("Shader programs: %zu", shaders.Count());
+		ImGui::Checkbox("Shader Hot Reload", &hotReload);
+		ImGui::SliderFloat("Reload Budget (ms)", &reloadBudgetMs, 0.5f, 16.0f);
+		ImGui::Text("Reloads: %zu, failed %zu", shaders.Reloads, shaders.ReloadFailures);
+		ImGui::Text("Textures: %zu (%zu loading), %zu compressed", textures.Count(), textures.Pending(), textures.Compressed());
+		ImGui::Text("Texture hits: %zu/%zu (%.0f%%), %zu shared", textures.Hits, textures.Lookups, textures.HitRate(), textures.SharedHits);
+		ImGui::SliderFloat("Texture Budget (MB)", &textureBudgetMb, 1.0f, 128.0f);
+		ImGui::Text("Texture memory: %.2f/%.0f MB", textures.ResidentBytes() / (1024.0f * 1024.0f), textureBudgetMb);
+		ImGui::Text("Mips in %zu, out %zu, evicted %zu", textures.LevelsStreamedIn, textures.LevelsStreamedOut, textures.Evictions);
+		ImGui::Checkbox("Packed Textures", &packTextures);
+		ImGui::Text("Texture binds: %zu separate, %zu packed", textureBinds[0], textureBinds[1]);
+		ImGui::Text("Draw packets: %zu, sorted in %.3f ms", queue.Packets, queue.SortMs);
+		ImGui::Text("Floor, table and carpet: %zu draws", staticDrawCalls);
+		GeometryPool::Stats vertexPool{ geometry.VertexStats() };
+		GeometryPool::Stats indexPool{ geometry.IndexStats() };
+		ImGui::Text("Geometry: %zu meshes, %zu/%zu KB", geometry.Count(), (vertexPool.Used + indexPool.Used) / 1024, (vertexPool.Capacity + indexPool.Capacity) / 1024);
+		ImGui::Text("Vertices %.0f%% used, %.0f%% fragmented", vertexPool.Utilization(), vertexPool.Fragmentation());
+		ImGui::Text("Indices %.0f%% used, %.0f%% fragmented", indexPool.Utilization(), indexPool.Fragmentation());
+		if (ImGui::Button("Defragment Geometry")) geometry.Defragment();
+		ImGui::Checkbox("Filter GL State", &state.Enabled);
+		ImGui::Checkbox("Count GL Calls", &state.Count);
+		ImGui::Checkbox("Validate GL State", &state.Validate);
+		ImGui::Text("GL calls: %zu issued, %zu elided, %zu stale", state.Counts.Issued(), state.Counts.Elided(), state.Counts.Stale);
+		ImGui::Text("Programs %zu/%zu, VAOs %zu/%zu", state.Counts.Programs.Issued, state.Counts.Programs.Elided, state.Counts.VertexArrays.Issued, state.Counts.VertexArrays.Elided);
+		ImGui::Text("Buffers %zu/%zu, textures %zu/%zu", state.Counts.Buffers.Issued, state.Counts.Buffers.Elided, state.Counts.Textures.Issued, state.Counts.Textures.Elided);
+		ImGui::RadioButton("One by One", &chairMode, ChairsOneByOne);
+		ImGui::SameLine();
+		ImGui::RadioButton("Instanced", &chairMode, ChairsInstanced);
+		ImGui::SameLine();
+		ImGui::RadioButton("Multi-Draw", &chairMode, ChairsMultiDraw);
+		ImGui::Checkbox("Indirect Multi-Draw", &chairCommands.MultiDraw);
+		ImGui::SameLine();
+		ImGui::Text("%s", DrawCommandList::Supported() ? "(supported)" : "(not supported)");
+		if (ImGui::Checkbox("Chair Stress Test (10k)", &chairStress)) placeChairs();
+		ImGui::Text("Chairs: %zu in %zu draws", chairModels.size(), chairDraws);
+		ImGui::Text("Commands: %zu from %zu chunks in %.3f ms", chairCommands.Count(), chairCommands.Chunks, chairCommands.BuildMs);
+		ImGui::Text("Frame: %.2f/%.2f/%.2f ms", chairFrameMs[ChairsOneByOne], chairFrameMs[ChairsInstanced], chairFrameMs[ChairsMultiDraw]);
+		ImGui::Text("Submit: %.2f/%.2f/%.2f ms", chairSubmitMs[ChairsOneByOne], chairSubmitMs[ChairsInstanced], chairSubmitMs[ChairsMultiDraw]);
+		if (!benchmarking && ImGui::Button("Benchmark Submit"))
+		{
+			benchmarking = true;
+			benchmarkRestoreStress = chairStress;
+			benchmarkRestoreMode = chairMode;
+			chairStress = true;
+			benchmarkStep = 0;
+			benchmarkSetup();
+		}
+		if (benchmarking) ImGui::Text("Benchmarking: %zu chairs", chairModels.size());
+
+		ImGui::End();
+
+		ImGui::Render();
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+
+		// The whole frame, swap included, counted for the way the chairs were drawn.
+		double frameMs{ (glfwGetTime() - crntTime) * 1000.0 };
+		double& chairAverageMs{ chairFrameMs[chairsDrawn] };
+		chairAverageMs = chairAverageMs == 0.0 ? frameMs : chairAverageMs * 0.95 + frameMs * 0.05;
+		double& submitAverageMs{ chairSubmitMs[chairsDrawn] };
+		submitAverageMs = submitAverageMs == 0.0 ? submitMs : submitAverageMs * 0.95 + submitMs * 0.05;
+
+		if (benchmarking && ++benchmarkFrame > benchmarkFrames)
+		{
+			benchmarkMs[benchmarkStep / 3][benchmarkStep % 3] += submitMs / benchmarkFrames;
+			if (benchmarkFrame == benchmarkFrames * 2 && ++benchmarkStep < 12)
+			{
+				benchmarkSetup();
+			}
+			else if (benchmarkStep == 12)
+			{
+				std::cout << "- Submit benchmark, CPU ms per frame (one by one, instanced, multi-draw" << (DrawCommandList::Supported() ? "" : " as a loop") << "):\n";
+				for (size_t i{ 0 }; i < 4; i++)
+				{
+					std::cout << "  " << benchmarkCounts[i] << " chairs: " << benchmarkMs[i][0] << ", " << benchmarkMs[i][1] << ", " << benchmarkMs[i][2] << "\n";
+					benchmarkMs[i][0] = benchmarkMs[i][1] = benchmarkMs[i][2] = 0.0;
+				}
+
+				benchmarking = false;
+				chairStress = benchmarkRestoreStress;
+				chairMode = benchmarkRestoreMode;
+				chairCount = chairStressCount;
+				placeChairs();
+			}
+		}
+
+		if (firstFrame)
+		{
+			std::cout << "- First frame after " << msSinceStartup() << " ms (" << (asyncTextures ? "async" : "serial") << " textures)\n";
+			firstFrame = false;
+		}
+		if (!texturesResident && textures.Pending() == 0)
+		{
+			std::cout << "- Textures resident after " << msSinceStartup() << " ms, " << textures.ResidentBytes() / 1024 << " KB of texture memory ("
+				<< textures.Compressed() << "/" << textures.Count() << " block compressed)\n";
+			texturesResident = true;
+		}
+	}
+
+	ImGui_ImplOpenGL3_Shutdown();
+	ImGui_ImplGlfw_Shutdown();
+	ImGui::DestroyContext();
+
+	geometry.Delete();
+	chairInstances.Delete();
+	chairCommands.Delete();
+	floorCommands.Delete();
+	tableCommands.Delete();
+	carpetCommands.Delete();
+	chairUBO.Delete();
+
+	shaders.Delete();
+	frameUBO.Delete();
+	textures.Delete();
+	textureArray.Delete();
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	return 0;
 }
\ No newline at end of file